@@ -0,0 +1,53 @@
+#pragma once
+#include <Animation/AnimationInfo.h>
+#include <Animation/BoneMask.h>
+
+/**
+ * @brief Difference between every key of a clip and a reference key, computed when the first additive layer of the clip is added and stored in the same streams as the clip.
+ * The translation delta is the key minus the reference, the rotation delta the inverse of the reference times the key, so that the reference times the delta gives back the key.
+ * Adding the deltas to any pose plays the motion of the clip on top of it.
+ */
+class AdditiveClip final
+{
+public:
+	/**
+	 * @brief Constructor, computing the deltas.
+	 * @param p_clip The clip
+	 * @param p_referenceKey The key the deltas are taken from, the pose of the clip that adds nothing
+	 * @throw std::out_of_range if the reference key isn't in the clip
+	 */
+	explicit AdditiveClip(const AnimationInfo& p_clip, const size_t p_referenceKey = 0);
+
+	/**
+	 * @brief Default destructor
+	 */
+	~AdditiveClip() = default;
+
+	/**
+	 * @brief Sample the deltas of the bones of a mask and add them to a pose, scaled by a weight.
+	 * The translations are offset by the weighted delta, the rotations are multiplied by the delta interpolated from identity.
+	 * @param p_time The time in keys, it wraps around the key count
+	 * @param p_mask The bones the deltas are added to
+	 * @param p_weight The weight of the deltas, 1 adds the whole motion
+	 * @param p_pose The pose the deltas are added to
+	 * @param p_scratch A buffer of the size of the pose, receiving the deltas of the bones of the mask
+	 * @param p_boneCount The size of the buffers
+	 */
+	void Apply(const float p_time, const BoneMask& p_mask, const float p_weight, LocalPose* p_pose, LocalPose* p_scratch, const size_t p_boneCount) const;
+
+	/**
+	 * @brief Return the deltas, in the layout of the clip.
+	 * @return The deltas
+	 */
+	const AnimationInfo& Deltas() const;
+
+	/**
+	 * @brief Return the key the deltas are taken from.
+	 * @return The reference key
+	 */
+	size_t ReferenceKey() const;
+
+private:
+	AnimationInfo m_deltas;
+	size_t m_referenceKey;
+};
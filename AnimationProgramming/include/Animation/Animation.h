@@ -3,13 +3,87 @@
 #include <Engine/Simulation.h>
 #include <string>
 #include <vector>
-#include <Resources/Bone.h>
-#include <unordered_map>
-#include <Animation/AnimationInfo.h>
+#include <Resources/Skeleton.h>
+#include <Animation/ClipRegistry.h>
+#include <Animation/CompressedClip.h>
+#include <Animation/ReducedClip.h>
+#include <Animation/SkinningPalette.h>
+#include <Animation/Crowd.h>
+#include <Animation/ClipCycle.h>
+#include <Animation/BlendSpace1D.h>
+#include <Animation/AdditiveClip.h>
+#include <Animation/LayerStack.h>
+#include <Animation/AnimationLod.h>
+#include <Animation/RootMotion.h>
+#include <Animation/TwoBoneIk.h>
+#include <Resources/ClipCache.h>
 #include <optional>
+#include <memory>
 
 #define WALK_ANIM "ThirdPersonWalk.anim"
 #define RUN_ANIM "ThirdPersonRun.anim"
+#define RESOURCES_DIRECTORY "Resources/"
+#define CLIP_CACHE_PATH RESOURCES_DIRECTORY "Clips.cache"
+
+/**
+ * @brief Copy of the clips the pose is sampled from.
+ */
+enum class ClipStorage
+{
+	/**
+	 * @brief The float keys read from the resources.
+	 */
+	Keys,
+
+	/**
+	 * @brief The quantized CompressedClip, constant tracks stored once.
+	 */
+	Compressed,
+
+	/**
+	 * @brief The ReducedClip, each track keeping only the keys needed to stay within the error budget.
+	 */
+	Reduced
+};
+
+/**
+ * @brief Where Init read the keys of the clips from.
+ */
+enum class ClipSource
+{
+	/**
+	 * @brief Init hasn't run yet.
+	 */
+	None,
+
+	/**
+	 * @brief The keys were mapped from CLIP_CACHE_PATH.
+	 */
+	Cache,
+
+	/**
+	 * @brief The keys were read from the .anim files by ResourceLoader.
+	 */
+	Resources,
+
+	/**
+	 * @brief The keys were read through the engine accessors.
+	 */
+	Engine
+};
+
+/**
+ * @brief How the clips were imported by the last Init.
+ */
+struct ClipImportReport final
+{
+	ClipSource source{ ClipSource::None };
+
+	/**
+	 * @brief Time taken by the import in milliseconds, from the skeleton to the clips ready to be sampled.
+	 */
+	float duration{ 0.0f };
+};
 
 class CSimulation final : public ISimulation
 {
@@ -22,6 +96,7 @@ public:
 
 	/**
 	 * @brief Initialize every members, populate array of bones, linkage between them etc.
+	 * The keys of the clips are mapped from CLIP_CACHE_PATH when it matches the source files, otherwise they are imported from the resources and the cache is written.
 	 */
 	virtual void Init() override;
 
@@ -32,20 +107,69 @@ public:
 	virtual void Update(const float p_deltaTime) override;
 
 	/**
-	 * @brief Creates all bones of the animation.
+	 * @brief Evaluate the main character and the crowd as jobs and wait for them.
+	 * @param p_deltaTime Time between 2 frames
+	 */
+	void UpdateJobs(const float p_deltaTime);
+
+	/**
+	 * @brief Creates the skeleton of the animation. Bones are validated so that parents always come before their children.
+	 * The skeleton and the key counts are read from the .skel and .anim files of RESOURCES_DIRECTORY, or from the engine when the .skel can't be opened.
 	 */
 	void PopulateBonesArray();
 
 	/**
-	 * @brief Store all needed data of the animation.
-	 * @param p_animationName The animation name
+	 * @brief Creates the skeleton of the animation one bone at a time through the engine accessors.
+	 */
+	void PopulateBonesArrayFromEngine();
+
+	/**
+	 * @brief Store all needed data of the animation, from the same source as the skeleton.
+	 * @param p_clipId The handle of the animation in the clip registry
+	 */
+	void PopulateAnimation(const ClipId p_clipId);
+
+	/**
+	 * @brief Build the compressed copy of every clip, done only when the compressed or the reduced clips are used.
+	 */
+	void BuildCompressedClips();
+
+	/**
+	 * @brief Build the reduced copy of every clip. This is the slow part of the import, done only when the reduced clips are used.
+	 */
+	void BuildReducedClips();
+
+	/**
+	 * @brief Compute the cycle of every clip, with the sync markers and stride of the walk and the run.
+	 * Done once the keys are imported, the cycles are then saved in the cache with them.
+	 */
+	void BuildClipCycles();
+
+	/**
+	 * @brief Place the walk and the run in the locomotion blend space, from their cycles imported or read from the cache.
+	 */
+	void AddLocomotionClips();
+
+	/**
+	 * @brief Return the cycle of a clip, computed at import.
+	 * @param p_clipId The handle of the animation in the clip registry
+	 * @return The cycle
+	 */
+	const ClipCycle& GetClipCycle(const ClipId p_clipId) const;
+
+	/**
+	 * @brief Return the motion of the root bone of a clip, taken out of its keys at import.
+	 * @param p_clipId The handle of the animation in the clip registry
+	 * @return The root motion
 	 */
-	void PopulateAnimation(const std::string_view& p_animationName);
+	const RootMotion& GetRootMotion(const ClipId p_clipId) const;
 
 	/**
-	 * @brief Link all bones with their relatives bones, parent and children.
+	 * @brief Return how far the root motion of the played clips moved the main character since Init. The pose itself stays in place.
+	 * @return The displacement, in the space of the parent of the root
+	 * @note Locomotion driven by a speed doesn't add root motion, the speed already says how fast the character moves.
 	 */
-	void LinkBones();
+	Vector3F RootPosition() const;
 
 	/**
 	 * @brief Static method to draw the axis of the world space from origin.
@@ -53,19 +177,30 @@ public:
 	static void DrawAxis();
 
 	/**
-	 * @brief Return a bone from his name.
+	 * @brief Return the index of a bone from his name.
 	 * @param p_boneName Name of the bone
-	 * @return An optional pointer to the bone, it may hold a pointer of the bone or it may be empty.
-	 * @note I used std::optional as return type just for fun using C++17 features. In real cases like this one we should just use a simple pointer or smart pointer like std::shared_ptr.
-	 * Return type as std::optional are really useful in situations like finding a string, get integers values that may have not be set yet in the program and so on.
+	 * @return An optional index of the bone in the skeleton, it may hold the index of the bone or it may be empty.
+	 * @note Return type as std::optional are really useful in situations like finding a string, get integers values that may have not be set yet in the program and so on.
 	 */
-	std::optional<Bone*> GetBoneFromName(const std::string_view& p_boneName);
+	std::optional<size_t> GetBoneFromName(const std::string_view& p_boneName) const;
 
 	/**
-	 * @brief Draw the mesh skeleton
+	 * @brief Sample the current animation and compute the animated world transform of every bone, as matrices or dual quaternions depending on the palette mode.
+	 */
+	void EvaluatePose();
+
+	/**
+	 * @brief Draw the mesh skeleton from the last evaluated pose.
 	 */
 	void DrawSkeleton();
 
+	/**
+	 * @brief Return the world position of a bone from the last evaluated pose.
+	 * @param p_boneIndex The bone
+	 * @return The world position
+	 */
+	Vector3F BoneWorldPosition(const size_t p_boneIndex) const;
+
 	/**
 	 * @brief Update the animation settings like speed.
 	 * @param p_deltaTime The time between 2 frames
@@ -73,9 +208,224 @@ public:
 	void ChangeAnimation(const float p_deltaTime);
 
 	/**
-	 * @brief Prepare the data to be send for the vertex shader.
+	 * @brief Play another animation from the start, cutting any crossfade.
+	 * @param p_clipId The handle of the animation in the clip registry
+	 */
+	void PlayAnimation(const ClipId p_clipId);
+
+	/**
+	 * @brief Fade from the current animation to another one. Both are sampled and blended in local space during the fade.
+	 * The two animations stay at the same normalized time in their cycle, so that the feet of the walk and the run stay in sync.
+	 * Fading back to the animation being faded out continues from the current weight. Nothing happens if the animation is already the current one.
+	 * @param p_clipId The handle of the animation in the clip registry
+	 * @param p_duration The duration of the fade in seconds, 0 or less switches at once while keeping the normalized time
+	 */
+	void CrossfadeTo(const ClipId p_clipId, const float p_duration);
+
+	/**
+	 * @brief Return true while a crossfade is in progress.
+	 * @return True if two animations are blended
+	 */
+	bool IsCrossfading() const;
+
+	/**
+	 * @brief Return the weight of the animation faded in, eased with a smoothstep.
+	 * @return The weight between 0 and 1, 1 when no crossfade is in progress
+	 */
+	float CrossfadeWeight() const;
+
+	/**
+	 * @brief Set the duration of the crossfades started by the R and Z keys. Default value is 0.3 second.
+	 * @param p_duration The duration in seconds
+	 */
+	void SetCrossfadeDuration(const float p_duration = 0.3f);
+
+	/**
+	 * @brief Return the duration of the crossfades started by the R and Z keys.
+	 * @return The duration in seconds
+	 */
+	float CrossfadeDuration() const;
+
+	/**
+	 * @brief Advance the time of the current animation. During a crossfade both animations advance by the same fraction of their cycle,
+	 * the cycle length going from the one of the animation faded out to the one of the animation faded in.
+	 * @param p_deltaTime The time between 2 frames
+	 */
+	void AdvanceAnimation(const float p_deltaTime);
+
+	/**
+	 * @brief Sample both animations of the crossfade and blend them into the local pose, in a single pass over the float keys whatever the clip storage.
+	 * The compressed and reduced clips would first scatter their animated tracks to bone order, which costs more than the pass itself.
+	 */
+	void SampleCrossfade();
+
+	/**
+	 * @brief Drive the walk and the run by the speed of the character instead of playing one clip. The speed eases towards the target in about 0.2 second,
+	 * and the locomotion blend space plays and blends the clips whose strides match it, so the feet don't slide at intermediate speeds.
+	 * The animation factor speed multiplies the speed. Locomotion starts from the current pose and, when stopped, the clip with the largest weight goes on from the same pose.
+	 * @param p_speed The target speed in units per second, empty to go back to playing one clip
+	 * @throw std::logic_error if the walk and the run have no stride
+	 */
+	void SetLocomotionSpeed(const std::optional<float> p_speed);
+
+	/**
+	 * @brief Return the target speed of the locomotion.
+	 * @return The speed in units per second, empty when one clip is played
 	 */
-	void FormatHardwareSkinning();
+	std::optional<float> LocomotionSpeed() const;
+
+	/**
+	 * @brief Return the locomotion blend space of the walk and the run.
+	 * @return The blend space
+	 */
+	const BlendSpace1D& GetLocomotion() const;
+
+	/**
+	 * @brief Add a layer on top of the pose of the main character, restricted to a bone and its descendants (spine_01 for the upper body).
+	 * Only the bones of the layer are sampled and combined, the additive layers read the deltas computed at import. The layers play from the first key of their clip, at the animation speed.
+	 * The layer is added in Init if the simulation isn't initialized yet.
+	 * @param p_clipName The name of the clip the layer plays, registered with the simulation
+	 * @param p_mode How the layer is combined with the pose below it
+	 * @param p_rootBoneName The first bone of the subtree the layer affects
+	 * @param p_weight The weight of the layer, between 0 and 1
+	 * @return The handle of the layer
+	 * @throw std::invalid_argument if the clip isn't registered or the bone isn't in the skeleton
+	 */
+	LayerId AddLayer(const std::string_view& p_clipName, const LayerBlendMode p_mode, const std::string_view& p_rootBoneName, const float p_weight = 1.0f);
+
+	/**
+	 * @brief Set the weight of a layer, 0 skips it.
+	 * @param p_layer The handle of the layer
+	 * @param p_weight The new weight, between 0 and 1
+	 */
+	void SetLayerWeight(const LayerId p_layer, const float p_weight);
+
+	/**
+	 * @brief Remove every layer.
+	 */
+	void ClearLayers();
+
+	/**
+	 * @brief Return the layers on top of the pose of the main character.
+	 * @return The layer stack, empty until Init
+	 */
+	const LayerStack& GetLayers() const;
+
+	/**
+	 * @brief Add a limb solved with two-bone IK on the main character and every crowd instance, once their pose is sampled and layered.
+	 * The limbs of all the characters are solved in batches (see TwoBoneIk). A limb starts with a weight of 0, which leaves the pose untouched.
+	 * The limb is added in Init if the simulation isn't initialized yet.
+	 * @param p_endBoneName The last bone of the limb, foot_l or hand_l for example, the limb being it, its parent and the parent of its parent
+	 * @param p_poleOffset Where the middle bone bends towards, relative to its current position: zero keeps the bending plane of the animation
+	 * @return The handle of the limb
+	 * @throw std::invalid_argument if the bone isn't in the skeleton or has less than 2 ancestors
+	 */
+	IkLimbId AddIkLimb(const std::string_view& p_endBoneName, const Vector3F& p_poleOffset = Vector3F{ 0.0f, 0.0f, 0.0f });
+
+	/**
+	 * @brief Set where a limb of the main character reaches. The crowd instances start from this target when the crowd is spawned.
+	 * @param p_limb The handle of the limb
+	 * @param p_target The position the end bone reaches, in the space of the evaluated pose (see BoneWorldPosition)
+	 * @param p_weight How far the end bone moves from its animated position to the target, between 0 and 1, 0 skips the limb
+	 */
+	void SetIkTarget(const IkLimbId p_limb, const Vector3F& p_target, const float p_weight = 1.0f);
+
+	/**
+	 * @brief Set where a limb of a crowd instance reaches. The target goes back to the one of the main character when the crowd is spawned again.
+	 * @param p_instance The instance
+	 * @param p_limb The handle of the limb
+	 * @param p_target The position the end bone reaches, in the space of the skeleton of the instance
+	 * @param p_weight How far the end bone moves from its animated position to the target, between 0 and 1, 0 skips the limb
+	 * @throw std::logic_error if the crowd isn't spawned
+	 */
+	void SetCrowdIkTarget(const CrowdInstanceId p_instance, const IkLimbId p_limb, const Vector3F& p_target, const float p_weight = 1.0f);
+
+	/**
+	 * @brief Remove every IK limb.
+	 */
+	void ClearIkLimbs();
+
+	/**
+	 * @brief Write the skinning palette of the last evaluated pose, in the current palette mode, without sending it.
+	 */
+	void WriteSkinningPalette();
+
+	/**
+	 * @brief Set the layout of the skinning palette. It has to match the vertex shader referenced by skinning.program.
+	 * @param p_mode The new palette mode
+	 */
+	void SetSkinningPaletteMode(const SkinningPaletteMode p_mode);
+
+	/**
+	 * @brief Return the layout of the skinning palette.
+	 * @return The palette mode
+	 */
+	SkinningPaletteMode GetSkinningPaletteMode() const;
+
+	/**
+	 * @brief Choose the copy of the clips the pose is sampled from, the float keys by default. The compressed and reduced clips are built the first time they are chosen.
+	 * @param p_storage The new clip storage
+	 */
+	void SetClipStorage(const ClipStorage p_storage);
+
+	/**
+	 * @brief Return the copy of the clips the pose is sampled from.
+	 * @return The clip storage
+	 */
+	ClipStorage GetClipStorage() const;
+
+	/**
+	 * @brief Return where the last Init read the clips from and how long it took.
+	 * @return The import report, ClipSource::None before Init
+	 */
+	const ClipImportReport& GetClipImportReport() const;
+
+	/**
+	 * @brief Animate a crowd of instances next to the main character, on the same skeleton and clips. They alternate between walk and run with staggered times and speeds.
+	 * The crowd is spawned in Init if the simulation isn't initialized yet, and updated after the main character on every frame.
+	 * @param p_count The number of instances, 0 to remove the crowd
+	 */
+	void SetCrowdSize(const size_t p_count);
+
+	/**
+	 * @brief Set the number of threads running the update. The pose and the palette of the main character, then every crowd instance, are evaluated as jobs of a work-stealing job system.
+	 * The palettes are bit-identical whatever the thread count.
+	 * @param p_count The thread count, the calling thread included. 0 uses one per hardware thread, 1 updates everything on the calling thread without job system (the default).
+	 */
+	void SetThreadCount(const size_t p_count);
+
+	/**
+	 * @brief Return the number of threads running the update.
+	 * @return The thread count
+	 */
+	size_t ThreadCount() const;
+
+	/**
+	 * @brief Animate the crowd with the default levels of detail of the skeleton (AnimationLod::CreateDefault), or every bone of every instance on every frame.
+	 * The levels and their compressed clips are built in Init if the simulation isn't initialized yet. The main character keeps every bone.
+	 * @param p_enabled True to use the levels of detail
+	 */
+	void SetCrowdLod(const bool p_enabled);
+
+	/**
+	 * @brief Set the metric choosing the level of detail of every crowd instance, typically its distance to the camera divided by its importance.
+	 * The metrics are kept and assigned again when the crowd is spawned.
+	 * @param p_metrics The metric of every instance, in spawn order, +infinity for an instance that isn't visible
+	 * @throw std::invalid_argument if there are less metrics than crowd instances
+	 */
+	void SetCrowdLodMetrics(std::vector<float> p_metrics);
+
+	/**
+	 * @brief Return the levels of detail of the crowd.
+	 * @return The levels, nullptr if they aren't used or not built yet
+	 */
+	const AnimationLod* GetCrowdLod() const;
+
+	/**
+	 * @brief Return the crowd animated next to the main character.
+	 * @return The crowd, nullptr if it isn't spawned
+	 */
+	const Crowd* GetCrowd() const;
 
 	/**
 	 * @brief Return the current animation speed.
@@ -101,18 +451,111 @@ public:
 	 */
 	void SetAnimationFactorSpeed(const float p_speed = 1.0f);
 
+	/**
+	 * @brief Enable or disable the debug drawing (axis and skeleton lines). The pose and the skinning palette are produced either way.
+	 * @param p_enabled True to draw, false otherwise
+	 */
+	void SetDebugDraw(const bool p_enabled);
+
+	/**
+	 * @brief Return true if the debug drawing is enabled.
+	 * @return True if enabled, false otherwise
+	 */
+	bool IsDebugDrawEnabled() const;
+
 	/**
 	 * @brief Format all the data of the bones to see the relationship between their parents.
 	 */
 	void ShowBonesData();
 
+	/**
+	 * @brief Print the memory footprint and the error of the compressed and reduced copies of every clip.
+	 */
+	void ShowCompressionReport();
+
 private:
+	/**
+	 * @brief Start playing the locomotion blend space at the sync phase of the current clip.
+	 */
+	void StartLocomotion();
+
+	/**
+	 * @brief Add a layer to the stack, its mask built on the skeleton. The additive copy of the clip of an additive layer is built the first time it is used.
+	 * @param p_settingsIndex The index of the layer in the settings
+	 * @throw std::invalid_argument if the root bone isn't in the skeleton
+	 */
+	void AddLayerToStack(const size_t p_settingsIndex);
+
+	/**
+	 * @brief Find the chain of an IK limb on the skeleton and add it to the crowd.
+	 * @param p_settingsIndex The index of the limb in the settings
+	 * @throw std::invalid_argument if the end bone isn't in the skeleton or has less than 2 ancestors
+	 */
+	void AddIkLimbToSkeleton(const size_t p_settingsIndex);
+
+	/**
+	 * @brief Compute the world pose of the main character from its local pose, as matrices or dual quaternions depending on the palette mode.
+	 */
+	void ComputeWorldPose();
+
+	struct LayerSettings final
+	{
+		ClipId clipId;
+		LayerBlendMode mode;
+		std::string rootBoneName;
+		float weight;
+	};
+
+	struct IkLimbSettings final
+	{
+		std::string endBoneName;
+		IkGoal goal;
+	};
+
 	std::vector<float> m_skinningAnimationMatrices;
-	std::vector<Bone> m_bones{};
-	size_t m_keyAnimKeyCount{};
+	std::shared_ptr<const Skeleton> m_skeleton;
+	std::vector<int> m_engineBoneIndices{};
+	bool m_importFromResources{ false };
+	ClipImportReport m_clipImportReport{};
+	std::vector<LocalPose> m_localPose{};
+	std::vector<Matrix4F> m_worldPose{};
+	std::vector<DualQuaternion> m_worldDualQuaternions{};
 	float m_animationElapsedTime{};
 	float m_speedAnimation{};
 	float m_animationFactorSpeed{ 1.0f };
-	std::string m_animationName;
-	std::unordered_map<std::string, AnimationInfo> m_animationTransforms;
+	float m_crossfadeDuration{ 0.3f };
+	float m_fadeDuration{ 0.0f };
+	float m_fadeElapsedTime{ 0.0f };
+	SkinningPaletteMode m_paletteMode{ SkinningPaletteMode::Matrix4x4 };
+	bool m_debugDraw{ true };
+	bool m_debugDrawKeyHeld{ false };
+	ClipCache m_clipCache;
+	ClipRegistry m_clips;
+	std::vector<RootMotion> m_rootMotions{};
+	Vector3F m_rootPosition{ 0.0f, 0.0f, 0.0f };
+	std::vector<ClipCycle> m_clipCycles{};
+	BlendSpace1D m_locomotion{ m_clips };
+	std::optional<float> m_locomotionSpeed{};
+	float m_currentLocomotionSpeed{ 0.0f };
+	bool m_locomotionKeyHeld{ false };
+	std::vector<std::optional<AdditiveClip>> m_additiveClips{};
+	LayerStack m_layers{ m_clips, m_additiveClips };
+	std::vector<LayerSettings> m_layerSettings{};
+	std::vector<IkLimbSettings> m_ikLimbSettings{};
+	std::vector<IkChain> m_ikChains{};
+	TwoBoneIk m_ik{};
+	std::vector<CompressedClip> m_compressedClips{};
+	std::vector<ReducedClip> m_reducedClips{};
+	ReducedClipCursor m_reducedClipCursor{};
+	ClipStorage m_clipStorage{ ClipStorage::Keys };
+	std::unique_ptr<Crowd> m_crowd;
+	size_t m_crowdSize{ 0 };
+	std::unique_ptr<AnimationLod> m_crowdLod;
+	bool m_crowdLodEnabled{ false };
+	std::vector<float> m_crowdLodMetrics{};
+	std::unique_ptr<Jobs::JobSystem> m_jobSystem;
+	ClipId m_walkClip{};
+	ClipId m_runClip{};
+	ClipId m_currentClip{};
+	ClipId m_fadeSourceClip{};
 };
@@ -1,7 +1,25 @@
 #pragma once
-#include <unordered_map>
 #include <vector>
-#include <Resources/Transform.h>
+#include <GPM/GPM.h>
+#include <Animation/LocalPose.h>
+#include <Animation/QuaternionBatch.h>
+#include <Animation/BoneMask.h>
+#include <Memory/AlignedAllocator.h>
+
+/**
+ * @brief The float streams stored for every frame of an animation.
+ */
+enum class KeyStream : size_t
+{
+	TranslationX = 0,
+	TranslationY,
+	TranslationZ,
+	RotationX,
+	RotationY,
+	RotationZ,
+	RotationW,
+	Count
+};
 
 class AnimationInfo final
 {
@@ -33,10 +51,11 @@ public:
 	 * @param p_boneIndex The bone
 	 * @param p_localAnimPosition The vector to add
 	 * @param p_localAnimRotation The quaternion to add
+	 * @note Compatibility shim: the key is written in the next free frame of the bone in the frame-major storage.
 	 */
 	void AddAnimFrame(const size_t p_boneIndex,
 		const Vector3F& p_localAnimPosition,
-		const Quaternion& p_localAnimRotation);
+		const QuaternionF& p_localAnimRotation);
 
 	/**
 	 * @brief Update the animation's local data of a bone at a certain frame.
@@ -44,32 +63,93 @@ public:
 	 * @param p_frame The frame
 	 * @param p_localAnimPosition The vector to add
 	 * @param p_localAnimRotation The quaternion to add
+	 * @throw std::logic_error if the keys are mapped
 	 */
 	void UpdateAnimFrame(
 		const size_t p_boneIndex,
 		const size_t p_frame,
 		const Vector3F& p_localAnimPosition,
-		const Quaternion& p_localAnimRotation);
+		const QuaternionF& p_localAnimRotation);
 
 	/**
-	 * @brief Set the key count of the animation.
+	 * @brief Set the key count of the animation. Reallocates the key storage.
 	 * @param p_keyCount The new key count
 	 */
 	void SetKeyCount(const size_t p_keyCount);
 
 	/**
-	 * @brief Set the bone count of the animation.
+	 * @brief Set the bone count of the animation. Reallocates the key storage.
 	 * @param p_boneCount The new bone count
 	 */
 	void SetBoneCount(const size_t p_boneCount);
 
+	/**
+	 * @brief Use keys stored outside of the animation, in the layout of FrameStream, instead of its own storage. The keys are read in place and become read-only.
+	 * @param p_keys The keys, aligned on 32 bytes, they must outlive the animation or the next call to SetKeyCount or SetBoneCount
+	 * @param p_keyCount The key count
+	 * @param p_boneCount The bone count
+	 */
+	void MapKeys(const float* p_keys, const size_t p_keyCount, const size_t p_boneCount);
+
+	/**
+	 * @brief Return true if the keys are mapped with MapKeys.
+	 * @return True if mapped, false if the animation owns its keys
+	 */
+	bool AreKeysMapped() const;
+
 	/**
 	 * @brief Return the pair of the animation's local frame.
 	 * @param p_boneIndex The bone
 	 * @param p_frame The frame
 	 * @return A pair of position (first) and quaternion (second) of a bone at a certain frame
+	 * @note Compatibility shim: the pair is rebuilt from the key streams, prefer reading the streams on hot paths.
+	 */
+	std::pair<Vector3F, QuaternionF> LocalAnimFrame(const size_t p_boneIndex, const size_t p_frame) const;
+
+	/**
+	 * @brief Sample every bone of the animation at a given time. The key pair and the interpolation factor are resolved once for the whole pose.
+	 * @param p_time The time in keys, it wraps around the key count
+	 * @param p_pose The buffer receiving the local pose of each bone
+	 * @param p_boneCount The size of the buffer, only the first min(p_boneCount, BoneCount()) bones are written
+	 * @param p_interpolation The interpolation of the rotations, done for all bones at once by QuaternionBatch
+	 * @note This is the single entry point used to evaluate a clip every frame. Rotation keys are expected to be normalized.
 	 */
-	const std::pair<Vector3F, Quaternion>& LocalAnimFrame(const size_t p_boneIndex, const size_t p_frame) const;
+	void SamplePose(const float p_time, LocalPose* p_pose, const size_t p_boneCount,
+		const QuaternionInterpolation p_interpolation = QuaternionInterpolation::ApproximateSlerp) const;
+
+	/**
+	 * @brief Sample the bones of a mask at a given time, the other bones of the buffer are left untouched. Each range of consecutive bones of the mask is sampled like SamplePose.
+	 * @param p_time The time in keys, it wraps around the key count
+	 * @param p_mask The bones to sample
+	 * @param p_pose The buffer receiving the local pose of the bones of the mask
+	 * @param p_boneCount The size of the buffer, only the bones of the mask below min(p_boneCount, BoneCount()) are written
+	 * @param p_interpolation The interpolation of the rotations
+	 */
+	void SamplePose(const float p_time, const BoneMask& p_mask, LocalPose* p_pose, const size_t p_boneCount,
+		const QuaternionInterpolation p_interpolation = QuaternionInterpolation::ApproximateSlerp) const;
+
+	/**
+	 * @brief Sample this animation and another one, then blend the two poses, in one pass over the bones. Used to crossfade from this animation to p_target.
+	 * @param p_time The time in this animation, in keys
+	 * @param p_target The animation faded in
+	 * @param p_targetTime The time in p_target, in keys
+	 * @param p_weight The weight of p_target, between 0 (this animation only) and 1 (p_target only)
+	 * @param p_pose The buffer receiving the blended local pose of each bone
+	 * @param p_boneCount The size of the buffer, only the bones of both animations are written
+	 * @param p_interpolation The interpolation of the rotations, also used for the blend
+	 * @throw std::out_of_range if one of the animations has no key
+	 */
+	void SampleBlendedPose(const float p_time, const AnimationInfo& p_target, const float p_targetTime, const float p_weight,
+		LocalPose* p_pose, const size_t p_boneCount,
+		const QuaternionInterpolation p_interpolation = QuaternionInterpolation::ApproximateSlerp) const;
+
+	/**
+	 * @brief Return one stream of a frame. The stream holds BoneCount() contiguous floats, indexed by bone.
+	 * @param p_frame The frame
+	 * @param p_stream The stream to read
+	 * @return A pointer to the first bone of the stream, aligned on 32 bytes
+	 */
+	const float* FrameStream(const size_t p_frame, const KeyStream p_stream) const;
 
 	/**
 	 * @brief Return the key count of the animation.
@@ -84,11 +164,17 @@ public:
 	size_t BoneCount() const;
 
 	/**
-	 * @brief Move assignment operator
-	 * @param p_other The other animation to move
+	 * @brief Return the memory used by the keys of the animation.
+	 * @return The size in bytes
+	 */
+	size_t KeyMemorySize() const;
+
+	/**
+	 * @brief Copy assignment operator
+	 * @param p_other The other animation to copy
 	 * @return The modified animation
 	 */
-	AnimationInfo& operator=(const AnimationInfo& p_other) = default;
+	AnimationInfo& operator=(const AnimationInfo& p_other);
 
 	/**
 	 * @brief Move assignment operator
@@ -98,7 +184,52 @@ public:
 	AnimationInfo& operator=(AnimationInfo&& p_other) noexcept;
 
 private:
+	/**
+	 * @brief Interpolate the keys of a range of bones between two frames.
+	 * @param p_beginFrame The frame before the time
+	 * @param p_endFrame The frame after the time
+	 * @param p_alpha The interpolation factor
+	 * @param p_firstBone The first bone of the range
+	 * @param p_endBone The end of the range
+	 * @param p_pose The buffer receiving the local pose, indexed by bone
+	 * @param p_interpolation The interpolation of the rotations
+	 */
+	void SampleBones(const size_t p_beginFrame, const size_t p_endFrame, const float p_alpha, const size_t p_firstBone, const size_t p_endBone,
+		LocalPose* p_pose, const QuaternionInterpolation p_interpolation) const;
+
+	/**
+	 * @brief Allocate the key storage for the current key and bone count. Every key is reset to identity.
+	 */
+	void AllocateKeys();
+
+	/**
+	 * @brief Return the index of the first float of a stream in the key storage.
+	 * @param p_frame The frame
+	 * @param p_stream The stream
+	 * @return The index
+	 */
+	size_t StreamOffset(const size_t p_frame, const KeyStream p_stream) const;
+
 	size_t m_keyCount;
 	size_t m_boneCount;
-	std::unordered_map<size_t, std::vector<std::pair<Vector3F, Quaternion>>> m_keyFrame;
+
+	/**
+	 * @brief Number of floats of one stream, the bone count rounded up to keep every stream aligned.
+	 */
+	size_t m_streamStride;
+
+	/**
+	 * @brief Every key of the animation, frame-major: [frame][stream][bone].
+	 */
+	std::vector<float, Memory::AlignedAllocator<float>> m_keys;
+
+	/**
+	 * @brief The keys read by FrameStream: m_keys, or the keys given to MapKeys.
+	 */
+	const float* m_keyData;
+
+	/**
+	 * @brief Number of frames already written by AddAnimFrame for each bone.
+	 */
+	std::vector<size_t> m_addedFrameCount;
 };
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <Resources/Skeleton.h>
+#include <Animation/BoneMask.h>
+#include <Animation/ClipRegistry.h>
+#include <Animation/CompressedClip.h>
+
+/**
+ * @brief Levels of detail of the animation of a character, from the most detailed (level 0) to the least.
+ * Each level animates a subset of the bones, the others keeping their bind pose, and is evaluated once every few frames.
+ * A level is chosen from a metric given by the caller, typically the distance to the camera divided by the importance of the character:
+ * the first level whose maximum metric isn't below it, no level (not animated) past the last one.
+ */
+class AnimationLod final
+{
+public:
+	/**
+	 * @brief Constructor of a table without level.
+	 */
+	AnimationLod() = default;
+
+	/**
+	 * @brief Default destructor
+	 */
+	~AnimationLod() = default;
+
+	/**
+	 * @brief Return the default levels for a skeleton, the bones being found by name (missing ones are ignored):
+	 * every bone every frame up to 500, no finger up to 1500, no finger nor twist bone every 2 frames up to 4000,
+	 * then no neck, clavicle nor toe either every 4 frames. Only an infinite metric isn't animated.
+	 * @param p_skeleton The skeleton
+	 * @return The levels
+	 */
+	static AnimationLod CreateDefault(const Skeleton& p_skeleton);
+
+	/**
+	 * @brief Add a level, less detailed than the ones already added.
+	 * @param p_bones The bones animated at this level
+	 * @param p_updateInterval The number of frames between 2 evaluations, at least 1
+	 * @param p_maxMetric The largest metric of this level
+	 * @return The index of the level
+	 * @throw std::invalid_argument if the interval is 0 or the metric is below the one of the previous level
+	 */
+	size_t AddLevel(const BoneMask& p_bones, const uint32_t p_updateInterval, const float p_maxMetric);
+
+	/**
+	 * @brief Compress the clips for every level, the bones out of a level being stored as constant bind pose tracks.
+	 * @param p_clips The clips, sampled by ClipId
+	 */
+	void BuildClips(const ClipRegistry& p_clips);
+
+	/**
+	 * @brief Return the number of levels.
+	 * @return The level count, also the level of the characters that aren't animated
+	 */
+	size_t LevelCount() const;
+
+	/**
+	 * @brief Return the level of a metric.
+	 * @param p_metric The metric of a character
+	 * @return The level, LevelCount() if the character isn't animated
+	 */
+	size_t SelectLevel(const float p_metric) const;
+
+	/**
+	 * @brief Return the bones animated at a level.
+	 * @param p_level The level
+	 * @return The mask
+	 */
+	const BoneMask& Bones(const size_t p_level) const;
+
+	/**
+	 * @brief Return the number of frames between 2 evaluations at a level.
+	 * @param p_level The level
+	 * @return The interval
+	 */
+	uint32_t UpdateInterval(const size_t p_level) const;
+
+	/**
+	 * @brief Return the largest metric of a level.
+	 * @param p_level The level
+	 * @return The metric
+	 */
+	float MaxMetric(const size_t p_level) const;
+
+	/**
+	 * @brief Return the clips compressed for a level by BuildClips.
+	 * @param p_level The level
+	 * @return The clips, indexed by ClipId, empty before BuildClips
+	 */
+	const std::vector<CompressedClip>& Clips(const size_t p_level) const;
+
+private:
+	struct Level final
+	{
+		BoneMask bones;
+		uint32_t updateInterval;
+		float maxMetric;
+		std::vector<CompressedClip> clips;
+	};
+
+	std::vector<Level> m_levels{};
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include <vector>
+#include <Animation/ClipRegistry.h>
+#include <Animation/ClipCycle.h>
+#include <Animation/LocalPose.h>
+
+/**
+ * @brief Blend of locomotion clips keyed on the speed of the character. The two clips around the speed are played at the same sync phase,
+ * each one time-warped between its own sync markers, and blended with the weight that makes the blended stride match the speed, so that the feet don't slide.
+ * Below the slowest clip and above the fastest one, that clip alone is played slower or faster.
+ */
+class BlendSpace1D final
+{
+public:
+	/**
+	 * @brief Constructor, the blend space starts without clip.
+	 * @param p_clips The clips, they must outlive the blend space
+	 */
+	explicit BlendSpace1D(const ClipRegistry& p_clips);
+
+	/**
+	 * @brief Default destructor
+	 */
+	~BlendSpace1D() = default;
+
+	/**
+	 * @brief Add a clip, placed by the speed it covers its stride at. The clip played is chosen again by the next Update.
+	 * @param p_clipId The clip
+	 * @param p_cycle The cycle of the clip, computed once at import
+	 * @throw std::invalid_argument if the clip doesn't move the character or has another marker count than the clips already added
+	 */
+	void AddClip(const ClipId p_clipId, const ClipCycle& p_cycle);
+
+	/**
+	 * @brief Remove every clip.
+	 */
+	void Clear();
+
+	/**
+	 * @brief Return the number of clips.
+	 * @return The clip count
+	 */
+	size_t ClipCount() const;
+
+	/**
+	 * @brief Return true if a clip is in the blend space.
+	 * @param p_clipId The clip
+	 * @return True if the clip was added
+	 */
+	bool HasClip(const ClipId p_clipId) const;
+
+	/**
+	 * @brief Return the speed a clip covers its stride at when played at a given rate.
+	 * @param p_clipId The clip
+	 * @param p_keysPerSecond The playback rate
+	 * @return The speed in units per second
+	 * @throw std::out_of_range if the clip isn't in the blend space
+	 */
+	float ClipSpeed(const ClipId p_clipId, const float p_keysPerSecond) const;
+
+	/**
+	 * @brief Choose the clips and the weight for a speed, then advance the sync phase by the blended cycle.
+	 * @param p_deltaTime Time between 2 frames
+	 * @param p_speed The speed of the character in units per second, negative speeds are clamped to 0
+	 * @param p_keysPerSecond The rate the clips are authored to be played at
+	 * @throw std::logic_error if the blend space has no clip
+	 */
+	void Update(const float p_deltaTime, const float p_speed, const float p_keysPerSecond);
+
+	/**
+	 * @brief Sample the clips chosen by the last Update at the current sync phase, blended in a single pass over the bones when there are two.
+	 * @param p_pose The buffer receiving the local pose of each bone
+	 * @param p_boneCount The size of the buffer
+	 * @throw std::logic_error if the blend space has no clip
+	 */
+	void SamplePose(LocalPose* p_pose, const size_t p_boneCount) const;
+
+	/**
+	 * @brief Set the sync phase, to start from the pose of a clip.
+	 * @param p_syncPhase The sync phase, it wraps around the marker count
+	 */
+	void SetPhase(const float p_syncPhase);
+
+	/**
+	 * @brief Return the sync phase.
+	 * @return The sync phase, between 0 and the marker count
+	 */
+	float Phase() const;
+
+	/**
+	 * @brief Return the clip with the largest weight.
+	 * @return The clip
+	 * @throw std::logic_error if the blend space has no clip
+	 */
+	ClipId DominantClip() const;
+
+	/**
+	 * @brief Return the time of a clip of the blend space at the current sync phase.
+	 * @param p_clipId The clip
+	 * @return The time in keys
+	 * @throw std::out_of_range if the clip isn't in the blend space
+	 */
+	float ClipTime(const ClipId p_clipId) const;
+
+	/**
+	 * @brief Return the weight of the faster clip of the two blended.
+	 * @return The weight between 0 and 1, 0 when a single clip is played
+	 */
+	float Weight() const;
+
+private:
+	struct Sample final
+	{
+		ClipId clipId;
+		ClipCycle cycle;
+
+		/**
+		 * @brief Stride length per key, the speed of the clip at one key per second.
+		 */
+		float speedPerKey;
+	};
+
+	const Sample& FindSample(const ClipId p_clipId) const;
+
+	const ClipRegistry& m_clips;
+	std::vector<Sample> m_samples{};
+	float m_phase{ 0.0f };
+	size_t m_lower{ 0 };
+	size_t m_upper{ 0 };
+	float m_weight{ 0.0f };
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <Resources/Skeleton.h>
+
+/**
+ * @brief Set of bones of a skeleton, stored as a bitset of one bit per bone.
+ * The bones are visited as ranges of consecutive indices, so that a mask over a subtree (whose bones are contiguous, parents coming before their children)
+ * is read as a single range and the bones outside of the mask are never touched.
+ */
+class BoneMask final
+{
+public:
+	/**
+	 * @brief Constructor of an empty mask over no bone.
+	 */
+	BoneMask() = default;
+
+	/**
+	 * @brief Constructor
+	 * @param p_boneCount The bone count of the skeleton
+	 * @param p_allBones True to set every bone, false to start empty
+	 */
+	explicit BoneMask(const size_t p_boneCount, const bool p_allBones = false);
+
+	/**
+	 * @brief Return the mask of a bone and all of its descendants.
+	 * @param p_skeleton The skeleton
+	 * @param p_rootBoneIndex The root of the subtree
+	 * @return The mask
+	 * @throw std::out_of_range if the bone isn't in the skeleton
+	 */
+	static BoneMask FromSubtree(const Skeleton& p_skeleton, const size_t p_rootBoneIndex);
+
+	/**
+	 * @brief Add or remove a bone.
+	 * @param p_boneIndex The bone
+	 * @param p_value True to add the bone, false to remove it
+	 * @throw std::out_of_range if the bone is out of the mask
+	 */
+	void Set(const size_t p_boneIndex, const bool p_value = true);
+
+	/**
+	 * @brief Return true if a bone is in the mask.
+	 * @param p_boneIndex The bone
+	 * @return True if set, false otherwise or if the bone is out of the mask
+	 */
+	bool Test(const size_t p_boneIndex) const;
+
+	/**
+	 * @brief Add the bones that aren't in the mask and remove the others.
+	 */
+	void Invert();
+
+	/**
+	 * @brief Return the number of bones in the mask.
+	 * @return The count of set bones
+	 */
+	size_t Count() const;
+
+	/**
+	 * @brief Return the bone count of the skeleton the mask is made for.
+	 * @return The bone count
+	 */
+	size_t BoneCount() const;
+
+	/**
+	 * @brief Return the first bone from a given one whose bit has a given value.
+	 * @param p_boneIndex The bone to start from
+	 * @param p_value The value searched
+	 * @return The bone, BoneCount() if there is none
+	 */
+	size_t FindNext(const size_t p_boneIndex, const bool p_value) const;
+
+	/**
+	 * @brief Call a function for every range of consecutive bones in the mask, in order.
+	 * @param p_function Called with the first bone and the end of the range
+	 */
+	template <typename Function>
+	void ForEachRange(const Function& p_function) const;
+
+private:
+	size_t m_boneCount{ 0 };
+	std::vector<uint64_t> m_words{};
+};
+
+#include <Animation/BoneMask.inl>
@@ -0,0 +1,12 @@
+#pragma once
+
+template <typename Function>
+void BoneMask::ForEachRange(const Function& p_function) const
+{
+	for (size_t begin = FindNext(0, true); begin < m_boneCount;)
+	{
+		const size_t end = FindNext(begin, false);
+		p_function(begin, end);
+		begin = FindNext(end, true);
+	}
+}
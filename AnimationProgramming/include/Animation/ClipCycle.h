@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <Resources/Skeleton.h>
+#include <Animation/AnimationInfo.h>
+
+/**
+ * @brief Bones used to find the gait events of a locomotion cycle.
+ */
+struct GaitBones final
+{
+	size_t leftThigh;
+	size_t rightThigh;
+	size_t leftFoot;
+	size_t rightFoot;
+};
+
+/**
+ * @brief Timing of a looping clip, computed once at import: its cycle length, its sync markers and the distance it covers per cycle.
+ * A sync phase counts the markers passed, from 0 to MarkerCount(): two clips at the same sync phase are at the same gait event,
+ * whatever their key counts and the spacing of their markers.
+ */
+class ClipCycle final
+{
+public:
+	/**
+	 * @brief Constructor of a cycle without gait: a single marker on the first key, the sync phase is the normalized time.
+	 * @param p_clip The clip
+	 * @throw std::invalid_argument if the clip has no key
+	 */
+	explicit ClipCycle(const AnimationInfo& p_clip);
+
+	/**
+	 * @brief Constructor, finding the two gait events of a locomotion clip: the keys where the thighs are spread the most one way (marker 0) and the other way (marker 1).
+	 * The swing of a thigh is its local rotation projected on its main axis, the extremums are refined between keys.
+	 * The stride is how much the separation of the feet changes over the cycle, along the direction it changes the most.
+	 * @param p_clip The clip
+	 * @param p_skeleton The skeleton the clip plays on
+	 * @param p_bones The legs of the skeleton
+	 * @throw std::invalid_argument if the clip has no key or a bone is out of range
+	 */
+	ClipCycle(const AnimationInfo& p_clip, const Skeleton& p_skeleton, const GaitBones& p_bones);
+
+	/**
+	 * @brief Constructor of a cycle computed before, read back from the clip cache.
+	 * @param p_keyCount The key count of the clip
+	 * @param p_strideLength The stride length, 0 for a cycle without gait
+	 * @param p_markers The time of every sync marker
+	 * @throw std::invalid_argument if the key count is 0 or there is no marker
+	 */
+	ClipCycle(const size_t p_keyCount, const float p_strideLength, std::vector<float> p_markers);
+
+	/**
+	 * @brief Default destructor
+	 */
+	~ClipCycle() = default;
+
+	/**
+	 * @brief Return the length of the cycle.
+	 * @return The key count of the clip
+	 */
+	float KeyCount() const;
+
+	/**
+	 * @brief Return the distance covered by the character over one cycle.
+	 * @return The stride length, 0 for a cycle without gait
+	 */
+	float StrideLength() const;
+
+	/**
+	 * @brief Return the number of sync markers, the sync phase wraps around it.
+	 * @return The marker count, at least 1
+	 */
+	size_t MarkerCount() const;
+
+	/**
+	 * @brief Return the time of a sync marker.
+	 * @param p_marker The marker
+	 * @return The time in keys
+	 */
+	float MarkerTime(const size_t p_marker) const;
+
+	/**
+	 * @brief Return the number of keys between a marker and the next one.
+	 * @param p_marker The marker
+	 * @return The segment length in keys
+	 */
+	float SegmentLength(const size_t p_marker) const;
+
+	/**
+	 * @brief Return the time of the clip at a sync phase, interpolating linearly between the two surrounding markers.
+	 * @param p_syncPhase The sync phase, it wraps around MarkerCount()
+	 * @return The time in keys, within the cycle
+	 */
+	float ClipTime(const float p_syncPhase) const;
+
+	/**
+	 * @brief Return the sync phase of a time of the clip, inverse of ClipTime.
+	 * @param p_time The time in keys, it wraps around the key count
+	 * @return The sync phase, between 0 and MarkerCount()
+	 */
+	float SyncPhase(const float p_time) const;
+
+private:
+	float WrapTime(const float p_time) const;
+
+	float m_keyCount{ 0.0f };
+	float m_strideLength{ 0.0f };
+	std::vector<float> m_markers;
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Animation/AnimationInfo.h>
+
+/**
+ * @brief Dense handle of a clip inside a ClipRegistry. Handles are given in registration order, starting at 0.
+ */
+using ClipId = uint32_t;
+
+class ClipRegistry final
+{
+public:
+	/**
+	 * @brief Default constructor
+	 */
+	ClipRegistry() = default;
+
+	/**
+	 * @brief Default destructor
+	 */
+	~ClipRegistry() = default;
+
+	/**
+	 * @brief Register a clip by name. Registering a name twice returns the handle given the first time.
+	 * @param p_clipName The name of the clip, as known by the engine
+	 * @return The handle of the clip
+	 */
+	ClipId Register(const std::string_view& p_clipName);
+
+	/**
+	 * @brief Look up the handle of a clip from its name. This is a linear search meant for the edges (input, loading), not for the update loop.
+	 * @param p_clipName The name of the clip
+	 * @return An optional holding the handle if the clip is registered, empty otherwise
+	 */
+	std::optional<ClipId> Find(const std::string_view& p_clipName) const;
+
+	/**
+	 * @brief Return a clip from its handle.
+	 * @param p_clipId The handle
+	 * @return The clip
+	 */
+	AnimationInfo& Clip(const ClipId p_clipId);
+
+	/**
+	 * @brief Return a clip from its handle.
+	 * @param p_clipId The handle
+	 * @return The clip
+	 */
+	const AnimationInfo& Clip(const ClipId p_clipId) const;
+
+	/**
+	 * @brief Return the name of a clip from its handle.
+	 * @param p_clipId The handle
+	 * @return The name given at registration
+	 */
+	const std::string& Name(const ClipId p_clipId) const;
+
+	/**
+	 * @brief Return the number of registered clips. Every handle is lower than this value.
+	 * @return The clip count
+	 */
+	size_t Count() const;
+
+private:
+	std::vector<AnimationInfo> m_clips;
+	std::vector<std::string> m_names;
+};
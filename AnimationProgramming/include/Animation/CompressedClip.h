@@ -0,0 +1,206 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <Animation/AnimationInfo.h>
+#include <Animation/QuaternionBatch.h>
+#include <Animation/BoneMask.h>
+#include <Memory/AlignedAllocator.h>
+
+class Skeleton;
+
+/**
+ * @brief The 16 bits streams stored for every frame of a compressed clip. Translation streams only hold the animated translation tracks, rotation streams the animated rotation tracks.
+ */
+enum class CompressedStream : size_t
+{
+	TranslationX = 0,
+	TranslationY,
+	TranslationZ,
+	Rotation0,
+	Rotation1,
+	Rotation2,
+	Count
+};
+
+/**
+ * @brief Error of a compressed clip against its source, measured on every key.
+ */
+struct CompressionReport final
+{
+	/**
+	 * @brief Largest distance between a decoded local translation and the source one.
+	 */
+	float maxLocalTranslationError{ 0.0f };
+
+	/**
+	 * @brief Largest angle in radians between a decoded local rotation and the source one.
+	 */
+	float maxLocalRotationError{ 0.0f };
+
+	/**
+	 * @brief Largest distance between the world position of a bone evaluated from the decoded keys and from the source ones.
+	 */
+	float maxWorldPositionError{ 0.0f };
+
+	/**
+	 * @brief Number of bones whose translation, respectively rotation, is stored once instead of once per key.
+	 */
+	size_t constantTranslationTrackCount{ 0 };
+	size_t constantRotationTrackCount{ 0 };
+
+	size_t sourceMemorySize{ 0 };
+	size_t compressedMemorySize{ 0 };
+};
+
+/**
+ * @brief Read-only quantized copy of an AnimationInfo.
+ * Rotations are stored in 48 bits as their three smallest components (15 bits each) and the index of the dropped one,
+ * translations in 16 bits per axis against the range of their track. Keys are decoded while sampling, the clip is never expanded.
+ * Tracks that don't move more than a tolerance over the whole clip are stored as a single value and are neither decoded nor interpolated.
+ */
+class CompressedClip final
+{
+public:
+	/**
+	 * @brief Default largest distance, on each axis, between a key of a constant translation track and its stored value.
+	 */
+	static constexpr float constantTranslationTolerance = 1.0e-3f;
+
+	/**
+	 * @brief Default largest angle in radians between a key of a constant rotation track and its stored value, about the quantization error of a rotation.
+	 */
+	static constexpr float constantRotationTolerance = 1.0e-4f;
+
+	/**
+	 * @brief Default constructor, an empty clip
+	 */
+	CompressedClip() = default;
+
+	/**
+	 * @brief Quantize every key of an animation, after collapsing its constant tracks.
+	 * @param p_source The animation to compress, its rotation keys must be normalized
+	 * @param p_translationTolerance The largest deviation on each axis for a translation track to be considered constant
+	 * @param p_rotationTolerance The largest angle in radians for a rotation track to be considered constant
+	 */
+	explicit CompressedClip(const AnimationInfo& p_source,
+		const float p_translationTolerance = constantTranslationTolerance,
+		const float p_rotationTolerance = constantRotationTolerance);
+
+	/**
+	 * @brief Quantize the keys of the bones of a mask, the other bones keep their bind pose (identity local pose) as constant tracks, so they cost nothing to sample.
+	 * @param p_source The animation to compress, its rotation keys must be normalized
+	 * @param p_bones The bones animated
+	 * @param p_translationTolerance The largest deviation on each axis for a translation track to be considered constant
+	 * @param p_rotationTolerance The largest angle in radians for a rotation track to be considered constant
+	 */
+	CompressedClip(const AnimationInfo& p_source, const BoneMask& p_bones,
+		const float p_translationTolerance = constantTranslationTolerance,
+		const float p_rotationTolerance = constantRotationTolerance);
+
+	/**
+	 * @brief Default destructor
+	 */
+	~CompressedClip() = default;
+
+	/**
+	 * @brief Sample every bone of the clip at a given time, decoding the two surrounding keys on the fly. Same contract as AnimationInfo::SamplePose.
+	 * @param p_time The time in keys, it wraps around the key count
+	 * @param p_pose The buffer receiving the local pose of each bone
+	 * @param p_boneCount The size of the buffer, only the first min(p_boneCount, BoneCount()) bones are written
+	 * @param p_interpolation The interpolation of the rotations
+	 * @throw std::out_of_range if the clip has no key
+	 */
+	void SamplePose(const float p_time, LocalPose* p_pose, const size_t p_boneCount,
+		const QuaternionInterpolation p_interpolation = QuaternionInterpolation::ApproximateSlerp) const;
+
+	/**
+	 * @brief Decode one key.
+	 * @param p_boneIndex The bone
+	 * @param p_frame The frame
+	 * @return The decoded local pose of the bone at this frame
+	 * @throw std::out_of_range if the bone or the frame doesn't exist
+	 */
+	LocalPose DecodeKey(const size_t p_boneIndex, const size_t p_frame) const;
+
+	/**
+	 * @brief Measure the error of the clip against the animation it was built from, in local space and in world space.
+	 * @param p_source The animation given to the constructor
+	 * @param p_skeleton The skeleton the animation plays on
+	 * @return The report
+	 */
+	CompressionReport MeasureError(const AnimationInfo& p_source, const Skeleton& p_skeleton) const;
+
+	/**
+	 * @brief Return the key count of the clip.
+	 * @return The key count
+	 */
+	size_t KeyCount() const;
+
+	/**
+	 * @brief Return the bone count of the clip.
+	 * @return The bone count
+	 */
+	size_t BoneCount() const;
+
+	/**
+	 * @brief Return the number of translation tracks stored per key, the other ones being constant.
+	 * @return The animated translation track count
+	 */
+	size_t AnimatedTranslationCount() const;
+
+	/**
+	 * @brief Return the number of rotation tracks stored per key, the other ones being constant.
+	 * @return The animated rotation track count
+	 */
+	size_t AnimatedRotationCount() const;
+
+	/**
+	 * @brief Return the memory used by the keys, the translation ranges and the constant tracks of the clip.
+	 * @return The size in bytes
+	 */
+	size_t MemorySize() const;
+
+private:
+	/**
+	 * @brief Return the index of the first value of a stream in the key storage.
+	 * @param p_frame The frame
+	 * @param p_stream The stream
+	 * @return The index
+	 */
+	size_t StreamOffset(const size_t p_frame, const CompressedStream p_stream) const;
+
+	size_t m_keyCount{ 0 };
+	size_t m_boneCount{ 0 };
+
+	/**
+	 * @brief Number of values of one translation, respectively rotation, stream: the animated track count rounded up to keep every stream aligned.
+	 */
+	size_t m_translationStride{ 0 };
+	size_t m_rotationStride{ 0 };
+
+	/**
+	 * @brief Bone of each animated translation, respectively rotation, track, in increasing order.
+	 */
+	std::vector<uint32_t> m_translationBones;
+	std::vector<uint32_t> m_rotationBones;
+
+	/**
+	 * @brief Value of the constant tracks of each bone, copied as is into every sampled pose.
+	 */
+	std::vector<LocalPose> m_constantPose;
+
+	/**
+	 * @brief Every key of the animated tracks, frame-major: [frame][stream][track].
+	 */
+	std::vector<uint16_t, Memory::AlignedAllocator<uint16_t>> m_keys;
+
+	/**
+	 * @brief Lowest translation of each animated translation track, axis-major: [axis][track].
+	 */
+	std::vector<float> m_translationMinimum;
+
+	/**
+	 * @brief Size of one quantization step of each animated translation track, axis-major: [axis][track].
+	 */
+	std::vector<float> m_translationStep;
+};
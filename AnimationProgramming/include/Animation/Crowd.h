@@ -0,0 +1,276 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Resources/Skeleton.h>
+#include <Animation/ClipRegistry.h>
+#include <Animation/CompressedClip.h>
+#include <Animation/AnimationLod.h>
+#include <Animation/SkinningPalette.h>
+#include <Animation/TwoBoneIk.h>
+#include <Jobs/JobSystem.h>
+
+/**
+ * @brief Dense handle of an instance inside a Crowd. Handles are given in spawn order, starting at 0.
+ */
+using CrowdInstanceId = uint32_t;
+
+/**
+ * @brief Many characters animated on the same skeleton and clips.
+ * The skeleton and the clips are shared read-only. Each instance only owns its clip, time, speed factor and LOD level (13 bytes, stored as parallel arrays), its palette
+ * and the target and weight of each IK limb (16 bytes per limb).
+ * The poses are evaluated one instance at a time in scratch buffers, one set per thread, so that instances can be updated in parallel with the same result as serially.
+ * With IK limbs, the poses of updateGrainSize instances are kept in the scratch buffers so that the limbs of all of them are solved in one batch.
+ */
+class Crowd final
+{
+public:
+	/**
+	 * @brief Constructor, the crowd starts empty.
+	 * @param p_skeleton The skeleton of every instance
+	 * @param p_clips The clips the instances play, they must outlive the crowd
+	 * @param p_paletteMode The layout of the palettes
+	 */
+	Crowd(std::shared_ptr<const Skeleton> p_skeleton, const ClipRegistry& p_clips, const SkinningPaletteMode p_paletteMode = SkinningPaletteMode::Matrix4x4);
+
+	Crowd(const Crowd&) = delete;
+
+	/**
+	 * @brief Default destructor
+	 */
+	~Crowd() = default;
+
+	Crowd& operator=(const Crowd&) = delete;
+
+	/**
+	 * @brief Add an instance. Its palette is written by the next Update.
+	 * @param p_clipId The clip it plays
+	 * @param p_time The time in the clip, in keys
+	 * @param p_speedFactor The coefficient of its speed
+	 * @return The handle of the instance
+	 * @throw std::out_of_range if the clip isn't registered or has no key
+	 */
+	CrowdInstanceId Spawn(const ClipId p_clipId, const float p_time = 0.0f, const float p_speedFactor = 1.0f);
+
+	/**
+	 * @brief Remove every instance.
+	 */
+	void Clear();
+
+	/**
+	 * @brief Return the number of instances.
+	 * @return The instance count
+	 */
+	size_t Count() const;
+
+	/**
+	 * @brief Play another clip from the start.
+	 * @param p_instance The instance
+	 * @param p_clipId The clip
+	 * @throw std::out_of_range if the clip isn't registered or has no key
+	 */
+	void PlayClip(const CrowdInstanceId p_instance, const ClipId p_clipId);
+
+	/**
+	 * @brief Set the coefficient of the speed of an instance.
+	 * @param p_instance The instance
+	 * @param p_speedFactor The new speed factor
+	 */
+	void SetSpeedFactor(const CrowdInstanceId p_instance, const float p_speedFactor);
+
+	/**
+	 * @brief Return the clip played by an instance.
+	 * @param p_instance The instance
+	 * @return The clip
+	 */
+	ClipId Clip(const CrowdInstanceId p_instance) const;
+
+	/**
+	 * @brief Return the time of an instance in its clip, in keys. It is kept within the clip so that it never loses precision.
+	 * @param p_instance The instance
+	 * @return The time
+	 */
+	float Time(const CrowdInstanceId p_instance) const;
+
+	/**
+	 * @brief Return the coefficient of the speed of an instance.
+	 * @param p_instance The instance
+	 * @return The speed factor
+	 */
+	float SpeedFactor(const CrowdInstanceId p_instance) const;
+
+	/**
+	 * @brief Sample the compressed clips instead of the float keys, or go back to the keys.
+	 * @param p_compressedClips The compressed copy of every clip, indexed by ClipId, nullptr to sample the keys. It must outlive the crowd or the next call.
+	 */
+	void SetCompressedClips(const std::vector<CompressedClip>* p_compressedClips);
+
+	/**
+	 * @brief Animate the instances with levels of detail, or go back to every bone on every frame. Every instance starts at level 0 until AssignLods.
+	 * An instance is evaluated once every UpdateInterval frames of its level, the instances of a level being spread over those frames, and keeps its palette in between.
+	 * Its time still advances on every frame. With the compressed clips, the clips of its level are sampled, otherwise only the keys of the bones of its level.
+	 * @param p_lod The levels, with their clips built for the compressed clips, nullptr for no LOD. It must outlive the crowd or the next call.
+	 * @throw std::invalid_argument if there are more than 127 levels
+	 */
+	void SetLod(const AnimationLod* p_lod);
+
+	/**
+	 * @brief Choose the level of every instance from a metric, see AnimationLod::SelectLevel. An instance changing level is evaluated by the next Update.
+	 * @param p_metrics The metric of every instance, Count() values
+	 */
+	void AssignLods(const float* p_metrics);
+
+	/**
+	 * @brief Return the LOD level of an instance.
+	 * @param p_instance The instance
+	 * @return The level, the level count of the LOD if the instance isn't animated, 0 without LOD
+	 */
+	size_t Lod(const CrowdInstanceId p_instance) const;
+
+	/**
+	 * @brief Add a limb solved with two-bone IK on every instance, after its pose is sampled. Its target starts with a weight of 0, which leaves the pose untouched.
+	 * @param p_chain The bones of the limb
+	 * @param p_poleOffset Where the middle bone bends towards, relative to its current position, see TwoBoneIk::Add
+	 * @return The handle of the limb
+	 * @throw std::out_of_range if a bone of the chain isn't in the skeleton
+	 */
+	IkLimbId AddIkLimb(const IkChain& p_chain, const Vector3F& p_poleOffset);
+
+	/**
+	 * @brief Remove every IK limb.
+	 */
+	void ClearIkLimbs();
+
+	/**
+	 * @brief Return the number of IK limbs.
+	 * @return The limb count
+	 */
+	size_t IkLimbCount() const;
+
+	/**
+	 * @brief Set where a limb of an instance reaches, from the next Update. Instances spawned later start with a weight of 0.
+	 * @param p_instance The instance
+	 * @param p_limb The limb
+	 * @param p_target The position the end bone reaches, in the space of the skeleton of the instance
+	 * @param p_weight How far the end bone moves from its animated position to the target, between 0 and 1, 0 skips the limb
+	 */
+	void SetIkTarget(const CrowdInstanceId p_instance, const IkLimbId p_limb, const Vector3F& p_target, const float p_weight);
+
+	/**
+	 * @brief Set the layout of the palettes. They are reallocated and written by the next Update.
+	 * @param p_mode The new palette mode
+	 */
+	void SetPaletteMode(const SkinningPaletteMode p_mode);
+
+	/**
+	 * @brief Return the layout of the palettes.
+	 * @return The palette mode
+	 */
+	SkinningPaletteMode GetPaletteMode() const;
+
+	/**
+	 * @brief Advance every instance, then evaluate its pose and write its palette.
+	 * @param p_deltaTime Time between 2 frames
+	 * @param p_speed The animation speed, in keys per second, multiplied by the speed factor of each instance
+	 */
+	void Update(const float p_deltaTime, const float p_speed);
+
+	/**
+	 * @brief Dispatch the update of every instance as jobs of updateGrainSize instances, without waiting. The palettes are bit-identical to the serial Update.
+	 * @param p_deltaTime Time between 2 frames
+	 * @param p_speed The animation speed, in keys per second, multiplied by the speed factor of each instance
+	 * @param p_jobs The job system running the jobs
+	 * @param p_counter The counter of the jobs, the crowd must not be used nor modified until it is waited on
+	 */
+	void Update(const float p_deltaTime, const float p_speed, Jobs::JobSystem& p_jobs, Jobs::JobCounter& p_counter);
+
+	/**
+	 * @brief Return the palette of an instance, written by the last Update.
+	 * @param p_instance The instance
+	 * @return PaletteBlockCount() blocks of 16 floats, ready for SetSkinningPose
+	 */
+	const float* Palette(const CrowdInstanceId p_instance) const;
+
+	/**
+	 * @brief Return the size of each palette in blocks of 16 floats.
+	 * @return The block count
+	 */
+	size_t PaletteBlockCount() const;
+
+	/**
+	 * @brief Return the memory held per instance, palette excluded.
+	 * @return The size in bytes
+	 */
+	static constexpr size_t InstanceStateSize()
+	{
+		return sizeof(ClipId) + sizeof(float) + sizeof(float) + sizeof(uint8_t);
+	}
+
+	/**
+	 * @brief Number of instances updated per job, enough to hide the cost of scheduling a job (about 4 us per instance).
+	 */
+	static constexpr size_t updateGrainSize = 16;
+
+private:
+	/**
+	 * @brief Poses of one instance, or of updateGrainSize instances when there are IK limbs, one after the other.
+	 */
+	struct Scratch final
+	{
+		std::vector<LocalPose> localPose;
+		std::vector<Matrix4F> worldPose;
+		std::vector<DualQuaternion> worldDualQuaternions;
+		std::vector<uint8_t> states;
+		TwoBoneIk ik;
+	};
+
+	/**
+	 * @brief Job updating a range of instances with the scratch of the thread running it.
+	 */
+	struct UpdateJob final
+	{
+		Crowd* crowd;
+
+		void operator()(const size_t p_begin, const size_t p_end) const;
+	};
+
+	void CheckClip(const ClipId p_clipId) const;
+	bool AdvanceInstance(const size_t p_instance);
+	void SampleInstance(const size_t p_instance, LocalPose* p_pose) const;
+	void SamplePose(const CrowdInstanceId p_instance, const size_t p_level, LocalPose* p_pose) const;
+	void ComputeWorldPose(const LocalPose* p_localPose, Matrix4F* p_worldPose, DualQuaternion* p_worldDualQuaternions) const;
+	void UpdateRange(const size_t p_begin, const size_t p_end, Scratch& p_scratch);
+	void ResizeScratch(const size_t p_threadCount);
+
+	std::shared_ptr<const Skeleton> m_skeleton;
+	const ClipRegistry& m_clips;
+	const std::vector<CompressedClip>* m_compressedClips{ nullptr };
+	const AnimationLod* m_lod{ nullptr };
+	SkinningPaletteMode m_paletteMode;
+	size_t m_paletteStride{ 0 };
+
+	std::vector<ClipId> m_clipIds{};
+	std::vector<float> m_times{};
+	std::vector<float> m_speedFactors{};
+
+	/**
+	 * @brief LOD level of every instance, with g_lodChangedBit set until it is evaluated at its new level.
+	 */
+	std::vector<uint8_t> m_lodLevels{};
+	std::vector<float> m_palettes{};
+
+	std::vector<IkChain> m_ikChains{};
+	std::vector<Vector3F> m_ikPoleOffsets{};
+
+	/**
+	 * @brief Target and weight of every IK limb of every instance, instance-major: [instance][limb].
+	 */
+	std::vector<Vector3F> m_ikTargets{};
+	std::vector<float> m_ikWeights{};
+
+	std::vector<Scratch> m_scratch{};
+	float m_deltaTime{ 0.0f };
+	float m_speed{ 0.0f };
+	uint32_t m_frameIndex{ 0 };
+	UpdateJob m_updateJob{ this };
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <GPM/GPM.h>
+
+/**
+ * @brief Unit dual quaternion holding a rotation and a translation in 8 floats.
+ * The real part is the rotation, the dual part is half the translation multiplied by the rotation. Both are stored x, y, z, w.
+ */
+struct DualQuaternion final
+{
+	Vector4F real{ 0.0f, 0.0f, 0.0f, 1.0f };
+	Vector4F dual{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+	/**
+	 * @brief Build a dual quaternion applying a rotation then a translation.
+	 * @param p_rotation The rotation, it must be normalized
+	 * @param p_translation The translation
+	 * @return The dual quaternion
+	 */
+	static DualQuaternion FromRotationTranslation(const QuaternionF& p_rotation, const Vector3F& p_translation);
+
+	/**
+	 * @brief Compose two rigid transforms, p_right being applied first like with matrices.
+	 * @param p_left The outer transform
+	 * @param p_right The inner transform
+	 * @return The composed dual quaternion
+	 */
+	static DualQuaternion Multiply(const DualQuaternion& p_left, const DualQuaternion& p_right);
+
+	/**
+	 * @brief Invert a unit dual quaternion by conjugating both of its parts.
+	 * @param p_dualQuaternion The dual quaternion to invert
+	 * @return The inverted dual quaternion
+	 */
+	static DualQuaternion InverseRigid(const DualQuaternion& p_dualQuaternion);
+
+	/**
+	 * @brief Return the translation of a unit dual quaternion.
+	 * @param p_dualQuaternion The dual quaternion
+	 * @return The translation
+	 */
+	static Vector3F Translation(const DualQuaternion& p_dualQuaternion);
+
+	/**
+	 * @brief Transform a point by a unit dual quaternion.
+	 * @param p_dualQuaternion The dual quaternion
+	 * @param p_point The point
+	 * @return The transformed point
+	 */
+	static Vector3F TransformPoint(const DualQuaternion& p_dualQuaternion, const Vector3F& p_point);
+
+	/**
+	 * @brief CPU reference of skinning_dq.vs: blend the palette entries of up to 4 bones, normalize the result then transform the point.
+	 * @param p_palette The skinning palette, one dual quaternion per bone
+	 * @param p_boneIndices The 4 bone indices of the vertex
+	 * @param p_boneWeights The 4 bone weights of the vertex
+	 * @param p_point The bind pose position of the vertex
+	 * @return The skinned position
+	 * @note Entries whose real part is on the other hemisphere than the first one are negated, so blending takes the shortest path.
+	 */
+	static Vector3F SkinPoint(const DualQuaternion* p_palette,
+		const int p_boneIndices[4],
+		const float p_boneWeights[4],
+		const Vector3F& p_point);
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <Animation/ClipRegistry.h>
+#include <Animation/AdditiveClip.h>
+#include <Animation/BoneMask.h>
+
+/**
+ * @brief Dense handle of a layer inside a LayerStack. Handles are given in the order the layers are added, starting at 0.
+ */
+using LayerId = uint32_t;
+
+/**
+ * @brief How a layer is combined with the pose below it.
+ */
+enum class LayerBlendMode
+{
+	/**
+	 * @brief The bones of the mask move towards the pose of the clip by the weight of the layer.
+	 */
+	Override,
+
+	/**
+	 * @brief The motion of the clip, relative to its first key, is added to the bones of the mask (AdditiveClip).
+	 */
+	Additive
+};
+
+/**
+ * @brief Layers evaluated in order on top of a base pose, each one playing a clip on the bones of its mask.
+ * A layer only samples and writes the bones of its mask, so it costs in proportion to them, and a layer of weight 0 is skipped.
+ */
+class LayerStack final
+{
+public:
+	/**
+	 * @brief Constructor, the stack starts empty.
+	 * @param p_clips The clips of the override layers, they must outlive the stack
+	 * @param p_additiveClips The additive copy of the clips, indexed by ClipId, built for the clips of additive layers only. It must outlive the stack.
+	 */
+	LayerStack(const ClipRegistry& p_clips, const std::vector<std::optional<AdditiveClip>>& p_additiveClips);
+
+	/**
+	 * @brief Default destructor
+	 */
+	~LayerStack() = default;
+
+	/**
+	 * @brief Add a layer on top of the others.
+	 * @param p_clipId The clip it plays, from its first key
+	 * @param p_mode How it is combined with the pose below it
+	 * @param p_mask The bones it affects
+	 * @param p_weight Its weight, between 0 and 1
+	 * @return The handle of the layer
+	 * @throw std::out_of_range if the clip isn't registered, has no key, or has no additive copy for an additive layer
+	 */
+	LayerId AddLayer(const ClipId p_clipId, const LayerBlendMode p_mode, const BoneMask& p_mask, const float p_weight = 1.0f);
+
+	/**
+	 * @brief Remove every layer.
+	 */
+	void Clear();
+
+	/**
+	 * @brief Return the number of layers.
+	 * @return The layer count
+	 */
+	size_t Count() const;
+
+	/**
+	 * @brief Set the weight of a layer.
+	 * @param p_layer The layer
+	 * @param p_weight The new weight, between 0 and 1
+	 */
+	void SetWeight(const LayerId p_layer, const float p_weight);
+
+	/**
+	 * @brief Return the weight of a layer.
+	 * @param p_layer The layer
+	 * @return The weight
+	 */
+	float Weight(const LayerId p_layer) const;
+
+	/**
+	 * @brief Return the bones a layer affects.
+	 * @param p_layer The layer
+	 * @return The mask
+	 */
+	const BoneMask& Mask(const LayerId p_layer) const;
+
+	/**
+	 * @brief Advance the time of every layer.
+	 * @param p_keyCount The time elapsed, in keys
+	 */
+	void Advance(const float p_keyCount);
+
+	/**
+	 * @brief Combine every layer, in order, with a pose.
+	 * @param p_pose The base pose, modified in place
+	 * @param p_boneCount The size of the pose
+	 */
+	void Apply(LocalPose* p_pose, const size_t p_boneCount);
+
+private:
+	struct Layer final
+	{
+		ClipId clipId;
+		LayerBlendMode mode;
+		BoneMask mask;
+		float weight;
+		float time;
+	};
+
+	const ClipRegistry& m_clips;
+	const std::vector<std::optional<AdditiveClip>>& m_additiveClips;
+	std::vector<Layer> m_layers{};
+
+	/**
+	 * @brief The pose sampled by each layer before being combined, only the bones of its mask are written.
+	 */
+	std::vector<LocalPose> m_scratch{};
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <GPM/GPM.h>
+
+/**
+ * @brief Animated transform of one bone, relative to its bind pose.
+ */
+struct LocalPose final
+{
+	Vector3F position{ 0.0f, 0.0f, 0.0f };
+	QuaternionF rotation{};
+};
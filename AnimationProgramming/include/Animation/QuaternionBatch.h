@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <Animation/LocalPose.h>
+
+/**
+ * @brief How a batch of rotations is interpolated.
+ */
+enum class QuaternionInterpolation
+{
+	/**
+	 * @brief Normalized lerp, exact at both keys and halfway but its speed is not constant.
+	 */
+	Nlerp,
+
+	/**
+	 * @brief Normalized lerp with a polynomial correction of the interpolation factor, close to slerp without any trigonometry.
+	 */
+	ApproximateSlerp
+};
+
+/**
+ * @brief Four read-only float streams holding the components of a set of quaternions, one element per quaternion.
+ */
+struct QuaternionStreams final
+{
+	const float* x;
+	const float* y;
+	const float* z;
+	const float* w;
+};
+
+/**
+ * @brief The two keys surrounding a time in a clip, as quaternion streams, and the interpolation factor between them.
+ */
+struct QuaternionSample final
+{
+	QuaternionStreams begin;
+	QuaternionStreams end;
+	float alpha;
+};
+
+/**
+ * @brief Interpolate many quaternion pairs, 4 pairs per SSE register (GPM_SIMD_SSE) or one at a time otherwise.
+ */
+class QuaternionBatch final
+{
+public:
+	QuaternionBatch() = delete;
+
+	/**
+	 * @brief Maximum angle in radians (about 0.05 degree) between the rotation given by ApproximateSlerp and the exact slerp, over every key pair and factor. It is reached for keys 180 degrees apart.
+	 */
+	static constexpr float approximateSlerpMaxError = 8.0e-4f;
+
+	/**
+	 * @brief Maximum angle in radians between the rotation given by Nlerp and the exact slerp when the keys are closer than nlerpFastPathCosine.
+	 */
+	static constexpr float nlerpFastPathMaxError = 3.5e-5f;
+
+	/**
+	 * @brief Cosine of the half angle between two keys above which ApproximateSlerp skips its correction, keys less than 11.5 degrees apart.
+	 */
+	static constexpr float nlerpFastPathCosine = 0.995f;
+
+	/**
+	 * @brief Interpolate p_count quaternion pairs and write the result in the rotation of each pose.
+	 * @param p_begin The start quaternions, they must be normalized
+	 * @param p_end The end quaternions, they must be normalized
+	 * @param p_alpha The interpolation factor between 0 and 1
+	 * @param p_pose The poses receiving the normalized rotations
+	 * @param p_count The number of pairs
+	 * @param p_mode The interpolation used
+	 * @note Each pair takes the shortest path. With ApproximateSlerp, a group of 4 pairs whose keys are all close enough is interpolated with Nlerp.
+	 */
+	static void Interpolate(const QuaternionStreams& p_begin,
+		const QuaternionStreams& p_end,
+		const float p_alpha,
+		LocalPose* p_pose,
+		const size_t p_count,
+		const QuaternionInterpolation p_mode = QuaternionInterpolation::ApproximateSlerp);
+
+	/**
+	 * @brief Interpolate p_count quaternion pairs, each with its own interpolation factor, and write the result in the rotation of each pose.
+	 * @param p_begin The start quaternions, they must be normalized
+	 * @param p_end The end quaternions, they must be normalized
+	 * @param p_alphas The interpolation factor of each pair, between 0 and 1
+	 * @param p_pose The poses receiving the normalized rotations
+	 * @param p_count The number of pairs
+	 * @param p_mode The interpolation used
+	 */
+	static void Interpolate(const QuaternionStreams& p_begin,
+		const QuaternionStreams& p_end,
+		const float* p_alphas,
+		LocalPose* p_pose,
+		const size_t p_count,
+		const QuaternionInterpolation p_mode = QuaternionInterpolation::ApproximateSlerp);
+
+	/**
+	 * @brief Interpolate p_count quaternion pairs of two clips, then blend the two results, in a single pass: each group of 4 rotations is read, interpolated twice and blended in registers.
+	 * The two interpolated rotations are not normalized before the blend, a nlerp normalized once. Keys of a pair are close, so they are almost unit length and weigh the blend the same.
+	 * @param p_source The key pairs of the clip faded out, their keys must be normalized
+	 * @param p_target The key pairs of the clip faded in, their keys must be normalized
+	 * @param p_weight The weight of the target, between 0 (source only) and 1 (target only)
+	 * @param p_pose The poses receiving the normalized rotations
+	 * @param p_count The number of pairs in each clip
+	 * @param p_mode The interpolation of the key pairs, the blend is always a nlerp
+	 */
+	static void InterpolateBlend(const QuaternionSample& p_source,
+		const QuaternionSample& p_target,
+		const float p_weight,
+		LocalPose* p_pose,
+		const size_t p_count,
+		const QuaternionInterpolation p_mode = QuaternionInterpolation::ApproximateSlerp);
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <Animation/AnimationInfo.h>
+#include <Animation/QuaternionBatch.h>
+#include <Animation/CompressedClip.h>
+
+class Skeleton;
+
+/**
+ * @brief Position of a sampler in the keys of each track of a ReducedClip, owned by the caller so that a clip can be shared.
+ * Consecutive samples at increasing times only move it forward; it is reset by itself when the time goes backward or the clip changes.
+ */
+struct ReducedClipCursor final
+{
+	/**
+	 * @brief Index of the first key of the current segment of each translation, respectively rotation, track.
+	 */
+	std::vector<uint32_t> translationKeys;
+	std::vector<uint32_t> rotationKeys;
+};
+
+/**
+ * @brief Copy of an AnimationInfo where each track only keeps the keys it can't rebuild by interpolating its neighbours.
+ * A key is removed when the world position of every bone, and of two virtual vertices attached to it, stays within an error budget
+ * on every frame it affects. Each track then has its own key times.
+ */
+class ReducedClip final
+{
+public:
+	/**
+	 * @brief Default largest distance between a world position sampled from the reduced clip and from its source.
+	 */
+	static constexpr float defaultErrorBudget = 0.01f;
+
+	/**
+	 * @brief Default distance from each bone of the virtual vertices measuring its rotation error, about the size of a skinned vertex offset.
+	 */
+	static constexpr float defaultVirtualVertexDistance = 3.0f;
+
+	/**
+	 * @brief Default constructor, an empty clip
+	 */
+	ReducedClip() = default;
+
+	/**
+	 * @brief Remove every key the error budget allows. Keys are removed greedily, parents first, the first and last key of each track are kept.
+	 * @param p_source The animation to reduce, its rotation keys must be normalized
+	 * @param p_skeleton The skeleton the animation plays on, the error is measured through its hierarchy
+	 * @param p_errorBudget The largest world distance allowed between the reduced and the source animation
+	 * @param p_virtualVertexDistance The distance from each bone of the vertices measuring its rotation error
+	 * @throw std::invalid_argument if the skeleton doesn't match the animation
+	 */
+	ReducedClip(const AnimationInfo& p_source,
+		const Skeleton& p_skeleton,
+		const float p_errorBudget = defaultErrorBudget,
+		const float p_virtualVertexDistance = defaultVirtualVertexDistance);
+
+	/**
+	 * @brief Default destructor
+	 */
+	~ReducedClip() = default;
+
+	/**
+	 * @brief Sample every bone of the clip at a given time. Same contract as AnimationInfo::SamplePose.
+	 * @param p_time The time in keys of the source animation, it wraps around its key count
+	 * @param p_cursor The cursor of the caller, moved to the segments containing p_time
+	 * @param p_pose The buffer receiving the local pose of each bone
+	 * @param p_boneCount The size of the buffer, only the first min(p_boneCount, BoneCount()) bones are written
+	 * @param p_interpolation The interpolation of the rotations
+	 * @throw std::out_of_range if the clip has no key
+	 */
+	void SamplePose(const float p_time, ReducedClipCursor& p_cursor, LocalPose* p_pose, const size_t p_boneCount,
+		const QuaternionInterpolation p_interpolation = QuaternionInterpolation::ApproximateSlerp) const;
+
+	/**
+	 * @brief Measure the error of the clip against the animation it was built from, on every key of the source.
+	 * @param p_source The animation given to the constructor
+	 * @param p_skeleton The skeleton given to the constructor
+	 * @return The report, the constant track counts are left to 0
+	 */
+	CompressionReport MeasureError(const AnimationInfo& p_source, const Skeleton& p_skeleton) const;
+
+	/**
+	 * @brief Return the key count of the source animation, the duration of the clip in keys.
+	 * @return The key count
+	 */
+	size_t KeyCount() const;
+
+	/**
+	 * @brief Return the bone count of the clip.
+	 * @return The bone count
+	 */
+	size_t BoneCount() const;
+
+	/**
+	 * @brief Return the number of keys kept over every translation and rotation track.
+	 * @return The stored key count
+	 */
+	size_t StoredKeyCount() const;
+
+	/**
+	 * @brief Return the memory used by the keys and their times.
+	 * @return The size in bytes
+	 */
+	size_t MemorySize() const;
+
+private:
+	size_t m_keyCount{ 0 };
+	size_t m_boneCount{ 0 };
+
+	/**
+	 * @brief Index of the first key of each translation, respectively rotation, track, plus the total key count: the keys of bone i are in [offsets[i], offsets[i + 1]).
+	 */
+	std::vector<uint32_t> m_translationOffsets;
+	std::vector<uint32_t> m_rotationOffsets;
+
+	/**
+	 * @brief Frame of the source animation of each kept key, increasing within a track.
+	 */
+	std::vector<uint16_t> m_translationTimes;
+	std::vector<uint16_t> m_rotationTimes;
+
+	std::vector<Vector3F> m_translations;
+	std::vector<QuaternionF> m_rotations;
+};
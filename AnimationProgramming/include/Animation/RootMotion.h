@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <GPM/GPM.h>
+#include <Animation/AnimationInfo.h>
+
+/**
+ * @brief Motion of the root bone of a looping clip, taken out of its pose at import.
+ * The displacement is stored summed from the first key, so that the displacement over any time interval, however many loops it spans,
+ * is read in O(1) without sampling the clip: characters are moved without evaluating their skeleton.
+ */
+class RootMotion final
+{
+public:
+	/**
+	 * @brief Constructor of a clip whose root doesn't move.
+	 */
+	RootMotion() = default;
+
+	/**
+	 * @brief Constructor from the displacements summed from the first key, as returned by Displacements.
+	 * @param p_displacements The displacement of the root from key 0 to every key, then to the end of the loop: key count + 1 values, the first one being zero
+	 * @throw std::invalid_argument if there are less than 2 values
+	 */
+	explicit RootMotion(std::vector<Vector3F> p_displacements);
+
+	/**
+	 * @brief Default destructor
+	 */
+	~RootMotion() = default;
+
+	/**
+	 * @brief Take the translation of the root bone out of a clip: the displacement between every key is stored, then every key of the root is set to the translation of the first key.
+	 * The rotation of the root is kept in the pose. The loop is closed by repeating the displacement of the last segment.
+	 * @param p_clip The clip, its keys must not be mapped
+	 * @param p_rootBone The bone carrying the motion, usually the root of the skeleton (bone 0)
+	 * @return The motion of the root, without motion if the clip has less than 2 keys
+	 * @throw std::out_of_range if the bone isn't in the clip
+	 * @throw std::logic_error if the keys of the clip are mapped
+	 */
+	static RootMotion Extract(AnimationInfo& p_clip, const size_t p_rootBone);
+
+	/**
+	 * @brief Return how far the root moves while the clip plays a number of keys, the keys being interpolated linearly like the pose.
+	 * @param p_time The time the interval starts at, in keys, it may be past the key count
+	 * @param p_keyCount The length of the interval, in keys, negative when playing backward
+	 * @return The displacement, in the space of the parent of the root
+	 */
+	Vector3F Displacement(const float p_time, const float p_keyCount) const;
+
+	/**
+	 * @brief Return how far the root moves over one loop of the clip.
+	 * @return The displacement, zero for a clip whose root doesn't move
+	 */
+	Vector3F LoopDisplacement() const;
+
+	/**
+	 * @brief Return the number of keys of the clip.
+	 * @return The key count, 0 for a clip whose root doesn't move
+	 */
+	size_t KeyCount() const;
+
+	/**
+	 * @brief Return the displacement of the root from key 0 to every key, then to the end of the loop.
+	 * @return Key count + 1 values, empty for a clip whose root doesn't move
+	 */
+	const std::vector<Vector3F>& Displacements() const;
+
+private:
+	/**
+	 * @brief Return the displacement from key 0 to a time of the first loop.
+	 * @param p_time The time, in [0, key count)
+	 * @return The displacement
+	 */
+	Vector3F LoopPosition(const float p_time) const;
+
+	std::vector<Vector3F> m_displacements{};
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <Resources/Skeleton.h>
+
+/**
+ * @brief Layout of the skinning palette sent to the vertex shader.
+ */
+enum class SkinningPaletteMode
+{
+	/**
+	 * @brief 16 floats per bone, read by skinning.vs as mat4.
+	 */
+	Matrix4x4,
+
+	/**
+	 * @brief 12 floats per bone (the 3 first rows, the last one being always 0, 0, 0, 1), read by skinning_affine.vs as 3 vec4.
+	 */
+	Affine3x4,
+
+	/**
+	 * @brief 8 floats per bone (rotation then dual part, both x, y, z, w), read by skinning_dq.vs as 2 vec4. The world pose is evaluated as dual quaternions, no matrix is built.
+	 */
+	DualQuaternion
+};
+
+/**
+ * @brief Build the skinning palette of a pose: the world transform of each bone multiplied by its inverse bind transform, in the layout of a palette mode.
+ */
+class SkinningPalette final
+{
+public:
+	SkinningPalette() = delete;
+
+	/**
+	 * @brief Return the number of floats written per bone.
+	 * @param p_mode The palette mode
+	 * @return 16, 12 or 8 floats
+	 */
+	static size_t FloatsPerBone(const SkinningPaletteMode p_mode);
+
+	/**
+	 * @brief Return the size of a palette in blocks of 16 floats, the unit of SetSkinningPose. The last block is padded.
+	 * @param p_mode The palette mode
+	 * @param p_boneCount The bone count
+	 * @return The block count
+	 */
+	static size_t BlockCount(const SkinningPaletteMode p_mode, const size_t p_boneCount);
+
+	/**
+	 * @brief Write the palette of a pose evaluated as matrices.
+	 * @param p_skeleton The skeleton of the pose
+	 * @param p_worldPose The world matrix of every bone
+	 * @param p_mode SkinningPaletteMode::Matrix4x4 or SkinningPaletteMode::Affine3x4
+	 * @param p_palette The palette, BoneCount() * FloatsPerBone(p_mode) floats
+	 */
+	static void Write(const Skeleton& p_skeleton, const Matrix4F* p_worldPose, const SkinningPaletteMode p_mode, float* p_palette);
+
+	/**
+	 * @brief Write the palette of a pose evaluated as dual quaternions, in the layout of SkinningPaletteMode::DualQuaternion.
+	 * @param p_skeleton The skeleton of the pose
+	 * @param p_worldPose The world dual quaternion of every bone
+	 * @param p_palette The palette, BoneCount() * 8 floats
+	 */
+	static void Write(const Skeleton& p_skeleton, const DualQuaternion* p_worldPose, float* p_palette);
+};
@@ -0,0 +1,176 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <GPM/GPM.h>
+#include <Resources/Skeleton.h>
+#include <Animation/LocalPose.h>
+#include <Animation/DualQuaternion.h>
+#include <Memory/AlignedAllocator.h>
+
+/**
+ * @brief The three bones of a limb solved by TwoBoneIk, for example thigh, calf and foot. The middle bone is a child of the upper one and the end bone a child of the middle one.
+ */
+struct IkChain final
+{
+	size_t upper;
+	size_t middle;
+	size_t end;
+};
+
+/**
+ * @brief Handle of a limb solved on a character, given in the order the limbs are added, starting at 0.
+ */
+using IkLimbId = uint32_t;
+
+/**
+ * @brief What a limb of one character is solved for: the position its end bone reaches, where its middle bone bends towards and how much of the solve is applied.
+ */
+struct IkGoal final
+{
+	Vector3F target;
+	Vector3F poleOffset;
+	float weight;
+};
+
+/**
+ * @brief Analytic two-bone IK solved for many limbs at once, on the evaluated poses of any number of characters.
+ * Each limb is read from the world pose of its character, the upper and middle bones are rotated so that the end bone reaches the target
+ * with the middle bone bending towards the pole, and the end bone keeps its world rotation. Only the local rotations of the 3 bones are written:
+ * the world pose of the character has to be computed again afterwards, which SolveCharacters does for the characters added with AddCharacter.
+ * The limbs are stored as one float stream per component and solved 4 at a time in SSE registers (GPM_SIMD_SSE), one at a time otherwise.
+ */
+class TwoBoneIk final
+{
+public:
+	/**
+	 * @brief Constructor, the batch starts empty.
+	 */
+	TwoBoneIk() = default;
+
+	/**
+	 * @brief Default destructor
+	 */
+	~TwoBoneIk() = default;
+
+	/**
+	 * @brief Return the chain ending at a bone: the bone, its parent and the parent of its parent.
+	 * @param p_skeleton The skeleton
+	 * @param p_endBone The end bone, for example foot_l or hand_l
+	 * @return The chain
+	 * @throw std::invalid_argument if the bone isn't in the skeleton or has less than 2 ancestors
+	 */
+	static IkChain FindChain(const Skeleton& p_skeleton, const size_t p_endBone);
+
+	/**
+	 * @brief Remove every limb and character, the memory is kept for the next batch.
+	 */
+	void Clear();
+
+	/**
+	 * @brief Add a limb to solve, from a world pose of matrices.
+	 * @param p_localPose The local pose of the character, the rotations of the chain are written by Solve. It must outlive the call to Solve.
+	 * @param p_worldPose The world pose computed from p_localPose, read here
+	 * @param p_chain The bones of the limb
+	 * @param p_target The position the end bone reaches, in the space of the world pose
+	 * @param p_poleOffset Where the middle bone bends towards, relative to its current position: zero keeps the bending plane of the pose
+	 * @param p_weight How far the end bone moves from its current position to the target, between 0 and 1
+	 */
+	void Add(LocalPose* p_localPose, const Matrix4F* p_worldPose, const IkChain& p_chain, const Vector3F& p_target, const Vector3F& p_poleOffset, const float p_weight = 1.0f);
+
+	/**
+	 * @brief Add a limb to solve, from a world pose of dual quaternions.
+	 * @param p_localPose The local pose of the character, the rotations of the chain are written by Solve. It must outlive the call to Solve.
+	 * @param p_worldPose The world pose computed from p_localPose, read here
+	 * @param p_chain The bones of the limb
+	 * @param p_target The position the end bone reaches, in the space of the world pose
+	 * @param p_poleOffset Where the middle bone bends towards, relative to its current position: zero keeps the bending plane of the pose
+	 * @param p_weight How far the end bone moves from its current position to the target, between 0 and 1
+	 */
+	void Add(LocalPose* p_localPose, const DualQuaternion* p_worldPose, const IkChain& p_chain, const Vector3F& p_target, const Vector3F& p_poleOffset, const float p_weight = 1.0f);
+
+	/**
+	 * @brief Add the limbs of one character that have a positive weight, read from the world pose its palette is written from.
+	 * @param p_skeleton The skeleton of the character, it must outlive the call to SolveCharacters
+	 * @param p_localPose The local pose of the character, the rotations of its limbs are written by SolveCharacters
+	 * @param p_worldPose The world matrices computed from p_localPose, read here when p_worldDualQuaternions is nullptr and computed again by SolveCharacters
+	 * @param p_worldDualQuaternions The world dual quaternions computed from p_localPose, nullptr to use the matrices
+	 * @param p_chains The limbs of the skeleton
+	 * @param p_goal Called as p_goal(limb) for every chain, returns the IkGoal of the limb on this character
+	 * @return True if a limb was added, false if every limb has a weight of 0 or less (the character is left out of the batch)
+	 */
+	template <typename GoalFunction>
+	bool AddCharacter(const Skeleton& p_skeleton, LocalPose* p_localPose, Matrix4F* p_worldPose, DualQuaternion* p_worldDualQuaternions, const std::vector<IkChain>& p_chains, const GoalFunction& p_goal);
+
+	/**
+	 * @brief Return the number of limbs added since the last Clear.
+	 * @return The limb count
+	 */
+	size_t Count() const;
+
+	/**
+	 * @brief Solve every limb and write the local rotations of their bones. A target out of reach is clamped to the length of the limb.
+	 * @note Every limb gives the same result whatever the other limbs of the batch.
+	 */
+	void Solve();
+
+	/**
+	 * @brief Solve every limb, then compute again the world pose of every character added with AddCharacter,
+	 * from the first bone of its limbs: the bones before it keep their world pose.
+	 */
+	void SolveCharacters();
+
+private:
+	/**
+	 * @brief Write one stream of the limb being added, at index Count().
+	 * @param p_stream The stream
+	 * @param p_value The value
+	 */
+	void WriteStream(const size_t p_stream, const float p_value);
+
+	/**
+	 * @brief Write the rows of the world rotation of a bone of the limb being added.
+	 * @param p_firstStream The stream of the first element of the rotation
+	 * @param p_rows The 3 rows of the rotation, 4 floats apart
+	 */
+	void WriteRotation(const size_t p_firstStream, const float* p_rows);
+
+	/**
+	 * @brief Write the local rotations, target, pole and weight of the limb being added, once its world positions and rotations are written, then add it.
+	 */
+	void AddLimb(LocalPose* p_localPose, const IkChain& p_chain, const Vector3F& p_target, const Vector3F& p_poleOffset, const float p_weight);
+
+	/**
+	 * @brief Make room for a number of limbs in every stream, keeping the limbs already added.
+	 * @param p_capacity The new capacity, a multiple of 4
+	 */
+	void Reserve(const size_t p_capacity);
+
+	struct Limb final
+	{
+		LocalPose* localPose;
+		IkChain chain;
+	};
+
+	struct Character final
+	{
+		const Skeleton* skeleton;
+		const LocalPose* localPose;
+		Matrix4F* worldPose;
+		DualQuaternion* worldDualQuaternions;
+		size_t firstBone;
+	};
+
+	std::vector<Limb> m_limbs{};
+	std::vector<Character> m_characters{};
+
+	/**
+	 * @brief Every stream of the limbs, stream-major: [stream][limb], m_streamStride floats per stream.
+	 */
+	std::vector<float, Memory::AlignedAllocator<float>> m_streams{};
+	size_t m_capacity{ 0 };
+	size_t m_streamStride{ 0 };
+};
+
+#include <Animation/TwoBoneIk.inl>
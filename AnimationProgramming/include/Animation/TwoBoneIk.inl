@@ -0,0 +1,28 @@
+#pragma once
+#include <algorithm>
+
+template <typename GoalFunction>
+bool TwoBoneIk::AddCharacter(const Skeleton& p_skeleton, LocalPose* p_localPose, Matrix4F* p_worldPose, DualQuaternion* p_worldDualQuaternions, const std::vector<IkChain>& p_chains, const GoalFunction& p_goal)
+{
+	size_t firstBone = p_skeleton.BoneCount();
+
+	for (size_t limb = 0; limb < p_chains.size(); ++limb)
+	{
+		const IkGoal goal = p_goal(limb);
+		if (goal.weight <= 0.0f)
+			continue;
+
+		firstBone = std::min(firstBone, p_chains[limb].upper);
+
+		if (p_worldDualQuaternions != nullptr)
+			Add(p_localPose, p_worldDualQuaternions, p_chains[limb], goal.target, goal.poleOffset, goal.weight);
+		else
+			Add(p_localPose, p_worldPose, p_chains[limb], goal.target, goal.poleOffset, goal.weight);
+	}
+
+	if (firstBone == p_skeleton.BoneCount())
+		return false;
+
+	m_characters.push_back({ &p_skeleton, p_localPose, p_worldPose, p_worldDualQuaternions, firstBone });
+	return true;
+}
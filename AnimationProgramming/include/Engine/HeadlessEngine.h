@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+	/**
+	 * @brief Script of a headless run, set before calling Run.
+	 */
+	struct HeadlessSettings final
+	{
+		/**
+		 * @brief Number of calls to ISimulation::Update.
+		 */
+		size_t frameCount{ 600 };
+
+		/**
+		 * @brief Time between 2 frames, used when no delta is recorded.
+		 */
+		float fixedDeltaTime{ 1.0f / 60.0f };
+
+		/**
+		 * @brief Times between 2 frames replayed in a loop instead of the fixed one, for instance captured from a real session.
+		 */
+		std::vector<float> recordedDeltaTimes{};
+
+		/**
+		 * @brief Directory of the resources, the clips are read from there by name.
+		 */
+		std::string resourcesDirectory{ "Resources/" };
+
+		/**
+		 * @brief Skeleton served by the GetSkeleton functions, relative to the resources directory.
+		 */
+		std::string skeletonName{ "ThirdPersonWalk.skel" };
+
+		/**
+		 * @brief Keep the palette of every frame in the report, not only the last one.
+		 */
+		bool capturePalettes{ false };
+	};
+
+	/**
+	 * @brief What a headless run measured and captured.
+	 */
+	struct HeadlessReport final
+	{
+		/**
+		 * @brief Duration of ISimulation::Init in milliseconds.
+		 */
+		double initDuration{ 0.0 };
+
+		/**
+		 * @brief Duration of each ISimulation::Update in microseconds.
+		 */
+		std::vector<float> frameDurations{};
+
+		/**
+		 * @brief Number of calls to DrawLine over the run.
+		 */
+		size_t drawLineCount{ 0 };
+
+		/**
+		 * @brief Number of calls to SetSkinningPose over the run.
+		 */
+		size_t skinningPoseCount{ 0 };
+
+		/**
+		 * @brief The last palette sent, 16 floats per block.
+		 */
+		std::vector<float> lastPalette{};
+
+		/**
+		 * @brief The palette of every frame one after the other, empty unless HeadlessSettings::capturePalettes is set.
+		 */
+		std::vector<float> palettes{};
+
+		/**
+		 * @brief Hash (FNV-1a, 64 bits) of every palette sent, two runs of the same script and code give the same value.
+		 */
+		uint64_t paletteHash{ 14695981039346656037ull };
+	};
+
+	/**
+	 * @brief Control of the headless implementation of Engine.h: no window, no GPU, the skeleton and the clips are read from the resources
+	 * and Run drives ISimulation::Update with scripted frame times. Palettes and debug lines are captured instead of drawn.
+	 */
+	class HeadlessEngine final
+	{
+	public:
+		HeadlessEngine() = delete;
+
+		/**
+		 * @brief Set the script of the next runs. The resources are read again on next use.
+		 * @param p_settings The script
+		 */
+		static void Configure(const HeadlessSettings& p_settings);
+
+		/**
+		 * @brief Return the report of the last run.
+		 * @return The report
+		 */
+		static const HeadlessReport& Report();
+	};
+}
@@ -13,7 +13,7 @@ namespace Input
 		/**
 		 * @brief Returns true if the key in parameter is currently pressed
 		 * @param p_key  The key to check
-		 * @return true of false
+		 * @return true of false, always false in the headless build
 		 */
 		static bool IsKeyPressed(const char p_key);
 
@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Jobs
+{
+	/**
+	 * @brief A range of work: a function called with the data it needs and the range [begin, end) to process.
+	 */
+	struct Job final
+	{
+		void (*function)(const void* p_data, size_t p_begin, size_t p_end){ nullptr };
+		const void* data{ nullptr };
+		size_t begin{ 0 };
+		size_t end{ 0 };
+	};
+
+	/**
+	 * @brief Count of the jobs dispatched with it and not finished yet. A counter is waited on with JobSystem::Wait, and jobs can be made to start only once it reaches 0.
+	 * @note A counter must not be dispatched with again before the jobs depending on it are started, nor destroyed before it is waited on.
+	 */
+	class JobCounter final
+	{
+	public:
+		/**
+		 * @brief Default constructor, no pending job
+		 */
+		JobCounter() = default;
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		/**
+		 * @brief Return true once every job dispatched with this counter is finished.
+		 * @return True if no job is pending
+		 */
+		bool IsDone() const;
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<size_t> m_pending{ 0 };
+		std::mutex m_mutex;
+		std::vector<std::pair<Job, JobCounter*>> m_continuations;
+		std::exception_ptr m_exception;
+	};
+
+	/**
+	 * @brief Work-stealing scheduler. Each thread owns a deque of jobs: it pushes and pops at the back (most recent first, still in cache),
+	 * and idle threads steal from the front of the others (the oldest, usually the largest remaining work).
+	 * Jobs are dispatched from the thread that created the system or from jobs, the creating thread runs jobs too while it waits.
+	 */
+	class JobSystem final
+	{
+	public:
+		/**
+		 * @brief Start the worker threads.
+		 * @param p_threadCount The number of threads running jobs, the creating thread included. 0 uses one per hardware thread, 1 runs every job on the creating thread.
+		 */
+		explicit JobSystem(const size_t p_threadCount = 0);
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/**
+		 * @brief Stop the worker threads once they are idle. Every counter must have been waited on.
+		 */
+		~JobSystem();
+
+		/**
+		 * @brief Return the number of threads running jobs, the creating thread included.
+		 * @return The thread count
+		 */
+		size_t ThreadCount() const;
+
+		/**
+		 * @brief Return the index of the calling thread, to pick per-thread scratch data in a job.
+		 * @return An index lower than ThreadCount(), 0 for the creating thread
+		 */
+		static size_t ThreadIndex();
+
+		/**
+		 * @brief Queue a job on the calling thread.
+		 * @param p_job The job
+		 * @param p_counter The counter incremented now and decremented when the job is finished
+		 * @param p_dependency A counter the job waits for, nullptr to start it as soon as possible
+		 */
+		void Dispatch(const Job& p_job, JobCounter& p_counter, JobCounter* p_dependency = nullptr);
+
+		/**
+		 * @brief Split a range in jobs of p_grainSize elements and queue them, without waiting.
+		 * @param p_count The number of elements
+		 * @param p_grainSize The number of elements per job, at least 1
+		 * @param p_function Called as p_function(begin, end) on each part of the range, it must outlive the jobs
+		 * @param p_counter The counter of the jobs
+		 * @param p_dependency A counter the jobs wait for, nullptr to start them as soon as possible
+		 */
+		template <typename Function>
+		void DispatchRange(const size_t p_count, const size_t p_grainSize, const Function& p_function, JobCounter& p_counter, JobCounter* p_dependency = nullptr);
+
+		/**
+		 * @brief Call a function on every part of a range, in parallel, and return once all of them are done.
+		 * @param p_count The number of elements
+		 * @param p_grainSize The number of elements per job, at least 1
+		 * @param p_function Called as p_function(begin, end) on each part of the range
+		 * @throw The first exception thrown by p_function
+		 */
+		template <typename Function>
+		void ParallelFor(const size_t p_count, const size_t p_grainSize, const Function& p_function);
+
+		/**
+		 * @brief Run jobs until every job of a counter is finished.
+		 * @param p_counter The counter
+		 * @throw The first exception thrown by a job of the counter
+		 */
+		void Wait(JobCounter& p_counter);
+
+	private:
+		struct QueuedJob final
+		{
+			Job job;
+			JobCounter* counter;
+		};
+
+		struct WorkerQueue final
+		{
+			std::mutex mutex;
+			std::deque<QueuedJob> jobs;
+		};
+
+		void Push(const QueuedJob& p_job);
+		bool TryRunJob(const size_t p_threadIndex);
+		void Finish(JobCounter& p_counter);
+		void WorkerLoop(const size_t p_threadIndex);
+
+		std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+		std::vector<std::thread> m_threads;
+		std::atomic<size_t> m_queuedJobCount{ 0 };
+		std::atomic<bool> m_stopping{ false };
+
+		/**
+		 * @brief Number of workers waiting on m_wake, changed under m_wakeMutex. Push only takes the mutex when one of them sleeps.
+		 */
+		std::atomic<size_t> m_sleepingCount{ 0 };
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wake;
+	};
+}
+
+#include <Jobs/JobSystem.inl>
@@ -0,0 +1,34 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+
+template <typename Function>
+void Jobs::JobSystem::DispatchRange(const size_t p_count, const size_t p_grainSize, const Function& p_function, JobCounter& p_counter, JobCounter* p_dependency)
+{
+	if (p_grainSize == 0)
+		throw std::invalid_argument("Jobs can't be dispatched, the grain size is 0");
+
+	Job job;
+	job.data = &p_function;
+	job.function = [](const void* p_data, const size_t p_begin, const size_t p_end)
+	{
+		(*static_cast<const Function*>(p_data))(p_begin, p_end);
+	};
+
+	// Pushed last part first: the calling thread pops the first part, thieves take the last ones
+	const size_t jobCount = (p_count + p_grainSize - 1) / p_grainSize;
+	for (size_t i = jobCount; i-- > 0;)
+	{
+		job.begin = i * p_grainSize;
+		job.end = std::min(p_count, job.begin + p_grainSize);
+		Dispatch(job, p_counter, p_dependency);
+	}
+}
+
+template <typename Function>
+void Jobs::JobSystem::ParallelFor(const size_t p_count, const size_t p_grainSize, const Function& p_function)
+{
+	JobCounter counter;
+	DispatchRange(p_count, p_grainSize, p_function, counter);
+	Wait(counter);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+namespace Memory
+{
+	/**
+	 * @brief Standard allocator returning memory aligned on Alignment bytes, so containers can be read with SIMD loads.
+	 * @tparam T The type to allocate
+	 * @tparam Alignment The alignment in bytes, must be a power of two
+	 */
+	template<typename T, size_t Alignment = 32>
+	class AlignedAllocator
+	{
+	public:
+		using value_type = T;
+
+		template<typename U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, Alignment>;
+		};
+
+		AlignedAllocator() noexcept = default;
+
+		template<typename U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+		/**
+		 * @brief Allocate an aligned block able to hold p_count elements.
+		 * @param p_count The number of elements
+		 * @return The aligned block
+		 */
+		T* allocate(const size_t p_count)
+		{
+			return static_cast<T*>(::operator new(p_count * sizeof(T), std::align_val_t{ Alignment }));
+		}
+
+		/**
+		 * @brief Release a block previously returned by allocate.
+		 * @param p_pointer The block
+		 */
+		void deallocate(T* p_pointer, size_t) noexcept
+		{
+			::operator delete(p_pointer, std::align_val_t{ Alignment });
+		}
+
+		template<typename U>
+		bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+		template<typename U>
+		bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+	};
+}
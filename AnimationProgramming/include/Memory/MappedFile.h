@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace Memory
+{
+	/**
+	 * @brief Read-only memory mapping of a whole file. The content is paged in by the OS on first access, nothing is copied.
+	 */
+	class MappedFile final
+	{
+	public:
+		/**
+		 * @brief Default constructor, no file mapped
+		 */
+		MappedFile() = default;
+
+		/**
+		 * @brief Map a file.
+		 * @param p_path The path of the file
+		 * @throw std::runtime_error if the file can't be opened or mapped
+		 */
+		explicit MappedFile(const std::string& p_path);
+
+		MappedFile(const MappedFile&) = delete;
+
+		/**
+		 * @brief Move constructor
+		 * @param p_other The mapping to take over
+		 */
+		MappedFile(MappedFile&& p_other) noexcept;
+
+		/**
+		 * @brief Unmap the file
+		 */
+		~MappedFile();
+
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/**
+		 * @brief Move assignment operator, the current mapping is released
+		 * @param p_other The mapping to take over
+		 * @return The modified mapping
+		 */
+		MappedFile& operator=(MappedFile&& p_other) noexcept;
+
+		/**
+		 * @brief Return the first byte of the file, aligned on a page.
+		 * @return The mapped content, nullptr if no file is mapped
+		 */
+		const std::byte* Data() const;
+
+		/**
+		 * @brief Return the size of the file.
+		 * @return The size in bytes
+		 */
+		size_t Size() const;
+
+		/**
+		 * @brief Unmap the file, if any.
+		 */
+		void Close();
+
+	private:
+		const std::byte* m_data{ nullptr };
+		size_t m_size{ 0 };
+
+#if defined(_WIN32)
+		void* m_file{ nullptr };
+		void* m_mapping{ nullptr };
+#endif
+	};
+}
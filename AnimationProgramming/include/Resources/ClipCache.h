@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <Animation/ClipRegistry.h>
+#include <Animation/ClipCycle.h>
+#include <Animation/RootMotion.h>
+#include <Memory/MappedFile.h>
+
+/**
+ * @brief Binary file holding the keys of every clip of a registry, baked in the layout of AnimationInfo so that they are used in place once mapped.
+ * The file starts with a header (magic, version, hash of the source files, clip and bone count), then one entry per clip (name, key count, offsets),
+ * then the keys of each clip aligned on 32 bytes, each followed by the root motion taken out of them and by the cycle computed from them.
+ */
+class ClipCache final
+{
+public:
+	/**
+	 * @brief Version of the file layout, a cache written by another version is ignored.
+	 */
+	static constexpr uint32_t version = 3;
+
+	/**
+	 * @brief Default constructor, no cache loaded
+	 */
+	ClipCache() = default;
+
+	/**
+	 * @brief Default destructor, the keys of the loaded cache are unmapped
+	 */
+	~ClipCache() = default;
+
+	/**
+	 * @brief Hash the content of the files the clips are imported from (FNV-1a, 64 bits).
+	 * @param p_paths The paths of the files
+	 * @return The hash, empty if a file can't be read
+	 */
+	static std::optional<uint64_t> HashSources(const std::vector<std::string>& p_paths);
+
+	/**
+	 * @brief Write the keys, the root motion and the cycle of every clip of a registry. The file is written next to its destination then renamed, a failed write never leaves a truncated cache.
+	 * @param p_path The path of the cache
+	 * @param p_sourceHash The hash of the source files, given by HashSources
+	 * @param p_clips The clips, they must all have the same bone count
+	 * @param p_rootMotions The root motion of every clip, indexed by ClipId
+	 * @param p_cycles The cycle of every clip, indexed by ClipId
+	 * @throw std::runtime_error if the file can't be written or a clip has no root motion or no cycle
+	 */
+	static void Save(const std::string& p_path, const uint64_t p_sourceHash, const ClipRegistry& p_clips, const std::vector<RootMotion>& p_rootMotions, const std::vector<ClipCycle>& p_cycles);
+
+	/**
+	 * @brief Map a cache and point every clip of a registry to its keys, nothing is copied nor parsed. The root motions, a few floats per key, and the cycles are copied.
+	 * @param p_path The path of the cache
+	 * @param p_sourceHash The hash of the current source files
+	 * @param p_clips The clips, with their key and bone count already set
+	 * @param p_rootMotions Receives the root motion of every clip, indexed by ClipId
+	 * @param p_cycles Receives the cycle of every clip, indexed by ClipId
+	 * @return True if the cache is up to date and every clip is mapped, false if it is missing, stale or doesn't match the registry (the clips, root motions and cycles are left untouched)
+	 * @note The clips read the mapping: this cache must outlive them or the next Load.
+	 */
+	bool Load(const std::string& p_path, const uint64_t p_sourceHash, ClipRegistry& p_clips, std::vector<RootMotion>& p_rootMotions, std::vector<ClipCycle>& p_cycles);
+
+private:
+	Memory::MappedFile m_file;
+};
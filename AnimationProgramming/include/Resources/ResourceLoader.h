@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <Resources/Skeleton.h>
+#include <Animation/AnimationInfo.h>
+
+/**
+ * @brief Reader of the binary skeletons (.skel) and clips (.anim) of Data/Resources, without going through the engine.
+ * Both formats are little-endian. A .skel holds the bone count, then each bone (name length, name, index, parent index), then the local bind transform of each bone
+ * (position, rotation as w, x, y, z, scale). A .anim holds the duration, the track count, then one track per bone of the .skel, in the order of its indices:
+ * the key count, then if there are keys a reserved word and the keys in the layout of the bind transforms.
+ */
+class ResourceLoader final
+{
+public:
+	ResourceLoader() = delete;
+
+	/**
+	 * @brief Read a skeleton. Bones whose name contains "ik" are skipped, like the engine import does, and parents are validated to come before their children.
+	 * @param p_path The path of the .skel
+	 * @param p_fileBoneIndices Receive, for each bone of the skeleton, its index in the file. It is the track of the bone in the clips of this skeleton.
+	 * @return The skeleton
+	 * @note The bind scale is read but ignored, the skeletons having no scale.
+	 * @throw std::runtime_error if the file can't be read or is truncated
+	 * @throw std::invalid_argument if a bone has a parent that is not part of the skeleton
+	 */
+	static Skeleton LoadSkeleton(const std::string& p_path, std::vector<int>& p_fileBoneIndices);
+
+	/**
+	 * @brief Return the key count of a clip, the one of its longest track. Only the track headers are read, the keys are skipped.
+	 * @param p_path The path of the .anim
+	 * @return The key count
+	 * @throw std::runtime_error if the file can't be read or is truncated
+	 */
+	static size_t ReadAnimationKeyCount(const std::string& p_path);
+
+	/**
+	 * @brief Read the keys of a clip in a single pass, straight into an animation. A track without keys stays at the bind pose, a shorter track holds its last key.
+	 * @param p_path The path of the .anim
+	 * @param p_fileBoneIndices The file index of each bone, given by LoadSkeleton
+	 * @param p_animation The animation, its key and bone count already set (ReadAnimationKeyCount and the bone count of the skeleton)
+	 * @throw std::runtime_error if the file can't be read, is truncated or has more keys than the animation
+	 */
+	static void LoadAnimation(const std::string& p_path, const std::vector<int>& p_fileBoneIndices, AnimationInfo& p_animation);
+};
@@ -0,0 +1,125 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <GPM/GPM.h>
+#include <Animation/LocalPose.h>
+#include <Animation/DualQuaternion.h>
+
+/**
+ * @brief Immutable description of a skeleton stored as parallel arrays indexed by bone.
+ * Bones are kept in topological order: the parent of a bone always comes before it, so a single forward loop computes every world transform.
+ * A skeleton is built once per asset then shared read-only (std::shared_ptr<const Skeleton>) by every character using it.
+ */
+class Skeleton final
+{
+public:
+	/**
+	 * @brief Default constructor
+	 */
+	Skeleton() = default;
+
+	/**
+	 * @brief Default destructor
+	 */
+	~Skeleton() = default;
+
+	/**
+	 * @brief Append a bone to the skeleton.
+	 * @param p_name The name of the bone
+	 * @param p_parentIndex The index of the parent bone, -1 for a root. It must be lower than the index of the new bone.
+	 * @param p_bindPosition The local position of the bone at T pose
+	 * @param p_bindRotation The local rotation of the bone at T pose
+	 * @return The index of the new bone
+	 * @note The inverse bind matrix and dual quaternion are computed here with a rigid inverse, bind poses having no scale.
+	 * @throw std::invalid_argument if the parent isn't already in the skeleton
+	 */
+	size_t AddBone(const std::string_view& p_name,
+		const int p_parentIndex,
+		const Vector3F& p_bindPosition,
+		const QuaternionF& p_bindRotation);
+
+	/**
+	 * @brief Compute the animated world matrix of every bone in one forward pass.
+	 * @param p_localPose The local pose of each bone, relative to its bind pose
+	 * @param p_worldPose The buffer receiving the world matrix of each bone
+	 * @param p_firstBone The first bone computed, the bones before it keep the world matrix already in p_worldPose. Used once the local pose of that bone and of some bones after it changed.
+	 * @note Both buffers must hold BoneCount() elements.
+	 */
+	void ComputeWorldPose(const LocalPose* p_localPose, Matrix4F* p_worldPose, const size_t p_firstBone = 0) const;
+
+	/**
+	 * @brief Compute the animated world rotation and translation of every bone in one forward pass, without building any matrix.
+	 * @param p_localPose The local pose of each bone, relative to its bind pose
+	 * @param p_worldPose The buffer receiving the world dual quaternion of each bone
+	 * @param p_firstBone The first bone computed, the bones before it keep the world dual quaternion already in p_worldPose. Used once the local pose of that bone and of some bones after it changed.
+	 * @note Both buffers must hold BoneCount() elements.
+	 */
+	void ComputeWorldPose(const LocalPose* p_localPose, DualQuaternion* p_worldPose, const size_t p_firstBone = 0) const;
+
+	/**
+	 * @brief Return the bone count of the skeleton.
+	 * @return The bone count
+	 */
+	size_t BoneCount() const;
+
+	/**
+	 * @brief Return the index of the parent of a bone.
+	 * @param p_boneIndex The bone
+	 * @return The parent index, -1 if the bone is a root
+	 */
+	int ParentIndex(const size_t p_boneIndex) const;
+
+	/**
+	 * @brief Return the name of a bone.
+	 * @param p_boneIndex The bone
+	 * @return The name
+	 */
+	const std::string& BoneName(const size_t p_boneIndex) const;
+
+	/**
+	 * @brief Return the index of a bone from its name.
+	 * @param p_boneName The name of the bone
+	 * @return An optional holding the index if the bone exists, empty otherwise
+	 */
+	std::optional<size_t> BoneIndex(const std::string_view& p_boneName) const;
+
+	/**
+	 * @brief Return the local T pose matrix of a bone.
+	 * @param p_boneIndex The bone
+	 * @return The local T pose matrix
+	 */
+	const Matrix4F& LocalBindMatrix(const size_t p_boneIndex) const;
+
+	/**
+	 * @brief Return the inverted world T pose matrix of a bone.
+	 * @param p_boneIndex The bone
+	 * @return The inverted world T pose matrix
+	 */
+	const Matrix4F& InverseBindMatrix(const size_t p_boneIndex) const;
+
+	/**
+	 * @brief Return the local T pose of a bone as a dual quaternion.
+	 * @param p_boneIndex The bone
+	 * @return The local T pose dual quaternion
+	 */
+	const DualQuaternion& LocalBindDualQuaternion(const size_t p_boneIndex) const;
+
+	/**
+	 * @brief Return the inverted world T pose of a bone as a dual quaternion.
+	 * @param p_boneIndex The bone
+	 * @return The inverted world T pose dual quaternion
+	 */
+	const DualQuaternion& InverseBindDualQuaternion(const size_t p_boneIndex) const;
+
+private:
+	std::vector<int> m_parentIndices;
+	std::vector<std::string> m_names;
+	std::vector<Matrix4F> m_localBindMatrices;
+	std::vector<Matrix4F> m_worldBindMatrices;
+	std::vector<Matrix4F> m_inverseBindMatrices;
+	std::vector<DualQuaternion> m_localBindDualQuaternions;
+	std::vector<DualQuaternion> m_worldBindDualQuaternions;
+	std::vector<DualQuaternion> m_inverseBindDualQuaternions;
+};
@@ -0,0 +1,62 @@
+#include <Animation/AdditiveClip.h>
+#include <algorithm>
+#include <stdexcept>
+
+AdditiveClip::AdditiveClip(const AnimationInfo& p_clip, const size_t p_referenceKey)
+	: m_referenceKey{ p_referenceKey }
+{
+	if (p_referenceKey >= p_clip.KeyCount())
+		throw std::out_of_range("Additive clip can't be created, the reference key is out of range");
+
+	m_deltas.SetKeyCount(p_clip.KeyCount());
+	m_deltas.SetBoneCount(p_clip.BoneCount());
+
+	for (size_t bone = 0; bone < p_clip.BoneCount(); ++bone)
+	{
+		const auto [referencePosition, referenceRotation] = p_clip.LocalAnimFrame(bone, p_referenceKey);
+
+		for (size_t key = 0; key < p_clip.KeyCount(); ++key)
+		{
+			const auto [position, rotation] = p_clip.LocalAnimFrame(bone, key);
+
+			// Conjugate of the reference times the key, on the hemisphere of w >= 0 so that weighting it from identity takes the short way
+			const QuaternionF delta = QuaternionF::Conjugate(referenceRotation) * rotation;
+
+			m_deltas.UpdateAnimFrame(bone, key,
+				Vector3F{ position.x - referencePosition.x, position.y - referencePosition.y, position.z - referencePosition.z },
+				delta.w < 0.0f ? delta * -1.0f : delta);
+		}
+	}
+}
+
+void AdditiveClip::Apply(const float p_time, const BoneMask& p_mask, const float p_weight, LocalPose* p_pose, LocalPose* p_scratch, const size_t p_boneCount) const
+{
+	const size_t boneCount = std::min(p_boneCount, m_deltas.BoneCount());
+	m_deltas.SamplePose(p_time, p_mask, p_scratch, boneCount, QuaternionInterpolation::Nlerp);
+
+	p_mask.ForEachRange([&](const size_t p_begin, const size_t p_end)
+	{
+		for (size_t i = p_begin; i < std::min(p_end, boneCount); ++i)
+		{
+			const LocalPose& delta = p_scratch[i];
+			LocalPose& pose = p_pose[i];
+
+			pose.position.x += delta.position.x * p_weight;
+			pose.position.y += delta.position.y * p_weight;
+			pose.position.z += delta.position.z * p_weight;
+
+			// Delta weighted from identity (the delta is on the hemisphere of w >= 0), applied after the rotation of the pose
+			pose.rotation *= QuaternionF::Nlerp(QuaternionF{}, delta.rotation, p_weight);
+		}
+	});
+}
+
+const AnimationInfo& AdditiveClip::Deltas() const
+{
+	return m_deltas;
+}
+
+size_t AdditiveClip::ReferenceKey() const
+{
+	return m_referenceKey;
+}
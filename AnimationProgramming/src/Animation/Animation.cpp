@@ -1,25 +1,99 @@
 #include <Animation/Animation.h>
 #include <iostream>
+#include <algorithm>
 #include <utility>
+#include <cstring>
+#include <stdexcept>
+#include <chrono>
+#include <cmath>
+#include <fstream>
 #include <GPM/GPM.h>
 #include <Input/InputManager.h>
+#include <Resources/ResourceLoader.h>
+
+namespace
+{
+	/**
+	 * @brief Bone whose translation is taken out of the clips as root motion, the root of the skeleton.
+	 */
+	constexpr size_t g_rootMotionBone = 0;
+
+	/**
+	 * @brief Return the path of the skeleton a clip is authored for, the .skel next to its .anim.
+	 * @param p_clipName The name of the clip
+	 * @return The path of the .skel
+	 */
+	std::string SkeletonSourceFile(const std::string& p_clipName)
+	{
+		return RESOURCES_DIRECTORY + p_clipName.substr(0, p_clipName.rfind('.')) + ".skel";
+	}
+
+	/**
+	 * @brief Return the files the clips of a registry are imported from: the .anim of each clip and the .skel next to it.
+	 * @param p_clips The clips
+	 * @return The paths of the files
+	 */
+	std::vector<std::string> ClipSourceFiles(const ClipRegistry& p_clips)
+	{
+		std::vector<std::string> paths;
+
+		for (ClipId clip = 0; clip < p_clips.Count(); ++clip)
+		{
+			paths.push_back(RESOURCES_DIRECTORY + p_clips.Name(clip));
+			paths.push_back(SkeletonSourceFile(p_clips.Name(clip)));
+		}
+
+		return paths;
+	}
+}
 
 CSimulation::CSimulation(std::string p_defaultAnimationName)
-	: m_speedAnimation{ 10.0f }, m_animationName{ std::move(p_defaultAnimationName) }
+	: m_speedAnimation{ 10.0f }
 {
-	m_animationTransforms[RUN_ANIM] = AnimationInfo{};
-	m_animationTransforms[WALK_ANIM] = AnimationInfo{};
+	m_runClip = m_clips.Register(RUN_ANIM);
+	m_walkClip = m_clips.Register(WALK_ANIM);
+	m_currentClip = m_clips.Register(p_defaultAnimationName);
 }
 
 void CSimulation::PopulateBonesArray()
 {
-	m_animationTransforms[RUN_ANIM].SetKeyCount(GetAnimKeyCount(RUN_ANIM));
-	m_animationTransforms[WALK_ANIM].SetKeyCount(GetAnimKeyCount(WALK_ANIM));
+	const std::string skeletonPath = SkeletonSourceFile(m_clips.Name(m_currentClip));
+	m_importFromResources = std::ifstream(skeletonPath, std::ios::binary).good();
+
+	if (m_importFromResources)
+	{
+		m_skeleton = std::make_shared<const Skeleton>(ResourceLoader::LoadSkeleton(skeletonPath, m_engineBoneIndices));
+
+		for (ClipId clip = 0; clip < m_clips.Count(); ++clip)
+			m_clips.Clip(clip).SetKeyCount(ResourceLoader::ReadAnimationKeyCount(RESOURCES_DIRECTORY + m_clips.Name(clip)));
+	}
+	else
+	{
+		PopulateBonesArrayFromEngine();
+	}
+
+	const size_t boneCount = m_skeleton->BoneCount();
+
+	for (ClipId clip = 0; clip < m_clips.Count(); ++clip)
+		m_clips.Clip(clip).SetBoneCount(boneCount);
+
+	m_skinningAnimationMatrices.resize(boneCount * 16);
+	m_localPose.resize(boneCount);
+	m_worldPose.resize(boneCount);
+	m_worldDualQuaternions.resize(boneCount);
+}
+
+void CSimulation::PopulateBonesArrayFromEngine()
+{
+	for (ClipId clip = 0; clip < m_clips.Count(); ++clip)
+		m_clips.Clip(clip).SetKeyCount(GetAnimKeyCount(m_clips.Name(clip).c_str()));
 
 	const size_t maxBones = GetSkeletonBoneCount();
 	Vector3F temporaryPosition{};
 	Vector4F temporaryQuaternion{};
-	int boneIndex = 0;
+	std::vector<int> skeletonBoneIndices(maxBones, -1);
+	Skeleton skeleton;
+	m_engineBoneIndices.clear();
 
 	for (size_t i = 0; i < maxBones; ++i)
 	{
@@ -27,12 +101,11 @@ void CSimulation::PopulateBonesArray()
 		if (std::strstr(boneName, "ik") != nullptr)
 			continue;
 
-		boneIndex++;
-
-		m_bones.emplace_back();
+		const int engineParentIndex = GetSkeletonBoneParentIndex(static_cast<int>(i));
+		const int parentIndex = engineParentIndex == -1 ? -1 : skeletonBoneIndices[engineParentIndex];
 
-		m_bones[i].name = boneName;
-		m_bones[i].parentIndex = GetSkeletonBoneParentIndex(static_cast<int>(i));
+		if (engineParentIndex != -1 && parentIndex == -1)
+			throw std::invalid_argument(std::string("Bone ") + boneName + " has a parent that is not part of the skeleton");
 
 		GetSkeletonBoneLocalBindTransform(
 			static_cast<int>(i),
@@ -44,59 +117,80 @@ void CSimulation::PopulateBonesArray()
 			temporaryQuaternion.y,
 			temporaryQuaternion.z);
 
-		m_bones[i].transform.SetTTransform(
+		skeletonBoneIndices[i] = static_cast<int>(skeleton.AddBone(
+			boneName,
+			parentIndex,
 			temporaryPosition,
-			Quaternion{ temporaryQuaternion.x , temporaryQuaternion.y, temporaryQuaternion.z, temporaryQuaternion.w });
+			QuaternionF{ temporaryQuaternion.x , temporaryQuaternion.y, temporaryQuaternion.z, temporaryQuaternion.w }));
+		m_engineBoneIndices.push_back(static_cast<int>(i));
 	}
 
-	m_animationTransforms[RUN_ANIM].SetBoneCount(boneIndex);
-	m_animationTransforms[WALK_ANIM].SetBoneCount(boneIndex);
-	m_keyAnimKeyCount = m_animationTransforms[m_animationName].KeyCount();
-
-	m_skinningAnimationMatrices.resize(m_animationTransforms[m_animationName].BoneCount() * 16);
+	m_skeleton = std::make_shared<const Skeleton>(std::move(skeleton));
 }
 
-void CSimulation::LinkBones()
+void CSimulation::ShowBonesData()
 {
-	for (auto& bone : m_bones)
+	for (size_t i = 0; i < m_skeleton->BoneCount(); ++i)
 	{
-		bone.parent = (bone.parentIndex == -1) ? nullptr : &m_bones[bone.parentIndex];
+		const int parentIndex = m_skeleton->ParentIndex(i);
 
-		if (bone.parent != nullptr)
-		{
-			bone.transform.SetParent(bone.parent->transform);
-			bone.parent->children.push_back(&bone);
-		}
+		std::cout << "--------------------\n" << m_skeleton->BoneName(i)
+			<< "\tParent: " << (parentIndex == -1 ? "none" : m_skeleton->BoneName(parentIndex))
+			<< "\tIndex of parent: " << parentIndex << "\n-------------------";
 	}
+}
 
-	for (auto& bone : m_bones)
+void CSimulation::ShowCompressionReport()
+{
+	const auto showReport = [](const std::string& p_name, const char* p_storage, const CompressionReport& p_report)
+	{
+		std::cout << "--------------------\n" << p_name << " (" << p_storage << ")"
+			<< "\tKeys: " << p_report.sourceMemorySize << " bytes -> " << p_report.compressedMemorySize << " bytes"
+			<< "\tConstant tracks: " << p_report.constantTranslationTrackCount << " translations, " << p_report.constantRotationTrackCount << " rotations"
+			<< "\tMax local translation error: " << p_report.maxLocalTranslationError
+			<< "\tMax local rotation error: " << p_report.maxLocalRotationError << " rad"
+			<< "\tMax world position error: " << p_report.maxWorldPositionError << "\n-------------------";
+	};
+
+	if (m_compressedClips.empty())
+		BuildCompressedClips();
+
+	for (ClipId clip = 0; clip < m_compressedClips.size(); ++clip)
+		showReport(m_clips.Name(clip), "compressed", m_compressedClips[clip].MeasureError(m_clips.Clip(clip), *m_skeleton));
+
+	if (m_reducedClips.empty())
+		BuildReducedClips();
+
+	for (ClipId clip = 0; clip < m_reducedClips.size(); ++clip)
 	{
-		bone.transform.InitSkeleton();
+		showReport(m_clips.Name(clip), "reduced", m_reducedClips[clip].MeasureError(m_clips.Clip(clip), *m_skeleton));
+		std::cout << "\tStored keys: " << m_reducedClips[clip].StoredKeyCount()
+			<< " / " << m_reducedClips[clip].KeyCount() * m_reducedClips[clip].BoneCount() * 2 << "\n";
 	}
 }
 
-void CSimulation::ShowBonesData()
+void CSimulation::PopulateAnimation(const ClipId p_clipId)
 {
-	for (auto& bone : m_bones)
+	AnimationInfo& animation = m_clips.Clip(p_clipId);
+
+	if (m_importFromResources)
 	{
-		std::cout << "--------------------\n" << bone.name
-			<< "\tParent: " << std::hex << bone.parent
-			<< "\tIndex of parent: " << bone.parentIndex << "\n-------------------";
+		ResourceLoader::LoadAnimation(RESOURCES_DIRECTORY + m_clips.Name(p_clipId), m_engineBoneIndices, animation);
+		return;
 	}
-}
 
-void CSimulation::PopulateAnimation(const std::string_view& p_animationName)
-{
-	const size_t boneCount = m_animationTransforms[p_animationName.data()].BoneCount();
+	const char* animationName = m_clips.Name(p_clipId).c_str();
+	const size_t boneCount = animation.BoneCount();
+	const size_t keyCount = animation.KeyCount();
 	Vector3F temporaryPosition{};
 	Vector4F temporaryQuaternion;
 
 	for (size_t i = 0; i < boneCount; ++i)
 	{
-		for (size_t j = 0; j < m_animationTransforms[p_animationName.data()].KeyCount(); ++j)
+		for (size_t j = 0; j < keyCount; ++j)
 		{
-			GetAnimLocalBoneTransform(p_animationName.data(),
-				static_cast<int>(i),
+			GetAnimLocalBoneTransform(animationName,
+				m_engineBoneIndices[i],
 				static_cast<int>(j),
 				temporaryPosition.x,
 				temporaryPosition.y,
@@ -106,89 +200,234 @@ void CSimulation::PopulateAnimation(const std::string_view& p_animationName)
 				temporaryQuaternion.y,
 				temporaryQuaternion.z);
 
-			m_animationTransforms[p_animationName.data()].AddAnimFrame(
+			animation.AddAnimFrame(
 				i,
 				temporaryPosition,
-				Quaternion{ temporaryQuaternion.x, temporaryQuaternion.y, temporaryQuaternion.z, temporaryQuaternion.w });
+				QuaternionF{ temporaryQuaternion.x, temporaryQuaternion.y, temporaryQuaternion.z, temporaryQuaternion.w });
 		}
 	}
 }
 
-std::optional<Bone*> CSimulation::GetBoneFromName(const std::string_view& p_boneName)
+std::optional<size_t> CSimulation::GetBoneFromName(const std::string_view& p_boneName) const
 {
-	for (auto& bone : m_bones)
-	{
-		if (p_boneName == bone.name)
-			return &bone;
-	}
-
-	return {};
+	return m_skeleton->BoneIndex(p_boneName);
 }
 
 void CSimulation::Init()
 {
+	const auto importStart = std::chrono::steady_clock::now();
+
 	PopulateBonesArray();
 
-	LinkBones();
+	const std::optional<uint64_t> sourceHash = ClipCache::HashSources(ClipSourceFiles(m_clips));
+	const bool cached = sourceHash.has_value() && m_clipCache.Load(CLIP_CACHE_PATH, sourceHash.value(), m_clips, m_rootMotions, m_clipCycles);
+
+	if (!cached)
+	{
+		// The root motion is taken out of the keys before they are cached, the cache holds the keys without it
+		m_rootMotions.clear();
+		for (ClipId clip = 0; clip < m_clips.Count(); ++clip)
+		{
+			PopulateAnimation(clip);
+			m_rootMotions.push_back(RootMotion::Extract(m_clips.Clip(clip), g_rootMotionBone));
+		}
+
+		BuildClipCycles();
+
+		if (sourceHash.has_value())
+		{
+			try
+			{
+				ClipCache::Save(CLIP_CACHE_PATH, sourceHash.value(), m_clips, m_rootMotions, m_clipCycles);
+			}
+			catch (const std::runtime_error& p_exception)
+			{
+				// The cache only speeds up the next start
+				std::cerr << p_exception.what() << '\n';
+			}
+		}
+	}
+
+	m_compressedClips.clear();
+	m_reducedClips.clear();
+	if (m_clipStorage != ClipStorage::Keys)
+		BuildCompressedClips();
+	if (m_clipStorage == ClipStorage::Reduced)
+		BuildReducedClips();
+
+	m_rootPosition = Vector3F{ 0.0f, 0.0f, 0.0f };
 
-	PopulateAnimation(WALK_ANIM);
-	PopulateAnimation(RUN_ANIM);
+	AddLocomotionClips();
+
+	// The additive copies are built by the additive layers that use them
+	m_additiveClips.clear();
+	m_additiveClips.resize(m_clips.Count());
+
+	// The layers are added again on the new skeleton
+	m_layers.Clear();
+	for (size_t layer = 0; layer < m_layerSettings.size(); ++layer)
+		AddLayerToStack(layer);
+
+	if (m_locomotionSpeed.has_value())
+		StartLocomotion();
+
+	const std::chrono::duration<float, std::milli> importDuration = std::chrono::steady_clock::now() - importStart;
+	m_clipImportReport = { cached ? ClipSource::Cache : m_importFromResources ? ClipSource::Resources : ClipSource::Engine, importDuration.count() };
+
+	// The crowd is spawned again on the new skeleton, with levels of detail built for it
+	m_crowdLod.reset();
+	if (m_crowdLodEnabled)
+	{
+		m_crowdLod = std::make_unique<AnimationLod>(AnimationLod::CreateDefault(*m_skeleton));
+		m_crowdLod->BuildClips(m_clips);
+	}
+
+	m_crowd.reset();
+
+	// The IK limbs are found again on the new skeleton, the crowd gets them when it is spawned
+	m_ikChains.clear();
+	for (size_t limb = 0; limb < m_ikLimbSettings.size(); ++limb)
+		AddIkLimbToSkeleton(limb);
+
+	SetCrowdSize(m_crowdSize);
 
 	//ShowBonesData();
+	//ShowCompressionReport();
 }
 
-void CSimulation::DrawSkeleton()
+void CSimulation::BuildCompressedClips()
 {
-	for (unsigned int i = 0; i < m_bones.size(); ++i)
+	m_compressedClips.clear();
+	for (ClipId clip = 0; clip < m_clips.Count(); ++clip)
+		m_compressedClips.emplace_back(m_clips.Clip(clip));
+}
+
+void CSimulation::BuildReducedClips()
+{
+	m_reducedClips.clear();
+	for (ClipId clip = 0; clip < m_clips.Count(); ++clip)
+		m_reducedClips.emplace_back(m_clips.Clip(clip), *m_skeleton);
+}
+
+void CSimulation::BuildClipCycles()
+{
+	const std::optional<size_t> leftThigh = GetBoneFromName("thigh_l");
+	const std::optional<size_t> rightThigh = GetBoneFromName("thigh_r");
+	const std::optional<size_t> leftFoot = GetBoneFromName("foot_l");
+	const std::optional<size_t> rightFoot = GetBoneFromName("foot_r");
+	const bool hasLegs = leftThigh.has_value() && rightThigh.has_value() && leftFoot.has_value() && rightFoot.has_value();
+
+	m_clipCycles.clear();
+
+	for (ClipId clip = 0; clip < m_clips.Count(); ++clip)
 	{
-		Bone* parent = m_bones[i].parent;
-		if (parent == nullptr)
-			continue;
+		if (hasLegs && (clip == m_walkClip || clip == m_runClip))
+			m_clipCycles.emplace_back(m_clips.Clip(clip), *m_skeleton, GaitBones{ leftThigh.value(), rightThigh.value(), leftFoot.value(), rightFoot.value() });
+		else
+			m_clipCycles.emplace_back(m_clips.Clip(clip));
+	}
+}
+
+void CSimulation::AddLocomotionClips()
+{
+	m_locomotion.Clear();
 
-		std::pair<Vector3F, Quaternion> beginLocalFrame;
-		std::pair<Vector3F, Quaternion> endLocalFrame;
+	// Only the walk and the run get a gait, and so a stride, when the skeleton has legs
+	for (ClipId clip = 0; clip < m_clipCycles.size(); ++clip)
+	{
+		if ((clip == m_walkClip || clip == m_runClip) && m_clipCycles[clip].StrideLength() > 0.0f)
+			m_locomotion.AddClip(clip, m_clipCycles[clip]);
+	}
+}
+
+const ClipCycle& CSimulation::GetClipCycle(const ClipId p_clipId) const
+{
+	return m_clipCycles[p_clipId];
+}
 
-		const int beginFrame = static_cast<int>(static_cast<size_t>(m_animationElapsedTime) % m_keyAnimKeyCount);
-		const int endFrame = static_cast<int>(static_cast<size_t>(m_animationElapsedTime + 1.0f) % m_keyAnimKeyCount);
+const RootMotion& CSimulation::GetRootMotion(const ClipId p_clipId) const
+{
+	return m_rootMotions[p_clipId];
+}
 
-		beginLocalFrame = m_animationTransforms[m_animationName].LocalAnimFrame(i, beginFrame);
-		endLocalFrame = m_animationTransforms[m_animationName].LocalAnimFrame(i, endFrame);
+Vector3F CSimulation::RootPosition() const
+{
+	return m_rootPosition;
+}
 
-		Vector3F interpolatedPosition = Vector3F::Lerp(
-			beginLocalFrame.first,
-			endLocalFrame.first,
-			Tools::Utils::GetDecimalPart(m_animationElapsedTime));
+void CSimulation::EvaluatePose()
+{
+	if (m_locomotionSpeed.has_value())
+		m_locomotion.SamplePose(m_localPose.data(), m_localPose.size());
+	else if (IsCrossfading())
+		SampleCrossfade();
+	else if (m_clipStorage == ClipStorage::Compressed && m_currentClip < m_compressedClips.size())
+		m_compressedClips[m_currentClip].SamplePose(m_animationElapsedTime, m_localPose.data(), m_localPose.size());
+	else if (m_clipStorage == ClipStorage::Reduced && m_currentClip < m_reducedClips.size())
+		m_reducedClips[m_currentClip].SamplePose(m_animationElapsedTime, m_reducedClipCursor, m_localPose.data(), m_localPose.size());
+	else
+		m_clips.Clip(m_currentClip).SamplePose(m_animationElapsedTime, m_localPose.data(), m_localPose.size());
+
+	m_layers.Apply(m_localPose.data(), m_localPose.size());
+	ComputeWorldPose();
+
+	DualQuaternion* worldDualQuaternions = m_paletteMode == SkinningPaletteMode::DualQuaternion ? m_worldDualQuaternions.data() : nullptr;
+
+	m_ik.Clear();
+	m_ik.AddCharacter(*m_skeleton, m_localPose.data(), m_worldPose.data(), worldDualQuaternions, m_ikChains, [this](const size_t p_limb) { return m_ikLimbSettings[p_limb].goal; });
+	m_ik.SolveCharacters();
+}
 
-		Quaternion interpolatedRotation = Quaternion::SlerpShortestPath(
-			beginLocalFrame.second,
-			endLocalFrame.second,
-			Tools::Utils::GetDecimalPart(m_animationElapsedTime));
+void CSimulation::ComputeWorldPose()
+{
+	if (m_paletteMode == SkinningPaletteMode::DualQuaternion)
+		m_skeleton->ComputeWorldPose(m_localPose.data(), m_worldDualQuaternions.data());
+	else
+		m_skeleton->ComputeWorldPose(m_localPose.data(), m_worldPose.data());
+}
 
-		m_bones[i].transform.SetAnimTransform(interpolatedPosition, interpolatedRotation);
+void CSimulation::DrawSkeleton()
+{
+	for (size_t i = 0; i < m_skeleton->BoneCount(); ++i)
+	{
+		const int parentIndex = m_skeleton->ParentIndex(i);
+		if (parentIndex == -1)
+			continue;
 
-		const Vector3F parentAnimPosition = parent->transform.WorldAnimPosition();
-		const Vector3F boneAnimPosition = m_bones[i].transform.WorldAnimPosition();
+		const Vector3F parentPosition = BoneWorldPosition(parentIndex);
+		const Vector3F bonePosition = BoneWorldPosition(i);
 
 		DrawLine(
-			parentAnimPosition.x, parentAnimPosition.y - 15.0f, parentAnimPosition.z,
-			boneAnimPosition.x, boneAnimPosition.y - 15.0f, boneAnimPosition.z,
+			parentPosition.x, parentPosition.y - 15.0f, parentPosition.z,
+			bonePosition.x, bonePosition.y - 15.0f, bonePosition.z,
 			0.6f, 0.4f, 0.0f);
 	}
 }
 
+Vector3F CSimulation::BoneWorldPosition(const size_t p_boneIndex) const
+{
+	if (m_paletteMode == SkinningPaletteMode::DualQuaternion)
+		return DualQuaternion::Translation(m_worldDualQuaternions[p_boneIndex]);
+
+	const float* worldMatrix = m_worldPose[p_boneIndex].m_data;
+	return Vector3F{ worldMatrix[3], worldMatrix[7], worldMatrix[11] };
+}
+
 void CSimulation::ChangeAnimation(const float p_deltaTime)
 {
 	if (Input::InputManager::IsKeyPressed('R'))
 	{
-		m_animationName = RUN_ANIM;
-		m_animationElapsedTime = 0.0f;
-		m_keyAnimKeyCount = m_animationTransforms[m_animationName].KeyCount();
+		if (m_locomotionSpeed.has_value())
+			SetLocomotionSpeed(m_locomotion.ClipSpeed(m_runClip, m_speedAnimation));
+		else
+			CrossfadeTo(m_runClip, m_crossfadeDuration);
 	}
 	else if (Input::InputManager::IsKeyPressed('Z'))
 	{
-		m_animationName = WALK_ANIM;
-		m_animationElapsedTime = 0.0f;
-		m_keyAnimKeyCount = m_animationTransforms[m_animationName].KeyCount();
+		if (m_locomotionSpeed.has_value())
+			SetLocomotionSpeed(m_locomotion.ClipSpeed(m_walkClip, m_speedAnimation));
+		else
+			CrossfadeTo(m_walkClip, m_crossfadeDuration);
 	}
 	else if (Input::InputManager::IsKeyPressed('1'))
 	{
@@ -208,23 +447,465 @@ void CSimulation::ChangeAnimation(const float p_deltaTime)
 	}
 	else if (Input::InputManager::IsKeyPressed('B'))
 	{
-		// Toggle bones
+		// Toggle bones, once per key press
+		if (!m_debugDrawKeyHeld)
+			SetDebugDraw(!IsDebugDrawEnabled());
+
+		m_debugDrawKeyHeld = true;
+		return;
+	}
+	else if (Input::InputManager::IsKeyPressed('L'))
+	{
+		// Toggle locomotion, once per key press, starting at the speed of the clip played
+		if (!m_locomotionKeyHeld && m_locomotionSpeed.has_value())
+		{
+			SetLocomotionSpeed(std::nullopt);
+		}
+		else if (!m_locomotionKeyHeld && m_locomotion.ClipCount() != 0)
+		{
+			const ClipId clip = m_locomotion.HasClip(m_currentClip) ? m_currentClip : m_walkClip;
+			SetLocomotionSpeed(m_locomotion.ClipSpeed(clip, m_speedAnimation));
+		}
+
+		m_locomotionKeyHeld = true;
+		return;
 	}
+
+	m_debugDrawKeyHeld = false;
+	m_locomotionKeyHeld = false;
+}
+
+void CSimulation::PlayAnimation(const ClipId p_clipId)
+{
+	m_currentClip = p_clipId;
+	m_animationElapsedTime = 0.0f;
+	m_fadeDuration = 0.0f;
+	m_locomotionSpeed.reset();
+}
+
+void CSimulation::CrossfadeTo(const ClipId p_clipId, const float p_duration)
+{
+	if (p_clipId == m_currentClip)
+		return;
+
+	const float currentKeyCount = static_cast<float>(m_clips.Clip(m_currentClip).KeyCount());
+	const float targetKeyCount = static_cast<float>(m_clips.Clip(p_clipId).KeyCount());
+	if (currentKeyCount == 0.0f || targetKeyCount == 0.0f)
+		throw std::out_of_range("Crossfade impossible, one of the animations has no key");
+
+	// Normalized time in the cycle, carried over to the animation faded in
+	float phase = std::fmod(m_animationElapsedTime, currentKeyCount) / currentKeyCount;
+	if (phase < 0.0f)
+		phase += 1.0f;
+
+	// Fading back mirrors the progress of the fade, so the weight of the animation faded in doesn't jump (the smoothstep is symmetric)
+	const bool fadingBack = IsCrossfading() && p_clipId == m_fadeSourceClip;
+	const float progress = fadingBack ? 1.0f - m_fadeElapsedTime / m_fadeDuration : 0.0f;
+
+	m_fadeSourceClip = m_currentClip;
+	m_currentClip = p_clipId;
+	m_animationElapsedTime = phase * targetKeyCount;
+	m_fadeDuration = std::max(p_duration, 0.0f);
+	m_fadeElapsedTime = progress * m_fadeDuration;
+}
+
+bool CSimulation::IsCrossfading() const
+{
+	return m_fadeDuration > 0.0f;
 }
 
-void CSimulation::FormatHardwareSkinning()
+float CSimulation::CrossfadeWeight() const
 {
-	for (size_t i = 0; i < m_bones.size(); i++)
+	if (!IsCrossfading())
+		return 1.0f;
+
+	const float progress = std::clamp(m_fadeElapsedTime / m_fadeDuration, 0.0f, 1.0f);
+	return progress * progress * (3.0f - 2.0f * progress);
+}
+
+void CSimulation::SetCrossfadeDuration(const float p_duration)
+{
+	m_crossfadeDuration = p_duration;
+}
+
+float CSimulation::CrossfadeDuration() const
+{
+	return m_crossfadeDuration;
+}
+
+void CSimulation::AdvanceAnimation(const float p_deltaTime)
+{
+	m_layers.Advance(p_deltaTime * m_speedAnimation * m_animationFactorSpeed);
+
+	if (m_locomotionSpeed.has_value())
+	{
+		// Exponential ease with a time constant of 0.2 second, independent of the frame rate
+		m_currentLocomotionSpeed += (m_locomotionSpeed.value() - m_currentLocomotionSpeed) * (1.0f - std::exp(-p_deltaTime / 0.2f));
+		m_locomotion.Update(p_deltaTime, m_currentLocomotionSpeed * m_animationFactorSpeed, m_speedAnimation);
+		return;
+	}
+
+	const float keysPerSecond = m_speedAnimation * m_animationFactorSpeed;
+
+	if (!IsCrossfading())
 	{
-		const Matrix4F animatedMatrix = m_bones[i].transform.WorldAnimMatrix() * m_bones[i].transform.InverseWorldMatrix();
+		const Vector3F displacement = m_rootMotions[m_currentClip].Displacement(m_animationElapsedTime, p_deltaTime * keysPerSecond);
+		m_rootPosition = Vector3F{ m_rootPosition.x + displacement.x, m_rootPosition.y + displacement.y, m_rootPosition.z + displacement.z };
+
+		m_animationElapsedTime += p_deltaTime * keysPerSecond;
+		return;
+	}
+
+	// The blended cycle is as long as the weighted cycles of both animations, in keys of the animation faded in
+	const float sourceKeyCount = static_cast<float>(m_clips.Clip(m_fadeSourceClip).KeyCount());
+	const float targetKeyCount = static_cast<float>(m_clips.Clip(m_currentClip).KeyCount());
+	const float cycleKeyCount = sourceKeyCount + (targetKeyCount - sourceKeyCount) * CrossfadeWeight();
+	const float targetKeys = p_deltaTime * keysPerSecond * targetKeyCount / cycleKeyCount;
+
+	// Both clips play at the same phase, their root motions are blended like their poses
+	const float sourceTime = m_animationElapsedTime * sourceKeyCount / targetKeyCount;
+	const Vector3F sourceDisplacement = m_rootMotions[m_fadeSourceClip].Displacement(sourceTime, targetKeys * sourceKeyCount / targetKeyCount);
+	const Vector3F targetDisplacement = m_rootMotions[m_currentClip].Displacement(m_animationElapsedTime, targetKeys);
+	const float weight = CrossfadeWeight();
+
+	m_rootPosition = Vector3F{ m_rootPosition.x + sourceDisplacement.x + (targetDisplacement.x - sourceDisplacement.x) * weight,
+		m_rootPosition.y + sourceDisplacement.y + (targetDisplacement.y - sourceDisplacement.y) * weight,
+		m_rootPosition.z + sourceDisplacement.z + (targetDisplacement.z - sourceDisplacement.z) * weight };
 
-		for (int j = 0; j < 16; j++)
+	m_animationElapsedTime += targetKeys;
+	m_fadeElapsedTime += p_deltaTime;
+
+	if (m_fadeElapsedTime >= m_fadeDuration)
+		m_fadeDuration = 0.0f;
+}
+
+void CSimulation::SampleCrossfade()
+{
+	const float sourceKeyCount = static_cast<float>(m_clips.Clip(m_fadeSourceClip).KeyCount());
+	const float targetKeyCount = static_cast<float>(m_clips.Clip(m_currentClip).KeyCount());
+
+	float phase = std::fmod(m_animationElapsedTime, targetKeyCount) / targetKeyCount;
+	if (phase < 0.0f)
+		phase += 1.0f;
+
+	const float sourceTime = phase * sourceKeyCount;
+
+	// The float keys are bone-indexed streams in both clips, they are read and blended in one pass whatever the clip storage
+	m_clips.Clip(m_fadeSourceClip).SampleBlendedPose(sourceTime, m_clips.Clip(m_currentClip), m_animationElapsedTime, CrossfadeWeight(),
+		m_localPose.data(), m_localPose.size());
+}
+
+void CSimulation::SetLocomotionSpeed(const std::optional<float> p_speed)
+{
+	const bool starting = p_speed.has_value() && !m_locomotionSpeed.has_value();
+	const bool stopping = !p_speed.has_value() && m_locomotionSpeed.has_value();
+
+	if (stopping && !m_clipCycles.empty())
+	{
+		m_currentClip = m_locomotion.DominantClip();
+		m_animationElapsedTime = m_locomotion.ClipTime(m_currentClip);
+	}
+
+	m_locomotionSpeed = p_speed;
+
+	// Before Init, locomotion starts once the cycles are computed
+	if (starting && !m_clipCycles.empty())
+		StartLocomotion();
+}
+
+std::optional<float> CSimulation::LocomotionSpeed() const
+{
+	return m_locomotionSpeed;
+}
+
+const BlendSpace1D& CSimulation::GetLocomotion() const
+{
+	return m_locomotion;
+}
+
+void CSimulation::StartLocomotion()
+{
+	if (m_locomotion.ClipCount() == 0)
+	{
+		m_locomotionSpeed.reset();
+		throw std::logic_error("Locomotion can't start, the walk and the run have no stride");
+	}
+
+	// The blend space starts from the pose of the current clip, at the speed the character moves with it
+	m_locomotion.SetPhase(GetClipCycle(m_currentClip).SyncPhase(m_animationElapsedTime));
+	m_currentLocomotionSpeed = m_locomotion.HasClip(m_currentClip)
+		? m_locomotion.ClipSpeed(m_currentClip, m_speedAnimation)
+		: m_locomotionSpeed.value();
+	m_fadeDuration = 0.0f;
+}
+
+LayerId CSimulation::AddLayer(const std::string_view& p_clipName, const LayerBlendMode p_mode, const std::string_view& p_rootBoneName, const float p_weight)
+{
+	const std::optional<ClipId> clip = m_clips.Find(p_clipName);
+	if (!clip.has_value())
+		throw std::invalid_argument("Layer can't be added, " + std::string(p_clipName) + " isn't registered");
+
+	m_layerSettings.push_back({ clip.value(), p_mode, std::string(p_rootBoneName), p_weight });
+
+	if (m_skeleton != nullptr)
+	{
+		try
+		{
+			AddLayerToStack(m_layerSettings.size() - 1);
+		}
+		catch (...)
 		{
-			m_skinningAnimationMatrices[i * 16 + j] = animatedMatrix[j];
+			m_layerSettings.pop_back();
+			throw;
 		}
 	}
 
-	SetSkinningPose(m_skinningAnimationMatrices.data(), m_bones.size());
+	return static_cast<LayerId>(m_layerSettings.size() - 1);
+}
+
+void CSimulation::SetLayerWeight(const LayerId p_layer, const float p_weight)
+{
+	m_layerSettings[p_layer].weight = p_weight;
+
+	if (p_layer < m_layers.Count())
+		m_layers.SetWeight(p_layer, p_weight);
+}
+
+void CSimulation::ClearLayers()
+{
+	m_layerSettings.clear();
+	m_layers.Clear();
+}
+
+const LayerStack& CSimulation::GetLayers() const
+{
+	return m_layers;
+}
+
+void CSimulation::AddLayerToStack(const size_t p_settingsIndex)
+{
+	const LayerSettings& settings = m_layerSettings[p_settingsIndex];
+	const std::optional<size_t> rootBone = GetBoneFromName(settings.rootBoneName);
+	if (!rootBone.has_value())
+		throw std::invalid_argument("Layer can't be added, the bone " + settings.rootBoneName + " isn't in the skeleton");
+
+	if (settings.mode == LayerBlendMode::Additive)
+	{
+		if (m_additiveClips.size() <= settings.clipId)
+			m_additiveClips.resize(settings.clipId + 1);
+		if (!m_additiveClips[settings.clipId].has_value())
+			m_additiveClips[settings.clipId].emplace(m_clips.Clip(settings.clipId));
+	}
+
+	m_layers.AddLayer(settings.clipId, settings.mode, BoneMask::FromSubtree(*m_skeleton, rootBone.value()), settings.weight);
+}
+
+IkLimbId CSimulation::AddIkLimb(const std::string_view& p_endBoneName, const Vector3F& p_poleOffset)
+{
+	m_ikLimbSettings.push_back({ std::string(p_endBoneName), IkGoal{ Vector3F{ 0.0f, 0.0f, 0.0f }, p_poleOffset, 0.0f } });
+
+	if (m_skeleton != nullptr)
+	{
+		try
+		{
+			AddIkLimbToSkeleton(m_ikLimbSettings.size() - 1);
+		}
+		catch (...)
+		{
+			m_ikLimbSettings.pop_back();
+			throw;
+		}
+	}
+
+	return static_cast<IkLimbId>(m_ikLimbSettings.size() - 1);
+}
+
+void CSimulation::SetIkTarget(const IkLimbId p_limb, const Vector3F& p_target, const float p_weight)
+{
+	m_ikLimbSettings[p_limb].goal.target = p_target;
+	m_ikLimbSettings[p_limb].goal.weight = p_weight;
+}
+
+void CSimulation::SetCrowdIkTarget(const CrowdInstanceId p_instance, const IkLimbId p_limb, const Vector3F& p_target, const float p_weight)
+{
+	if (m_crowd == nullptr)
+		throw std::logic_error("Crowd IK target can't be set, the crowd isn't spawned");
+
+	m_crowd->SetIkTarget(p_instance, p_limb, p_target, p_weight);
+}
+
+void CSimulation::ClearIkLimbs()
+{
+	m_ikLimbSettings.clear();
+	m_ikChains.clear();
+
+	if (m_crowd != nullptr)
+		m_crowd->ClearIkLimbs();
+}
+
+void CSimulation::AddIkLimbToSkeleton(const size_t p_settingsIndex)
+{
+	const IkLimbSettings& settings = m_ikLimbSettings[p_settingsIndex];
+	const std::optional<size_t> endBone = GetBoneFromName(settings.endBoneName);
+	if (!endBone.has_value())
+		throw std::invalid_argument("IK limb can't be added, the bone " + settings.endBoneName + " isn't in the skeleton");
+
+	m_ikChains.push_back(TwoBoneIk::FindChain(*m_skeleton, endBone.value()));
+
+	if (m_crowd != nullptr)
+		m_crowd->AddIkLimb(m_ikChains.back(), settings.goal.poleOffset);
+}
+
+void CSimulation::WriteSkinningPalette()
+{
+	if (m_paletteMode == SkinningPaletteMode::DualQuaternion)
+		SkinningPalette::Write(*m_skeleton, m_worldDualQuaternions.data(), m_skinningAnimationMatrices.data());
+	else
+		SkinningPalette::Write(*m_skeleton, m_worldPose.data(), m_paletteMode, m_skinningAnimationMatrices.data());
+}
+
+void CSimulation::SetSkinningPaletteMode(const SkinningPaletteMode p_mode)
+{
+	m_paletteMode = p_mode;
+
+	if (m_crowd != nullptr)
+		m_crowd->SetPaletteMode(p_mode);
+}
+
+SkinningPaletteMode CSimulation::GetSkinningPaletteMode() const
+{
+	return m_paletteMode;
+}
+
+void CSimulation::SetClipStorage(const ClipStorage p_storage)
+{
+	// Before Init, the clips are built by Init with the keys
+	if (m_skeleton != nullptr)
+	{
+		if (p_storage != ClipStorage::Keys && m_compressedClips.empty())
+			BuildCompressedClips();
+		if (p_storage == ClipStorage::Reduced && m_reducedClips.empty())
+			BuildReducedClips();
+	}
+
+	m_clipStorage = p_storage;
+
+	// The crowd has no cursor per instance to sample the reduced clips, it samples the compressed ones instead
+	if (m_crowd != nullptr)
+		m_crowd->SetCompressedClips(m_clipStorage == ClipStorage::Keys ? nullptr : &m_compressedClips);
+}
+
+void CSimulation::SetCrowdSize(const size_t p_count)
+{
+	m_crowdSize = p_count;
+
+	if (m_skeleton == nullptr)
+		return;
+
+	if (m_crowdSize == 0)
+	{
+		m_crowd.reset();
+		return;
+	}
+
+	if (m_crowd == nullptr)
+	{
+		m_crowd = std::make_unique<Crowd>(m_skeleton, m_clips, m_paletteMode);
+
+		for (size_t limb = 0; limb < m_ikChains.size(); ++limb)
+			m_crowd->AddIkLimb(m_ikChains[limb], m_ikLimbSettings[limb].goal.poleOffset);
+	}
+
+	m_crowd->Clear();
+	m_crowd->SetCompressedClips(m_clipStorage == ClipStorage::Keys ? nullptr : &m_compressedClips);
+
+	for (size_t i = 0; i < m_crowdSize; ++i)
+	{
+		const ClipId clip = i % 2 == 0 ? m_walkClip : m_runClip;
+
+		// Golden ratio stagger so that no two neighbours share a phase, speed factors between 0.9 and 1.1
+		const float phase = std::fmod(static_cast<float>(i) * 0.618034f, 1.0f);
+		const float speedFactor = 0.9f + 0.02f * static_cast<float>(i % 11);
+
+		m_crowd->Spawn(clip, phase * static_cast<float>(m_clips.Clip(clip).KeyCount()), speedFactor);
+	}
+
+	for (size_t limb = 0; limb < m_ikChains.size(); ++limb)
+	{
+		const IkLimbSettings& settings = m_ikLimbSettings[limb];
+		for (CrowdInstanceId instance = 0; instance < m_crowd->Count(); ++instance)
+			m_crowd->SetIkTarget(instance, static_cast<IkLimbId>(limb), settings.goal.target, settings.goal.weight);
+	}
+
+	m_crowd->SetLod(m_crowdLod.get());
+	if (m_crowdLod != nullptr && m_crowdLodMetrics.size() >= m_crowd->Count())
+		m_crowd->AssignLods(m_crowdLodMetrics.data());
+}
+
+void CSimulation::SetCrowdLod(const bool p_enabled)
+{
+	m_crowdLodEnabled = p_enabled;
+
+	if (m_skeleton == nullptr)
+		return;
+
+	m_crowdLod.reset();
+	if (m_crowdLodEnabled)
+	{
+		m_crowdLod = std::make_unique<AnimationLod>(AnimationLod::CreateDefault(*m_skeleton));
+		m_crowdLod->BuildClips(m_clips);
+	}
+
+	if (m_crowd != nullptr)
+	{
+		m_crowd->SetLod(m_crowdLod.get());
+		if (m_crowdLod != nullptr && m_crowdLodMetrics.size() >= m_crowd->Count())
+			m_crowd->AssignLods(m_crowdLodMetrics.data());
+	}
+}
+
+void CSimulation::SetCrowdLodMetrics(std::vector<float> p_metrics)
+{
+	if (m_crowd != nullptr && p_metrics.size() < m_crowd->Count())
+		throw std::invalid_argument("Crowd LOD metrics can't be set, there are less metrics than instances");
+
+	m_crowdLodMetrics = std::move(p_metrics);
+
+	if (m_crowd != nullptr)
+		m_crowd->AssignLods(m_crowdLodMetrics.data());
+}
+
+const AnimationLod* CSimulation::GetCrowdLod() const
+{
+	return m_crowdLod.get();
+}
+
+const Crowd* CSimulation::GetCrowd() const
+{
+	return m_crowd.get();
+}
+
+void CSimulation::SetThreadCount(const size_t p_count)
+{
+	m_jobSystem.reset();
+
+	if (p_count != 1)
+		m_jobSystem = std::make_unique<Jobs::JobSystem>(p_count);
+}
+
+size_t CSimulation::ThreadCount() const
+{
+	return m_jobSystem != nullptr ? m_jobSystem->ThreadCount() : 1;
+}
+
+ClipStorage CSimulation::GetClipStorage() const
+{
+	return m_clipStorage;
+}
+
+const ClipImportReport& CSimulation::GetClipImportReport() const
+{
+	return m_clipImportReport;
 }
 
 void CSimulation::SetAnimationSpeed(const float p_speed)
@@ -237,6 +918,16 @@ void CSimulation::SetAnimationFactorSpeed(const float p_speed)
 	m_animationFactorSpeed = p_speed;
 }
 
+void CSimulation::SetDebugDraw(const bool p_enabled)
+{
+	m_debugDraw = p_enabled;
+}
+
+bool CSimulation::IsDebugDrawEnabled() const
+{
+	return m_debugDraw;
+}
+
 float CSimulation::AnimationSpeed() const
 {
 	return m_speedAnimation;
@@ -261,15 +952,70 @@ void CSimulation::DrawAxis()
 
 void CSimulation::Update(const float p_deltaTime)
 {
-	m_animationElapsedTime += p_deltaTime * m_speedAnimation * m_animationFactorSpeed;
+	AdvanceAnimation(p_deltaTime);
 
 	// Input
 	ChangeAnimation(p_deltaTime);
 
-	// Draw
-	DrawAxis();
+	if (m_jobSystem != nullptr)
+	{
+		// Evaluate and skin as jobs, the crowd in parallel with the main character
+		UpdateJobs(p_deltaTime);
+	}
+	else
+	{
+		// Evaluate
+		EvaluatePose();
+
+		// Skin
+		WriteSkinningPalette();
+
+		if (m_crowd != nullptr)
+			m_crowd->Update(p_deltaTime, m_speedAnimation * m_animationFactorSpeed);
+	}
+
+	// The engine counts the palette in blocks of 16 floats
+	SetSkinningPose(m_skinningAnimationMatrices.data(), SkinningPalette::BlockCount(m_paletteMode, m_skeleton->BoneCount()));
 
-	DrawSkeleton();
+	// Debug draw
+	if (m_debugDraw)
+	{
+		DrawAxis();
+
+		DrawSkeleton();
+	}
+}
+
+void CSimulation::UpdateJobs(const float p_deltaTime)
+{
+	const auto evaluatePose = [this](const size_t, const size_t) { EvaluatePose(); };
+	const auto writeSkinningPalette = [this](const size_t, const size_t) { WriteSkinningPalette(); };
+	Jobs::JobCounter poseJob;
+	Jobs::JobCounter paletteJob;
+	Jobs::JobCounter crowdJobs;
+
+	// Frame graph: the palette of the main character depends on its pose, the crowd instances depend on nothing
+	m_jobSystem->DispatchRange(1, 1, evaluatePose, poseJob);
+	m_jobSystem->DispatchRange(1, 1, writeSkinningPalette, paletteJob, &poseJob);
+
+	if (m_crowd != nullptr)
+		m_crowd->Update(p_deltaTime, m_speedAnimation * m_animationFactorSpeed, *m_jobSystem, crowdJobs);
+
+	// Every counter is waited on, even after a failed job, the jobs of the others still refer to this frame
+	std::exception_ptr exception;
+	for (Jobs::JobCounter* counter : { &poseJob, &paletteJob, &crowdJobs })
+	{
+		try
+		{
+			m_jobSystem->Wait(*counter);
+		}
+		catch (...)
+		{
+			if (exception == nullptr)
+				exception = std::current_exception();
+		}
+	}
 
-	FormatHardwareSkinning();
+	if (exception != nullptr)
+		std::rethrow_exception(exception);
 }
@@ -1,48 +1,92 @@
 #include <Animation/AnimationInfo.h>
 #include <stdexcept>
+#include <algorithm>
+
+namespace
+{
+	constexpr size_t g_streamAlignment = 8;
+}
 
 AnimationInfo::AnimationInfo()
-	: m_keyCount{ 0 }, m_boneCount{ 0 }
+	: m_keyCount{ 0 }, m_boneCount{ 0 }, m_streamStride{ 0 }, m_keyData{ nullptr }
 {
 }
 
 AnimationInfo::AnimationInfo(const AnimationInfo& p_other)
-	: m_keyCount{ p_other.KeyCount() }, m_boneCount{ p_other.m_boneCount }
+	: m_keyCount{ p_other.KeyCount() }, m_boneCount{ p_other.m_boneCount }, m_streamStride{ p_other.m_streamStride },
+	m_keys{ p_other.m_keys }, m_keyData{ p_other.AreKeysMapped() ? p_other.m_keyData : m_keys.data() },
+	m_addedFrameCount{ p_other.m_addedFrameCount }
 {
-	m_keyFrame = p_other.m_keyFrame;
 }
 
 AnimationInfo::AnimationInfo(AnimationInfo&& p_other) noexcept
-	: m_keyCount{ p_other.KeyCount() }, m_boneCount{ p_other.m_boneCount }
+	: m_keyCount{ p_other.KeyCount() }, m_boneCount{ p_other.m_boneCount }, m_streamStride{ p_other.m_streamStride },
+	m_keys{ std::move(p_other.m_keys) }, m_keyData{ p_other.m_keyData }, m_addedFrameCount{ std::move(p_other.m_addedFrameCount) }
 {
-	m_keyFrame = p_other.m_keyFrame;
+	p_other.m_keyData = p_other.m_keys.data();
 }
 
 void AnimationInfo::AddAnimFrame(
 	const size_t p_boneIndex,
 	const Vector3F& p_localAnimPosition,
-	const Quaternion& p_localAnimRotation)
+	const QuaternionF& p_localAnimRotation)
 {
-	m_keyFrame[p_boneIndex].emplace_back(std::make_pair(p_localAnimPosition, p_localAnimRotation));
+	if (p_boneIndex >= m_boneCount)
+		throw std::out_of_range("Animation frame can't be added, p_boneIndex is out of range");
+
+	UpdateAnimFrame(p_boneIndex, m_addedFrameCount[p_boneIndex], p_localAnimPosition, p_localAnimRotation);
+	++m_addedFrameCount[p_boneIndex];
 }
 
 void AnimationInfo::UpdateAnimFrame(
 	const size_t p_boneIndex,
 	const size_t p_frame,
 	const Vector3F& p_localAnimPosition,
-	const Quaternion& p_localAnimRotation)
+	const QuaternionF& p_localAnimRotation)
 {
-	m_keyFrame[p_boneIndex][p_frame] = std::make_pair(p_localAnimPosition, p_localAnimRotation);
+	if (p_boneIndex >= m_boneCount)
+		throw std::out_of_range("Animation frame unattainable, p_boneIndex is out of range");
+	if (p_frame >= m_keyCount)
+		throw std::out_of_range("Animation frame unattainable, p_frame is out of range");
+	if (AreKeysMapped())
+		throw std::logic_error("Animation frame can't be updated, the keys are mapped");
+
+	m_keys[StreamOffset(p_frame, KeyStream::TranslationX) + p_boneIndex] = p_localAnimPosition.x;
+	m_keys[StreamOffset(p_frame, KeyStream::TranslationY) + p_boneIndex] = p_localAnimPosition.y;
+	m_keys[StreamOffset(p_frame, KeyStream::TranslationZ) + p_boneIndex] = p_localAnimPosition.z;
+	m_keys[StreamOffset(p_frame, KeyStream::RotationX) + p_boneIndex] = p_localAnimRotation.axis.x;
+	m_keys[StreamOffset(p_frame, KeyStream::RotationY) + p_boneIndex] = p_localAnimRotation.axis.y;
+	m_keys[StreamOffset(p_frame, KeyStream::RotationZ) + p_boneIndex] = p_localAnimRotation.axis.z;
+	m_keys[StreamOffset(p_frame, KeyStream::RotationW) + p_boneIndex] = p_localAnimRotation.w;
 }
 
 void AnimationInfo::SetKeyCount(const size_t p_keyCount)
 {
 	m_keyCount = p_keyCount;
+	AllocateKeys();
 }
 
 void AnimationInfo::SetBoneCount(const size_t p_boneCount)
 {
 	m_boneCount = p_boneCount;
+	AllocateKeys();
+}
+
+void AnimationInfo::MapKeys(const float* p_keys, const size_t p_keyCount, const size_t p_boneCount)
+{
+	m_keyCount = p_keyCount;
+	m_boneCount = p_boneCount;
+	m_streamStride = (m_boneCount + g_streamAlignment - 1) / g_streamAlignment * g_streamAlignment;
+
+	m_keys.clear();
+	m_keys.shrink_to_fit();
+	m_keyData = p_keys;
+	m_addedFrameCount.assign(m_boneCount, m_keyCount);
+}
+
+bool AnimationInfo::AreKeysMapped() const
+{
+	return m_keyData != m_keys.data();
 }
 
 size_t AnimationInfo::BoneCount() const
@@ -50,29 +94,209 @@ size_t AnimationInfo::BoneCount() const
 	return m_boneCount;
 }
 
+size_t AnimationInfo::KeyMemorySize() const
+{
+	return m_keyCount * m_streamStride * static_cast<size_t>(KeyStream::Count) * sizeof(float);
+}
+
+AnimationInfo& AnimationInfo::operator=(const AnimationInfo& p_other)
+{
+	if (this == &p_other)
+		return *this;
+
+	m_keyCount = p_other.m_keyCount;
+	m_boneCount = p_other.m_boneCount;
+	m_streamStride = p_other.m_streamStride;
+	m_keys = p_other.m_keys;
+	m_keyData = p_other.AreKeysMapped() ? p_other.m_keyData : m_keys.data();
+	m_addedFrameCount = p_other.m_addedFrameCount;
+
+	return *this;
+}
+
 AnimationInfo& AnimationInfo::operator=(AnimationInfo&& p_other) noexcept
 {
 	m_keyCount = p_other.m_keyCount;
 	m_boneCount = p_other.m_boneCount;
-	m_keyFrame = p_other.m_keyFrame;
+	m_streamStride = p_other.m_streamStride;
+	m_keys = std::move(p_other.m_keys);
+	m_keyData = p_other.m_keyData;
+	m_addedFrameCount = std::move(p_other.m_addedFrameCount);
+	p_other.m_keyData = p_other.m_keys.data();
 
 	return *this;
 }
 
-const std::pair<Vector3F, Quaternion>& AnimationInfo::LocalAnimFrame(const size_t p_boneIndex, const size_t p_frame) const
+std::pair<Vector3F, QuaternionF> AnimationInfo::LocalAnimFrame(const size_t p_boneIndex, const size_t p_frame) const
+{
+	if (p_boneIndex >= m_boneCount)
+		throw std::out_of_range("Animation Matrix unattainable, p_boneIndex is out of range");
+	if (p_frame >= m_keyCount)
+		throw std::out_of_range("Animation Matrix unattainable, p_frame is out of range");
+
+	const Vector3F position{
+		FrameStream(p_frame, KeyStream::TranslationX)[p_boneIndex],
+		FrameStream(p_frame, KeyStream::TranslationY)[p_boneIndex],
+		FrameStream(p_frame, KeyStream::TranslationZ)[p_boneIndex] };
+
+	const QuaternionF rotation{
+		FrameStream(p_frame, KeyStream::RotationX)[p_boneIndex],
+		FrameStream(p_frame, KeyStream::RotationY)[p_boneIndex],
+		FrameStream(p_frame, KeyStream::RotationZ)[p_boneIndex],
+		FrameStream(p_frame, KeyStream::RotationW)[p_boneIndex] };
+
+	return std::make_pair(position, rotation);
+}
+
+void AnimationInfo::SamplePose(const float p_time, LocalPose* p_pose, const size_t p_boneCount, const QuaternionInterpolation p_interpolation) const
+{
+	if (m_keyCount == 0)
+		throw std::out_of_range("Animation pose unattainable, the animation has no key");
+
+	const size_t beginFrame = static_cast<size_t>(p_time) % m_keyCount;
+	SampleBones(beginFrame, (beginFrame + 1) % m_keyCount, Tools::Utils::GetDecimalPart(p_time), 0, std::min(p_boneCount, m_boneCount), p_pose, p_interpolation);
+}
+
+void AnimationInfo::SamplePose(const float p_time, const BoneMask& p_mask, LocalPose* p_pose, const size_t p_boneCount,
+	const QuaternionInterpolation p_interpolation) const
+{
+	if (m_keyCount == 0)
+		throw std::out_of_range("Animation pose unattainable, the animation has no key");
+
+	const size_t boneCount = std::min(p_boneCount, m_boneCount);
+	const size_t beginFrame = static_cast<size_t>(p_time) % m_keyCount;
+	const size_t endFrame = (beginFrame + 1) % m_keyCount;
+	const float alpha = Tools::Utils::GetDecimalPart(p_time);
+
+	p_mask.ForEachRange([&](const size_t p_begin, const size_t p_end)
+	{
+		if (p_begin < boneCount)
+			SampleBones(beginFrame, endFrame, alpha, p_begin, std::min(p_end, boneCount), p_pose, p_interpolation);
+	});
+}
+
+void AnimationInfo::SampleBones(const size_t p_beginFrame, const size_t p_endFrame, const float p_alpha, const size_t p_firstBone, const size_t p_endBone,
+	LocalPose* p_pose, const QuaternionInterpolation p_interpolation) const
 {
-	if (m_keyFrame.count(p_boneIndex) > 0)
+	const float* beginTranslationX = FrameStream(p_beginFrame, KeyStream::TranslationX);
+	const float* beginTranslationY = FrameStream(p_beginFrame, KeyStream::TranslationY);
+	const float* beginTranslationZ = FrameStream(p_beginFrame, KeyStream::TranslationZ);
+
+	const float* endTranslationX = FrameStream(p_endFrame, KeyStream::TranslationX);
+	const float* endTranslationY = FrameStream(p_endFrame, KeyStream::TranslationY);
+	const float* endTranslationZ = FrameStream(p_endFrame, KeyStream::TranslationZ);
+
+	for (size_t i = p_firstBone; i < p_endBone; ++i)
 	{
-		if (p_frame < m_keyFrame.at(p_boneIndex).size())
-			return m_keyFrame.at(p_boneIndex)[p_frame];
+		p_pose[i].position.x = beginTranslationX[i] + (endTranslationX[i] - beginTranslationX[i]) * p_alpha;
+		p_pose[i].position.y = beginTranslationY[i] + (endTranslationY[i] - beginTranslationY[i]) * p_alpha;
+		p_pose[i].position.z = beginTranslationZ[i] + (endTranslationZ[i] - beginTranslationZ[i]) * p_alpha;
+	}
 
-		throw std::out_of_range("Animation Matrix unattainable, p_frame is out of range");
+	// The streams start at the first bone of the range, the batch reads them from there
+	const QuaternionStreams beginRotations{
+		FrameStream(p_beginFrame, KeyStream::RotationX) + p_firstBone,
+		FrameStream(p_beginFrame, KeyStream::RotationY) + p_firstBone,
+		FrameStream(p_beginFrame, KeyStream::RotationZ) + p_firstBone,
+		FrameStream(p_beginFrame, KeyStream::RotationW) + p_firstBone };
+
+	const QuaternionStreams endRotations{
+		FrameStream(p_endFrame, KeyStream::RotationX) + p_firstBone,
+		FrameStream(p_endFrame, KeyStream::RotationY) + p_firstBone,
+		FrameStream(p_endFrame, KeyStream::RotationZ) + p_firstBone,
+		FrameStream(p_endFrame, KeyStream::RotationW) + p_firstBone };
+
+	QuaternionBatch::Interpolate(beginRotations, endRotations, p_alpha, p_pose + p_firstBone, p_endBone - p_firstBone, p_interpolation);
+}
+
+void AnimationInfo::SampleBlendedPose(const float p_time, const AnimationInfo& p_target, const float p_targetTime, const float p_weight,
+	LocalPose* p_pose, const size_t p_boneCount, const QuaternionInterpolation p_interpolation) const
+{
+	if (m_keyCount == 0 || p_target.m_keyCount == 0)
+		throw std::out_of_range("Blended pose unattainable, an animation has no key");
+
+	const size_t boneCount = std::min({ p_boneCount, m_boneCount, p_target.m_boneCount });
+
+	const size_t sourceBeginFrame = static_cast<size_t>(p_time) % m_keyCount;
+	const size_t sourceEndFrame = (sourceBeginFrame + 1) % m_keyCount;
+	const float sourceAlpha = Tools::Utils::GetDecimalPart(p_time);
+
+	const size_t targetBeginFrame = static_cast<size_t>(p_targetTime) % p_target.m_keyCount;
+	const size_t targetEndFrame = (targetBeginFrame + 1) % p_target.m_keyCount;
+	const float targetAlpha = Tools::Utils::GetDecimalPart(p_targetTime);
+
+	constexpr KeyStream translationStreams[3] = { KeyStream::TranslationX, KeyStream::TranslationY, KeyStream::TranslationZ };
+	const float* sourceBegin[3];
+	const float* sourceEnd[3];
+	const float* targetBegin[3];
+	const float* targetEnd[3];
+
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		sourceBegin[axis] = FrameStream(sourceBeginFrame, translationStreams[axis]);
+		sourceEnd[axis] = FrameStream(sourceEndFrame, translationStreams[axis]);
+		targetBegin[axis] = p_target.FrameStream(targetBeginFrame, translationStreams[axis]);
+		targetEnd[axis] = p_target.FrameStream(targetEndFrame, translationStreams[axis]);
 	}
 
-	throw std::out_of_range("Animation Matrix unattainable, p_boneIndex is out of range");
+	for (size_t i = 0; i < boneCount; ++i)
+	{
+		float blended[3];
+
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			const float source = sourceBegin[axis][i] + (sourceEnd[axis][i] - sourceBegin[axis][i]) * sourceAlpha;
+			const float target = targetBegin[axis][i] + (targetEnd[axis][i] - targetBegin[axis][i]) * targetAlpha;
+			blended[axis] = source + (target - source) * p_weight;
+		}
+
+		p_pose[i].position = Vector3F{ blended[0], blended[1], blended[2] };
+	}
+
+	const auto rotationStreams = [](const AnimationInfo& p_animation, const size_t p_frame)
+	{
+		return QuaternionStreams{
+			p_animation.FrameStream(p_frame, KeyStream::RotationX),
+			p_animation.FrameStream(p_frame, KeyStream::RotationY),
+			p_animation.FrameStream(p_frame, KeyStream::RotationZ),
+			p_animation.FrameStream(p_frame, KeyStream::RotationW) };
+	};
+
+	QuaternionBatch::InterpolateBlend(
+		QuaternionSample{ rotationStreams(*this, sourceBeginFrame), rotationStreams(*this, sourceEndFrame), sourceAlpha },
+		QuaternionSample{ rotationStreams(p_target, targetBeginFrame), rotationStreams(p_target, targetEndFrame), targetAlpha },
+		p_weight,
+		p_pose,
+		boneCount,
+		p_interpolation);
+}
+
+const float* AnimationInfo::FrameStream(const size_t p_frame, const KeyStream p_stream) const
+{
+	return m_keyData + StreamOffset(p_frame, p_stream);
 }
 
 size_t AnimationInfo::KeyCount() const
 {
 	return m_keyCount;
 }
+
+void AnimationInfo::AllocateKeys()
+{
+	m_streamStride = (m_boneCount + g_streamAlignment - 1) / g_streamAlignment * g_streamAlignment;
+	m_keys.assign(m_keyCount * m_streamStride * static_cast<size_t>(KeyStream::Count), 0.0f);
+	m_keyData = m_keys.data();
+	m_addedFrameCount.assign(m_boneCount, 0);
+
+	for (size_t frame = 0; frame < m_keyCount; ++frame)
+	{
+		float* rotationW = m_keys.data() + StreamOffset(frame, KeyStream::RotationW);
+		for (size_t bone = 0; bone < m_boneCount; ++bone)
+			rotationW[bone] = 1.0f;
+	}
+}
+
+size_t AnimationInfo::StreamOffset(const size_t p_frame, const KeyStream p_stream) const
+{
+	return (p_frame * static_cast<size_t>(KeyStream::Count) + static_cast<size_t>(p_stream)) * m_streamStride;
+}
@@ -0,0 +1,112 @@
+#include <Animation/AnimationLod.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <optional>
+#include <string>
+
+namespace
+{
+	/**
+	 * @brief Remove from a mask the descendants of a bone, the bone itself is kept.
+	 */
+	void RemoveDescendants(const Skeleton& p_skeleton, const std::string_view& p_boneName, BoneMask& p_mask)
+	{
+		const std::optional<size_t> bone = p_skeleton.BoneIndex(p_boneName);
+		if (!bone.has_value())
+			return;
+
+		const BoneMask subtree = BoneMask::FromSubtree(p_skeleton, bone.value());
+		subtree.ForEachRange([&](const size_t p_begin, const size_t p_end)
+		{
+			for (size_t i = p_begin; i < p_end; ++i)
+			{
+				if (i != bone.value())
+					p_mask.Set(i, false);
+			}
+		});
+	}
+
+	void RemoveBone(const Skeleton& p_skeleton, const std::string_view& p_boneName, BoneMask& p_mask)
+	{
+		if (const std::optional<size_t> bone = p_skeleton.BoneIndex(p_boneName))
+			p_mask.Set(bone.value(), false);
+	}
+}
+
+AnimationLod AnimationLod::CreateDefault(const Skeleton& p_skeleton)
+{
+	AnimationLod lod;
+	BoneMask bones(p_skeleton.BoneCount(), true);
+	lod.AddLevel(bones, 1, 500.0f);
+
+	RemoveDescendants(p_skeleton, "hand_l", bones);
+	RemoveDescendants(p_skeleton, "hand_r", bones);
+	lod.AddLevel(bones, 1, 1500.0f);
+
+	for (size_t i = 0; i < p_skeleton.BoneCount(); ++i)
+	{
+		if (p_skeleton.BoneName(i).find("twist") != std::string::npos)
+			bones.Set(i, false);
+	}
+	lod.AddLevel(bones, 2, 4000.0f);
+
+	for (const char* boneName : { "neck_01", "clavicle_l", "clavicle_r", "ball_l", "ball_r" })
+		RemoveBone(p_skeleton, boneName, bones);
+	lod.AddLevel(bones, 4, std::numeric_limits<float>::max());
+
+	return lod;
+}
+
+size_t AnimationLod::AddLevel(const BoneMask& p_bones, const uint32_t p_updateInterval, const float p_maxMetric)
+{
+	if (p_updateInterval == 0)
+		throw std::invalid_argument("LOD level can't be added, its update interval is 0");
+	if (!m_levels.empty() && p_maxMetric < m_levels.back().maxMetric)
+		throw std::invalid_argument("LOD level can't be added, its metric is below the one of the previous level");
+
+	m_levels.push_back({ p_bones, p_updateInterval, p_maxMetric, {} });
+	return m_levels.size() - 1;
+}
+
+void AnimationLod::BuildClips(const ClipRegistry& p_clips)
+{
+	for (Level& level : m_levels)
+	{
+		level.clips.clear();
+		for (ClipId clip = 0; clip < p_clips.Count(); ++clip)
+			level.clips.emplace_back(p_clips.Clip(clip), level.bones);
+	}
+}
+
+size_t AnimationLod::LevelCount() const
+{
+	return m_levels.size();
+}
+
+size_t AnimationLod::SelectLevel(const float p_metric) const
+{
+	// The levels are sorted by metric, a NaN metric isn't animated
+	const auto level = std::find_if(m_levels.begin(), m_levels.end(), [p_metric](const Level& p_level) { return p_metric <= p_level.maxMetric; });
+	return static_cast<size_t>(level - m_levels.begin());
+}
+
+const BoneMask& AnimationLod::Bones(const size_t p_level) const
+{
+	return m_levels[p_level].bones;
+}
+
+uint32_t AnimationLod::UpdateInterval(const size_t p_level) const
+{
+	return m_levels[p_level].updateInterval;
+}
+
+float AnimationLod::MaxMetric(const size_t p_level) const
+{
+	return m_levels[p_level].maxMetric;
+}
+
+const std::vector<CompressedClip>& AnimationLod::Clips(const size_t p_level) const
+{
+	return m_levels[p_level].clips;
+}
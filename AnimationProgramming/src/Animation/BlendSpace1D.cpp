@@ -0,0 +1,172 @@
+#include <Animation/BlendSpace1D.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+BlendSpace1D::BlendSpace1D(const ClipRegistry& p_clips)
+	: m_clips{ p_clips }
+{
+}
+
+void BlendSpace1D::AddClip(const ClipId p_clipId, const ClipCycle& p_cycle)
+{
+	if (p_cycle.StrideLength() <= 0.0f)
+		throw std::invalid_argument("Clip can't be added to the blend space, it doesn't move the character");
+	if (!m_samples.empty() && m_samples.front().cycle.MarkerCount() != p_cycle.MarkerCount())
+		throw std::invalid_argument("Clip can't be added to the blend space, its sync markers don't match the other clips");
+
+	const Sample sample{ p_clipId, p_cycle, p_cycle.StrideLength() / p_cycle.KeyCount() };
+	const auto position = std::upper_bound(m_samples.begin(), m_samples.end(), sample,
+		[](const Sample& p_left, const Sample& p_right) { return p_left.speedPerKey < p_right.speedPerKey; });
+
+	m_samples.insert(position, sample);
+	m_lower = 0;
+	m_upper = 0;
+	m_weight = 0.0f;
+}
+
+void BlendSpace1D::Clear()
+{
+	m_samples.clear();
+	m_lower = 0;
+	m_upper = 0;
+	m_weight = 0.0f;
+}
+
+size_t BlendSpace1D::ClipCount() const
+{
+	return m_samples.size();
+}
+
+bool BlendSpace1D::HasClip(const ClipId p_clipId) const
+{
+	return std::any_of(m_samples.begin(), m_samples.end(), [p_clipId](const Sample& p_sample) { return p_sample.clipId == p_clipId; });
+}
+
+float BlendSpace1D::ClipSpeed(const ClipId p_clipId, const float p_keysPerSecond) const
+{
+	return FindSample(p_clipId).speedPerKey * p_keysPerSecond;
+}
+
+void BlendSpace1D::Update(const float p_deltaTime, const float p_speed, const float p_keysPerSecond)
+{
+	if (m_samples.empty())
+		throw std::logic_error("Blend space can't be updated, it has no clip");
+
+	const float speed = std::max(p_speed, 0.0f);
+	const auto upper = std::upper_bound(m_samples.begin(), m_samples.end(), speed,
+		[p_keysPerSecond](const float p_value, const Sample& p_sample) { return p_value < p_sample.speedPerKey * p_keysPerSecond; });
+
+	// Outside of the clips, the nearest one is played at the rate that matches the speed
+	float rateScale = 1.0f;
+	if (upper == m_samples.begin() || upper == m_samples.end())
+	{
+		m_lower = upper == m_samples.begin() ? 0 : m_samples.size() - 1;
+		m_upper = m_lower;
+		m_weight = 0.0f;
+
+		const float clipSpeed = m_samples[m_lower].speedPerKey * p_keysPerSecond;
+		rateScale = clipSpeed > 0.0f ? speed / clipSpeed : 0.0f;
+	}
+	else
+	{
+		m_upper = static_cast<size_t>(upper - m_samples.begin());
+		m_lower = m_upper - 1;
+
+		// The blended stride is covered in the blended cycle: speed = lerp(stride) / lerp(duration), solved for the weight
+		const Sample& lower = m_samples[m_lower];
+		const Sample& higher = m_samples[m_upper];
+		const float lowerDuration = lower.cycle.KeyCount() / p_keysPerSecond;
+		const float higherDuration = higher.cycle.KeyCount() / p_keysPerSecond;
+		const float denominator = higher.cycle.StrideLength() - lower.cycle.StrideLength() - speed * (higherDuration - lowerDuration);
+
+		m_weight = denominator != 0.0f ? std::clamp((speed * lowerDuration - lower.cycle.StrideLength()) / denominator, 0.0f, 1.0f) : 0.0f;
+	}
+
+	if (p_keysPerSecond <= 0.0f || rateScale <= 0.0f)
+		return;
+
+	// The phase crosses the segments between markers one by one, each one lasting the weighted length of the segment in both clips
+	const Sample& lower = m_samples[m_lower];
+	const Sample& higher = m_samples[m_upper];
+	const size_t markerCount = lower.cycle.MarkerCount();
+	float remainingTime = p_deltaTime * p_keysPerSecond * rateScale;
+
+	while (remainingTime > 0.0f)
+	{
+		const size_t segment = std::min(static_cast<size_t>(m_phase), markerCount - 1);
+		const float lowerLength = lower.cycle.SegmentLength(segment);
+		const float segmentLength = lowerLength + (higher.cycle.SegmentLength(segment) - lowerLength) * m_weight;
+		const float segmentEnd = static_cast<float>(segment + 1);
+		const float advance = remainingTime / segmentLength;
+
+		if (m_phase + advance < segmentEnd)
+		{
+			m_phase += advance;
+			break;
+		}
+
+		remainingTime -= (segmentEnd - m_phase) * segmentLength;
+		m_phase = segment + 1 < markerCount ? segmentEnd : 0.0f;
+	}
+}
+
+void BlendSpace1D::SamplePose(LocalPose* p_pose, const size_t p_boneCount) const
+{
+	if (m_samples.empty())
+		throw std::logic_error("Blend space can't be sampled, it has no clip");
+
+	const Sample& lower = m_samples[m_lower];
+	const AnimationInfo& lowerClip = m_clips.Clip(lower.clipId);
+
+	if (m_lower == m_upper || m_weight <= 0.0f)
+	{
+		lowerClip.SamplePose(lower.cycle.ClipTime(m_phase), p_pose, p_boneCount);
+		return;
+	}
+
+	const Sample& higher = m_samples[m_upper];
+	lowerClip.SampleBlendedPose(lower.cycle.ClipTime(m_phase), m_clips.Clip(higher.clipId), higher.cycle.ClipTime(m_phase), m_weight,
+		p_pose, p_boneCount);
+}
+
+void BlendSpace1D::SetPhase(const float p_syncPhase)
+{
+	const float markerCount = m_samples.empty() ? 1.0f : static_cast<float>(m_samples.front().cycle.MarkerCount());
+
+	m_phase = std::fmod(p_syncPhase, markerCount);
+	if (m_phase < 0.0f)
+		m_phase += markerCount;
+}
+
+float BlendSpace1D::Phase() const
+{
+	return m_phase;
+}
+
+ClipId BlendSpace1D::DominantClip() const
+{
+	if (m_samples.empty())
+		throw std::logic_error("Blend space has no clip");
+
+	return m_samples[m_weight > 0.5f ? m_upper : m_lower].clipId;
+}
+
+float BlendSpace1D::ClipTime(const ClipId p_clipId) const
+{
+	return FindSample(p_clipId).cycle.ClipTime(m_phase);
+}
+
+float BlendSpace1D::Weight() const
+{
+	return m_weight;
+}
+
+const BlendSpace1D::Sample& BlendSpace1D::FindSample(const ClipId p_clipId) const
+{
+	const auto sample = std::find_if(m_samples.begin(), m_samples.end(), [p_clipId](const Sample& p_sample) { return p_sample.clipId == p_clipId; });
+	if (sample == m_samples.end())
+		throw std::out_of_range("Clip isn't in the blend space");
+
+	return *sample;
+}
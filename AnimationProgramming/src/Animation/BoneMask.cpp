@@ -0,0 +1,120 @@
+#include <Animation/BoneMask.h>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+	constexpr size_t g_wordBitCount = 64;
+
+	/**
+	 * @brief Index of the lowest set bit of a word that isn't 0.
+	 */
+	size_t LowestSetBit(const uint64_t p_word)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, p_word);
+		return index;
+#else
+		return static_cast<size_t>(__builtin_ctzll(p_word));
+#endif
+	}
+
+	size_t PopulationCount(uint64_t p_word)
+	{
+		size_t count = 0;
+		for (; p_word != 0; p_word &= p_word - 1)
+			++count;
+
+		return count;
+	}
+}
+
+BoneMask::BoneMask(const size_t p_boneCount, const bool p_allBones)
+	: m_boneCount{ p_boneCount }, m_words((p_boneCount + g_wordBitCount - 1) / g_wordBitCount, 0)
+{
+	if (p_allBones)
+		Invert();
+}
+
+BoneMask BoneMask::FromSubtree(const Skeleton& p_skeleton, const size_t p_rootBoneIndex)
+{
+	if (p_rootBoneIndex >= p_skeleton.BoneCount())
+		throw std::out_of_range("Bone mask can't be created, the root bone is out of range");
+
+	BoneMask mask(p_skeleton.BoneCount());
+	mask.Set(p_rootBoneIndex);
+
+	// Parents come before their children, a single pass reaches every descendant
+	for (size_t i = p_rootBoneIndex + 1; i < p_skeleton.BoneCount(); ++i)
+	{
+		const int parentIndex = p_skeleton.ParentIndex(i);
+		if (parentIndex != -1 && mask.Test(static_cast<size_t>(parentIndex)))
+			mask.Set(i);
+	}
+
+	return mask;
+}
+
+void BoneMask::Set(const size_t p_boneIndex, const bool p_value)
+{
+	if (p_boneIndex >= m_boneCount)
+		throw std::out_of_range("Bone can't be set, it is out of the mask");
+
+	const uint64_t bit = uint64_t{ 1 } << (p_boneIndex % g_wordBitCount);
+
+	if (p_value)
+		m_words[p_boneIndex / g_wordBitCount] |= bit;
+	else
+		m_words[p_boneIndex / g_wordBitCount] &= ~bit;
+}
+
+bool BoneMask::Test(const size_t p_boneIndex) const
+{
+	return p_boneIndex < m_boneCount && (m_words[p_boneIndex / g_wordBitCount] >> (p_boneIndex % g_wordBitCount) & 1) != 0;
+}
+
+void BoneMask::Invert()
+{
+	for (uint64_t& word : m_words)
+		word = ~word;
+
+	// The bits past the last bone stay clear, Count and FindNext rely on it
+	if (m_boneCount % g_wordBitCount != 0)
+		m_words.back() &= (uint64_t{ 1 } << (m_boneCount % g_wordBitCount)) - 1;
+}
+
+size_t BoneMask::Count() const
+{
+	size_t count = 0;
+	for (const uint64_t word : m_words)
+		count += PopulationCount(word);
+
+	return count;
+}
+
+size_t BoneMask::BoneCount() const
+{
+	return m_boneCount;
+}
+
+size_t BoneMask::FindNext(const size_t p_boneIndex, const bool p_value) const
+{
+	for (size_t wordIndex = p_boneIndex / g_wordBitCount; wordIndex < m_words.size(); ++wordIndex)
+	{
+		uint64_t word = p_value ? m_words[wordIndex] : ~m_words[wordIndex];
+
+		// Bits before the starting bone are ignored
+		if (wordIndex == p_boneIndex / g_wordBitCount)
+			word &= ~uint64_t{ 0 } << (p_boneIndex % g_wordBitCount);
+
+		if (word != 0)
+			return std::min(m_boneCount, wordIndex * g_wordBitCount + LowestSetBit(word));
+	}
+
+	return m_boneCount;
+}
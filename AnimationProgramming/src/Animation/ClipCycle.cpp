@@ -0,0 +1,251 @@
+#include <Animation/ClipCycle.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+	/**
+	 * @brief Logarithm of a unit quaternion: its rotation axis scaled by its angle, on the hemisphere of w >= 0.
+	 */
+	Vector3F RotationLog(const QuaternionF& p_rotation)
+	{
+		const float sign = p_rotation.w < 0.0f ? -1.0f : 1.0f;
+		const float x = p_rotation.axis.x * sign;
+		const float y = p_rotation.axis.y * sign;
+		const float z = p_rotation.axis.z * sign;
+		const float sinHalfAngle = std::sqrt(x * x + y * y + z * z);
+
+		if (sinHalfAngle < 1e-6f)
+			return Vector3F{ 2.0f * x, 2.0f * y, 2.0f * z };
+
+		const float scale = 2.0f * std::atan2(sinHalfAngle, p_rotation.w * sign) / sinHalfAngle;
+		return Vector3F{ x * scale, y * scale, z * scale };
+	}
+
+	/**
+	 * @brief Axis along which a set of vectors spreads the most (main axis of their covariance), oriented on its largest component
+	 * so that the same motion gives the same axis in every clip.
+	 */
+	Vector3F MainAxis(const std::vector<Vector3F>& p_vectors)
+	{
+		float mean[3]{ 0.0f, 0.0f, 0.0f };
+		for (const Vector3F& vector : p_vectors)
+		{
+			mean[0] += vector.x / p_vectors.size();
+			mean[1] += vector.y / p_vectors.size();
+			mean[2] += vector.z / p_vectors.size();
+		}
+
+		float covariance[3][3]{};
+		for (const Vector3F& vector : p_vectors)
+		{
+			const float centered[3]{ vector.x - mean[0], vector.y - mean[1], vector.z - mean[2] };
+			for (size_t row = 0; row < 3; ++row)
+				for (size_t column = 0; column < 3; ++column)
+					covariance[row][column] += centered[row] * centered[column];
+		}
+
+		// Power iteration, the covariance is symmetric positive so it converges to the main axis
+		float axis[3]{ 1.0f, 1.0f, 1.0f };
+		for (size_t iteration = 0; iteration < 64; ++iteration)
+		{
+			float next[3]{};
+			for (size_t row = 0; row < 3; ++row)
+				next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+
+			const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+			if (length < 1e-12f)
+				break;
+
+			for (size_t row = 0; row < 3; ++row)
+				axis[row] = next[row] / length;
+		}
+
+		size_t largest = 0;
+		for (size_t row = 1; row < 3; ++row)
+			if (std::abs(axis[row]) > std::abs(axis[largest]))
+				largest = row;
+
+		const float orientation = axis[largest] < 0.0f ? -1.0f : 1.0f;
+		return Vector3F{ axis[0] * orientation, axis[1] * orientation, axis[2] * orientation };
+	}
+
+	/**
+	 * @brief Project every vector on their main axis.
+	 */
+	std::vector<float> ProjectOnMainAxis(const std::vector<Vector3F>& p_vectors)
+	{
+		const Vector3F axis = MainAxis(p_vectors);
+
+		std::vector<float> projections;
+		projections.reserve(p_vectors.size());
+		for (const Vector3F& vector : p_vectors)
+			projections.push_back(vector.x * axis.x + vector.y * axis.y + vector.z * axis.z);
+
+		return projections;
+	}
+
+	/**
+	 * @brief Swing of a bone at every key: its local rotation projected on the axis it rotates the most around.
+	 */
+	std::vector<float> BoneSwing(const AnimationInfo& p_clip, const size_t p_boneIndex)
+	{
+		std::vector<Vector3F> logs;
+		logs.reserve(p_clip.KeyCount());
+		for (size_t key = 0; key < p_clip.KeyCount(); ++key)
+			logs.push_back(RotationLog(p_clip.LocalAnimFrame(p_boneIndex, key).second));
+
+		return ProjectOnMainAxis(logs);
+	}
+
+	/**
+	 * @brief Time of the largest value of a looping signal, refined between keys with the parabola through the key and its neighbours.
+	 */
+	float PeakTime(const std::vector<float>& p_signal)
+	{
+		const size_t count = p_signal.size();
+		size_t peak = 0;
+		for (size_t key = 1; key < count; ++key)
+			if (p_signal[key] > p_signal[peak])
+				peak = key;
+
+		if (count < 3)
+			return static_cast<float>(peak);
+
+		const float previous = p_signal[(peak + count - 1) % count];
+		const float next = p_signal[(peak + 1) % count];
+		const float curvature = previous - 2.0f * p_signal[peak] + next;
+		const float offset = curvature < 0.0f ? 0.5f * (previous - next) / curvature : 0.0f;
+
+		return std::fmod(static_cast<float>(peak) + offset + count, static_cast<float>(count));
+	}
+
+	/**
+	 * @brief World position of the left foot relative to the right foot at every key.
+	 */
+	std::vector<Vector3F> FootSeparations(const AnimationInfo& p_clip, const Skeleton& p_skeleton, const GaitBones& p_bones)
+	{
+		std::vector<LocalPose> localPose(p_skeleton.BoneCount());
+		std::vector<Matrix4F> worldPose(p_skeleton.BoneCount());
+		std::vector<Vector3F> separations;
+		separations.reserve(p_clip.KeyCount());
+
+		for (size_t key = 0; key < p_clip.KeyCount(); ++key)
+		{
+			p_clip.SamplePose(static_cast<float>(key), localPose.data(), localPose.size());
+			p_skeleton.ComputeWorldPose(localPose.data(), worldPose.data());
+
+			const float* left = worldPose[p_bones.leftFoot].m_data;
+			const float* right = worldPose[p_bones.rightFoot].m_data;
+			separations.push_back(Vector3F{ left[3] - right[3], left[7] - right[7], left[11] - right[11] });
+		}
+
+		return separations;
+	}
+}
+
+ClipCycle::ClipCycle(const AnimationInfo& p_clip)
+	: m_keyCount{ static_cast<float>(p_clip.KeyCount()) }, m_markers{ 0.0f }
+{
+	if (p_clip.KeyCount() == 0)
+		throw std::invalid_argument("Clip cycle can't be computed, the clip has no key");
+}
+
+ClipCycle::ClipCycle(const AnimationInfo& p_clip, const Skeleton& p_skeleton, const GaitBones& p_bones)
+	: ClipCycle(p_clip)
+{
+	const size_t boneCount = std::min(p_clip.BoneCount(), p_skeleton.BoneCount());
+	if (p_bones.leftThigh >= boneCount || p_bones.rightThigh >= boneCount || p_bones.leftFoot >= boneCount || p_bones.rightFoot >= boneCount)
+		throw std::invalid_argument("Clip cycle can't be computed, a gait bone is out of range");
+
+	const std::vector<float> leftSwing = BoneSwing(p_clip, p_bones.leftThigh);
+	const std::vector<float> rightSwing = BoneSwing(p_clip, p_bones.rightThigh);
+
+	// The legs swing in opposition, their difference peaks once each way per cycle
+	std::vector<float> spread(leftSwing.size());
+	std::vector<float> reversedSpread(leftSwing.size());
+	for (size_t key = 0; key < spread.size(); ++key)
+	{
+		spread[key] = leftSwing[key] - rightSwing[key];
+		reversedSpread[key] = -spread[key];
+	}
+
+	m_markers = { PeakTime(spread), PeakTime(reversedSpread) };
+
+	// The feet go from one step to the other along the walking direction, the main axis of their separation
+	const std::vector<float> separation = ProjectOnMainAxis(FootSeparations(p_clip, p_skeleton, p_bones));
+	const auto [shortest, longest] = std::minmax_element(separation.begin(), separation.end());
+	m_strideLength = *longest - *shortest;
+}
+
+ClipCycle::ClipCycle(const size_t p_keyCount, const float p_strideLength, std::vector<float> p_markers)
+	: m_keyCount{ static_cast<float>(p_keyCount) }, m_strideLength{ p_strideLength }, m_markers{ std::move(p_markers) }
+{
+	if (p_keyCount == 0)
+		throw std::invalid_argument("Clip cycle can't be created, the clip has no key");
+	if (m_markers.empty())
+		throw std::invalid_argument("Clip cycle can't be created, it has no marker");
+}
+
+float ClipCycle::KeyCount() const
+{
+	return m_keyCount;
+}
+
+float ClipCycle::StrideLength() const
+{
+	return m_strideLength;
+}
+
+size_t ClipCycle::MarkerCount() const
+{
+	return m_markers.size();
+}
+
+float ClipCycle::MarkerTime(const size_t p_marker) const
+{
+	return m_markers[p_marker];
+}
+
+float ClipCycle::SegmentLength(const size_t p_marker) const
+{
+	const float length = WrapTime(m_markers[(p_marker + 1) % m_markers.size()] - m_markers[p_marker]);
+
+	// A single marker spans the whole cycle
+	return length > 0.0f ? length : m_keyCount;
+}
+
+float ClipCycle::ClipTime(const float p_syncPhase) const
+{
+	const float markerCount = static_cast<float>(m_markers.size());
+	float phase = std::fmod(p_syncPhase, markerCount);
+	if (phase < 0.0f)
+		phase += markerCount;
+
+	const size_t marker = std::min(static_cast<size_t>(phase), m_markers.size() - 1);
+	return WrapTime(m_markers[marker] + (phase - static_cast<float>(marker)) * SegmentLength(marker));
+}
+
+float ClipCycle::SyncPhase(const float p_time) const
+{
+	const float time = WrapTime(p_time);
+
+	for (size_t marker = 0; marker < m_markers.size(); ++marker)
+	{
+		const float elapsed = WrapTime(time - m_markers[marker]);
+		const float length = SegmentLength(marker);
+
+		if (elapsed < length)
+			return static_cast<float>(marker) + elapsed / length;
+	}
+
+	return 0.0f;
+}
+
+float ClipCycle::WrapTime(const float p_time) const
+{
+	const float time = std::fmod(p_time, m_keyCount);
+	return time < 0.0f ? time + m_keyCount : time;
+}
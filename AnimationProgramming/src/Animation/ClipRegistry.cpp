@@ -0,0 +1,43 @@
+#include <Animation/ClipRegistry.h>
+
+ClipId ClipRegistry::Register(const std::string_view& p_clipName)
+{
+	if (const std::optional<ClipId> existingClip = Find(p_clipName))
+		return existingClip.value();
+
+	m_clips.emplace_back();
+	m_names.emplace_back(p_clipName);
+
+	return static_cast<ClipId>(m_clips.size() - 1);
+}
+
+std::optional<ClipId> ClipRegistry::Find(const std::string_view& p_clipName) const
+{
+	for (size_t i = 0; i < m_names.size(); ++i)
+	{
+		if (m_names[i] == p_clipName)
+			return static_cast<ClipId>(i);
+	}
+
+	return {};
+}
+
+AnimationInfo& ClipRegistry::Clip(const ClipId p_clipId)
+{
+	return m_clips[p_clipId];
+}
+
+const AnimationInfo& ClipRegistry::Clip(const ClipId p_clipId) const
+{
+	return m_clips[p_clipId];
+}
+
+const std::string& ClipRegistry::Name(const ClipId p_clipId) const
+{
+	return m_names[p_clipId];
+}
+
+size_t ClipRegistry::Count() const
+{
+	return m_clips.size();
+}
@@ -0,0 +1,482 @@
+#include <Animation/CompressedClip.h>
+#include <Resources/Skeleton.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// The rotation decode works on integers, which takes SSE2 where GPM only needs SSE
+#if defined(GPM_SIMD_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define COMPRESSED_CLIP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	constexpr size_t g_streamAlignment = 8;
+
+	/**
+	 * @brief Number of bones decoded together before their rotations are interpolated.
+	 */
+	constexpr size_t g_decodeChunk = 8;
+
+	constexpr float g_smallestThreeRange = 0.70710678f;
+	constexpr float g_rotationQuantization = 32767.0f;
+	constexpr float g_translationQuantization = 65535.0f;
+
+	/**
+	 * @brief Pack a normalized quaternion in 48 bits: the index of its largest component, then the three others on 15 bits each.
+	 * The three others are stored in cyclic order after the largest one so that decoding needs no branch.
+	 * @param p_rotation The quaternion, components x, y, z, w
+	 * @param p_words The 3 words receiving the packed quaternion
+	 */
+	void EncodeRotation(const float p_rotation[4], uint16_t p_words[3])
+	{
+		size_t largest = 0;
+		for (size_t i = 1; i < 4; ++i)
+		{
+			if (std::abs(p_rotation[i]) > std::abs(p_rotation[largest]))
+				largest = i;
+		}
+
+		// q and -q are the same rotation, the dropped component is rebuilt as positive
+		const float sign = p_rotation[largest] < 0.0f ? -1.0f : 1.0f;
+		uint64_t bits = static_cast<uint64_t>(largest) << 45;
+
+		for (size_t i = 1; i < 4; ++i)
+		{
+			const float normalized = (p_rotation[(largest + i) & 3] * sign + g_smallestThreeRange) / (2.0f * g_smallestThreeRange);
+			const float quantized = std::clamp(normalized, 0.0f, 1.0f) * g_rotationQuantization + 0.5f;
+
+			bits |= static_cast<uint64_t>(quantized) << (45 - 15 * i);
+		}
+
+		p_words[0] = static_cast<uint16_t>(bits);
+		p_words[1] = static_cast<uint16_t>(bits >> 16);
+		p_words[2] = static_cast<uint16_t>(bits >> 32);
+	}
+
+	/**
+	 * @brief Unpack a quaternion written by EncodeRotation.
+	 * @param p_word0 The lowest word
+	 * @param p_word1 The middle word
+	 * @param p_word2 The highest word
+	 * @param p_components The 4 streams receiving the components x, y, z, w
+	 * @param p_index The index written in each stream
+	 */
+	void DecodeRotation(const uint16_t p_word0, const uint16_t p_word1, const uint16_t p_word2, float* const p_components[4], const size_t p_index)
+	{
+		const uint64_t bits = static_cast<uint64_t>(p_word0) | static_cast<uint64_t>(p_word1) << 16 | static_cast<uint64_t>(p_word2) << 32;
+		const size_t largest = static_cast<size_t>(bits >> 45) & 3;
+		constexpr float scale = 2.0f * g_smallestThreeRange / g_rotationQuantization;
+
+		const float a = static_cast<float>(static_cast<int>((bits >> 30) & 0x7FFF)) * scale - g_smallestThreeRange;
+		const float b = static_cast<float>(static_cast<int>((bits >> 15) & 0x7FFF)) * scale - g_smallestThreeRange;
+		const float c = static_cast<float>(static_cast<int>(bits & 0x7FFF)) * scale - g_smallestThreeRange;
+
+		p_components[largest][p_index] = std::sqrt(std::max(0.0f, 1.0f - a * a - b * b - c * c));
+		p_components[(largest + 1) & 3][p_index] = a;
+		p_components[(largest + 2) & 3][p_index] = b;
+		p_components[(largest + 3) & 3][p_index] = c;
+	}
+
+#if defined(COMPRESSED_CLIP_SSE2)
+	/**
+	 * @brief Unpack 4 consecutive quaternions written by EncodeRotation, same result as DecodeRotation.
+	 * @param p_words0 The lowest words
+	 * @param p_words1 The middle words
+	 * @param p_words2 The highest words
+	 * @param p_components The 4 streams receiving the components x, y, z, w
+	 * @param p_lane The index of the first quaternion in the streams, a multiple of 4
+	 */
+	void DecodeRotations4(const uint16_t* p_words0, const uint16_t* p_words1, const uint16_t* p_words2, float p_components[4][g_decodeChunk], const size_t p_lane)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i mask = _mm_set1_epi32(0x7FFF);
+		const __m128i word0 = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p_words0)), zero);
+		const __m128i word1 = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p_words1)), zero);
+		const __m128i word2 = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p_words2)), zero);
+
+		// Bits 45-46 hold the index of the dropped component, then 15 bits per component from bit 30 down to bit 0
+		const __m128i largest = _mm_and_si128(_mm_srli_epi32(word2, 13), _mm_set1_epi32(3));
+		const __m128i packedA = _mm_and_si128(_mm_or_si128(_mm_slli_epi32(word2, 2), _mm_srli_epi32(word1, 14)), mask);
+		const __m128i packedB = _mm_and_si128(_mm_or_si128(_mm_slli_epi32(word1, 1), _mm_srli_epi32(word0, 15)), mask);
+		const __m128i packedC = _mm_and_si128(word0, mask);
+
+		const __m128 scale = _mm_set1_ps(2.0f * g_smallestThreeRange / g_rotationQuantization);
+		const __m128 offset = _mm_set1_ps(g_smallestThreeRange);
+		const __m128 a = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(packedA), scale), offset);
+		const __m128 b = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(packedB), scale), offset);
+		const __m128 c = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(packedC), scale), offset);
+		const __m128 lengthSquared = _mm_add_ps(_mm_mul_ps(a, a), _mm_add_ps(_mm_mul_ps(b, b), _mm_mul_ps(c, c)));
+		const __m128 dropped = _mm_sqrt_ps(_mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_set1_ps(1.0f), lengthSquared)));
+
+		for (int component = 0; component < 4; ++component)
+		{
+			// Position of the component after the dropped one, in the cyclic order used by EncodeRotation
+			const __m128i position = _mm_and_si128(_mm_sub_epi32(_mm_set1_epi32(component), largest), _mm_set1_epi32(3));
+
+			const __m128 value = _mm_or_ps(
+				_mm_or_ps(
+					_mm_and_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(position, _mm_set1_epi32(0))), dropped),
+					_mm_and_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(position, _mm_set1_epi32(1))), a)),
+				_mm_or_ps(
+					_mm_and_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(position, _mm_set1_epi32(2))), b),
+					_mm_and_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(position, _mm_set1_epi32(3))), c)));
+
+			_mm_store_ps(p_components[component] + p_lane, value);
+		}
+	}
+#endif
+
+	/**
+	 * @brief Return the angle in radians of the rotation between two quaternions.
+	 */
+	float AngleBetween(const QuaternionF& p_left, const QuaternionF& p_right)
+	{
+		const QuaternionF relative = QuaternionF::Conjugate(p_left) * p_right;
+		const float sine = std::sqrt(relative.axis.x * relative.axis.x + relative.axis.y * relative.axis.y + relative.axis.z * relative.axis.z);
+
+		return 2.0f * std::atan2(sine, std::abs(relative.w));
+	}
+}
+
+CompressedClip::CompressedClip(const AnimationInfo& p_source, const float p_translationTolerance, const float p_rotationTolerance)
+	: CompressedClip(p_source, BoneMask(p_source.BoneCount(), true), p_translationTolerance, p_rotationTolerance)
+{
+}
+
+CompressedClip::CompressedClip(const AnimationInfo& p_source, const BoneMask& p_bones, const float p_translationTolerance, const float p_rotationTolerance)
+	: m_keyCount{ p_source.KeyCount() }, m_boneCount{ p_source.BoneCount() }
+{
+	const KeyStream translationStreams[3] = { KeyStream::TranslationX, KeyStream::TranslationY, KeyStream::TranslationZ };
+	std::vector<float> translationMinimum;
+	std::vector<float> translationMaximum;
+
+	m_constantPose.assign(m_boneCount, LocalPose{});
+
+	for (size_t bone = 0; bone < m_boneCount && m_keyCount > 0; ++bone)
+	{
+		// Bones out of the mask keep the identity of the constant pose
+		if (!p_bones.Test(bone))
+			continue;
+
+		const std::pair<Vector3F, QuaternionF> firstKey = p_source.LocalAnimFrame(bone, 0);
+		float minimum[3] = { firstKey.first.x, firstKey.first.y, firstKey.first.z };
+		float maximum[3] = { firstKey.first.x, firstKey.first.y, firstKey.first.z };
+		float rotationDeviation = 0.0f;
+
+		for (size_t frame = 1; frame < m_keyCount; ++frame)
+		{
+			for (size_t axis = 0; axis < 3; ++axis)
+			{
+				const float value = p_source.FrameStream(frame, translationStreams[axis])[bone];
+				minimum[axis] = std::min(minimum[axis], value);
+				maximum[axis] = std::max(maximum[axis], value);
+			}
+
+			rotationDeviation = std::max(rotationDeviation, AngleBetween(firstKey.second, p_source.LocalAnimFrame(bone, frame).second));
+		}
+
+		// A constant track is stored once, every key being within the tolerance of the stored value
+		const bool constantTranslation =
+			maximum[0] - minimum[0] <= 2.0f * p_translationTolerance &&
+			maximum[1] - minimum[1] <= 2.0f * p_translationTolerance &&
+			maximum[2] - minimum[2] <= 2.0f * p_translationTolerance;
+
+		if (constantTranslation)
+		{
+			m_constantPose[bone].position = Vector3F{
+				(minimum[0] + maximum[0]) * 0.5f,
+				(minimum[1] + maximum[1]) * 0.5f,
+				(minimum[2] + maximum[2]) * 0.5f };
+		}
+		else
+		{
+			m_translationBones.push_back(static_cast<uint32_t>(bone));
+			translationMinimum.insert(translationMinimum.end(), minimum, minimum + 3);
+			translationMaximum.insert(translationMaximum.end(), maximum, maximum + 3);
+		}
+
+		if (rotationDeviation <= p_rotationTolerance)
+			m_constantPose[bone].rotation = firstKey.second;
+		else
+			m_rotationBones.push_back(static_cast<uint32_t>(bone));
+	}
+
+	m_translationStride = (m_translationBones.size() + g_streamAlignment - 1) / g_streamAlignment * g_streamAlignment;
+	m_rotationStride = (m_rotationBones.size() + g_streamAlignment - 1) / g_streamAlignment * g_streamAlignment;
+	m_keys.assign(m_keyCount * 3 * (m_translationStride + m_rotationStride), 0);
+	m_translationMinimum.assign(3 * m_translationStride, 0.0f);
+	m_translationStep.assign(3 * m_translationStride, 0.0f);
+
+	for (size_t slot = 0; slot < m_translationBones.size(); ++slot)
+	{
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			m_translationMinimum[axis * m_translationStride + slot] = translationMinimum[slot * 3 + axis];
+			m_translationStep[axis * m_translationStride + slot] = (translationMaximum[slot * 3 + axis] - translationMinimum[slot * 3 + axis]) / g_translationQuantization;
+		}
+	}
+
+	for (size_t frame = 0; frame < m_keyCount; ++frame)
+	{
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			const float* source = p_source.FrameStream(frame, translationStreams[axis]);
+			uint16_t* destination = m_keys.data() + StreamOffset(frame, static_cast<CompressedStream>(axis));
+
+			for (size_t slot = 0; slot < m_translationBones.size(); ++slot)
+			{
+				const float step = m_translationStep[axis * m_translationStride + slot];
+				const float normalized = step > 0.0f ? (source[m_translationBones[slot]] - m_translationMinimum[axis * m_translationStride + slot]) / step : 0.0f;
+
+				destination[slot] = static_cast<uint16_t>(std::clamp(normalized, 0.0f, g_translationQuantization) + 0.5f);
+			}
+		}
+
+		const float* rotationX = p_source.FrameStream(frame, KeyStream::RotationX);
+		const float* rotationY = p_source.FrameStream(frame, KeyStream::RotationY);
+		const float* rotationZ = p_source.FrameStream(frame, KeyStream::RotationZ);
+		const float* rotationW = p_source.FrameStream(frame, KeyStream::RotationW);
+		uint16_t* rotation0 = m_keys.data() + StreamOffset(frame, CompressedStream::Rotation0);
+		uint16_t* rotation1 = m_keys.data() + StreamOffset(frame, CompressedStream::Rotation1);
+		uint16_t* rotation2 = m_keys.data() + StreamOffset(frame, CompressedStream::Rotation2);
+
+		for (size_t slot = 0; slot < m_rotationBones.size(); ++slot)
+		{
+			const size_t bone = m_rotationBones[slot];
+			const float rotation[4] = { rotationX[bone], rotationY[bone], rotationZ[bone], rotationW[bone] };
+			uint16_t words[3];
+
+			EncodeRotation(rotation, words);
+			rotation0[slot] = words[0];
+			rotation1[slot] = words[1];
+			rotation2[slot] = words[2];
+		}
+	}
+}
+
+void CompressedClip::SamplePose(const float p_time, LocalPose* p_pose, const size_t p_boneCount, const QuaternionInterpolation p_interpolation) const
+{
+	if (m_keyCount == 0)
+		throw std::out_of_range("Compressed pose unattainable, the clip has no key");
+
+	const size_t boneCount = std::min(p_boneCount, m_boneCount);
+	const size_t beginFrame = static_cast<size_t>(p_time) % m_keyCount;
+	const size_t endFrame = (beginFrame + 1) % m_keyCount;
+	const float alpha = Tools::Utils::GetDecimalPart(p_time);
+
+	// Constant tracks are written by a single copy, the animated ones overwrite it below
+	std::copy_n(m_constantPose.data(), boneCount, p_pose);
+
+	// Animated tracks are sorted by bone, the ones past the buffer are at the end
+	const size_t translationCount = static_cast<size_t>(std::lower_bound(m_translationBones.begin(), m_translationBones.end(), boneCount) - m_translationBones.begin());
+	const size_t rotationCount = static_cast<size_t>(std::lower_bound(m_rotationBones.begin(), m_rotationBones.end(), boneCount) - m_rotationBones.begin());
+
+	const uint16_t* beginTranslationX = m_keys.data() + StreamOffset(beginFrame, CompressedStream::TranslationX);
+	const uint16_t* beginTranslationY = m_keys.data() + StreamOffset(beginFrame, CompressedStream::TranslationY);
+	const uint16_t* beginTranslationZ = m_keys.data() + StreamOffset(beginFrame, CompressedStream::TranslationZ);
+
+	const uint16_t* endTranslationX = m_keys.data() + StreamOffset(endFrame, CompressedStream::TranslationX);
+	const uint16_t* endTranslationY = m_keys.data() + StreamOffset(endFrame, CompressedStream::TranslationY);
+	const uint16_t* endTranslationZ = m_keys.data() + StreamOffset(endFrame, CompressedStream::TranslationZ);
+
+	const float* minimumX = m_translationMinimum.data();
+	const float* minimumY = minimumX + m_translationStride;
+	const float* minimumZ = minimumY + m_translationStride;
+	const float* stepX = m_translationStep.data();
+	const float* stepY = stepX + m_translationStride;
+	const float* stepZ = stepY + m_translationStride;
+
+	// Interpolating the quantized values then dequantizing once is the same as dequantizing both keys
+	const auto lerpQuantized = [alpha](const uint16_t p_begin, const uint16_t p_end)
+	{
+		return static_cast<float>(p_begin) + (static_cast<float>(p_end) - static_cast<float>(p_begin)) * alpha;
+	};
+
+	for (size_t slot = 0; slot < translationCount; ++slot)
+	{
+		Vector3F& position = p_pose[m_translationBones[slot]].position;
+		position.x = minimumX[slot] + lerpQuantized(beginTranslationX[slot], endTranslationX[slot]) * stepX[slot];
+		position.y = minimumY[slot] + lerpQuantized(beginTranslationY[slot], endTranslationY[slot]) * stepY[slot];
+		position.z = minimumZ[slot] + lerpQuantized(beginTranslationZ[slot], endTranslationZ[slot]) * stepZ[slot];
+	}
+
+	const uint16_t* beginRotation0 = m_keys.data() + StreamOffset(beginFrame, CompressedStream::Rotation0);
+	const uint16_t* beginRotation1 = m_keys.data() + StreamOffset(beginFrame, CompressedStream::Rotation1);
+	const uint16_t* beginRotation2 = m_keys.data() + StreamOffset(beginFrame, CompressedStream::Rotation2);
+	const uint16_t* endRotation0 = m_keys.data() + StreamOffset(endFrame, CompressedStream::Rotation0);
+	const uint16_t* endRotation1 = m_keys.data() + StreamOffset(endFrame, CompressedStream::Rotation1);
+	const uint16_t* endRotation2 = m_keys.data() + StreamOffset(endFrame, CompressedStream::Rotation2);
+
+	// Rotations are decoded a few tracks at a time into streams the batch interpolation reads while they are still in L1
+	alignas(32) float begin[4][g_decodeChunk];
+	alignas(32) float end[4][g_decodeChunk];
+	LocalPose chunkPose[g_decodeChunk];
+#if !defined(COMPRESSED_CLIP_SSE2)
+	float* const beginComponents[4] = { begin[0], begin[1], begin[2], begin[3] };
+	float* const endComponents[4] = { end[0], end[1], end[2], end[3] };
+#endif
+
+	for (size_t chunkStart = 0; chunkStart < rotationCount; chunkStart += g_decodeChunk)
+	{
+		const size_t chunkSize = std::min(g_decodeChunk, rotationCount - chunkStart);
+
+#if defined(COMPRESSED_CLIP_SSE2)
+		// Streams are padded to a multiple of the chunk size, the whole chunk can be decoded
+		for (size_t i = 0; i < g_decodeChunk; i += 4)
+		{
+			const size_t slot = chunkStart + i;
+
+			DecodeRotations4(beginRotation0 + slot, beginRotation1 + slot, beginRotation2 + slot, begin, i);
+			DecodeRotations4(endRotation0 + slot, endRotation1 + slot, endRotation2 + slot, end, i);
+		}
+#else
+		for (size_t i = 0; i < chunkSize; ++i)
+		{
+			const size_t slot = chunkStart + i;
+
+			DecodeRotation(beginRotation0[slot], beginRotation1[slot], beginRotation2[slot], beginComponents, i);
+			DecodeRotation(endRotation0[slot], endRotation1[slot], endRotation2[slot], endComponents, i);
+		}
+#endif
+
+		QuaternionBatch::Interpolate(
+			QuaternionStreams{ begin[0], begin[1], begin[2], begin[3] },
+			QuaternionStreams{ end[0], end[1], end[2], end[3] },
+			alpha,
+			chunkPose,
+			chunkSize,
+			p_interpolation);
+
+		for (size_t i = 0; i < chunkSize; ++i)
+			p_pose[m_rotationBones[chunkStart + i]].rotation = chunkPose[i].rotation;
+	}
+}
+
+LocalPose CompressedClip::DecodeKey(const size_t p_boneIndex, const size_t p_frame) const
+{
+	if (p_boneIndex >= m_boneCount)
+		throw std::out_of_range("Compressed key unattainable, p_boneIndex is out of range");
+	if (p_frame >= m_keyCount)
+		throw std::out_of_range("Compressed key unattainable, p_frame is out of range");
+
+	LocalPose pose = m_constantPose[p_boneIndex];
+
+	const auto translation = std::lower_bound(m_translationBones.begin(), m_translationBones.end(), p_boneIndex);
+	if (translation != m_translationBones.end() && *translation == p_boneIndex)
+	{
+		const size_t slot = static_cast<size_t>(translation - m_translationBones.begin());
+
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			const uint16_t quantized = m_keys[StreamOffset(p_frame, static_cast<CompressedStream>(axis)) + slot];
+			(&pose.position.x)[axis] = m_translationMinimum[axis * m_translationStride + slot]
+				+ static_cast<float>(quantized) * m_translationStep[axis * m_translationStride + slot];
+		}
+	}
+
+	const auto rotation = std::lower_bound(m_rotationBones.begin(), m_rotationBones.end(), p_boneIndex);
+	if (rotation != m_rotationBones.end() && *rotation == p_boneIndex)
+	{
+		const size_t slot = static_cast<size_t>(rotation - m_rotationBones.begin());
+		float components[4];
+		float* const streams[4] = { &components[0], &components[1], &components[2], &components[3] };
+
+		DecodeRotation(
+			m_keys[StreamOffset(p_frame, CompressedStream::Rotation0) + slot],
+			m_keys[StreamOffset(p_frame, CompressedStream::Rotation1) + slot],
+			m_keys[StreamOffset(p_frame, CompressedStream::Rotation2) + slot],
+			streams,
+			0);
+		pose.rotation = QuaternionF{ components[0], components[1], components[2], components[3] };
+	}
+
+	return pose;
+}
+
+CompressionReport CompressedClip::MeasureError(const AnimationInfo& p_source, const Skeleton& p_skeleton) const
+{
+	if (p_source.BoneCount() != m_boneCount || p_source.KeyCount() != m_keyCount || p_skeleton.BoneCount() != m_boneCount)
+		throw std::invalid_argument("Compression error unmeasurable, the source or the skeleton doesn't match the clip");
+
+	CompressionReport report;
+	report.sourceMemorySize = p_source.KeyMemorySize();
+	report.compressedMemorySize = MemorySize();
+	report.constantTranslationTrackCount = m_boneCount - m_translationBones.size();
+	report.constantRotationTrackCount = m_boneCount - m_rotationBones.size();
+
+	std::vector<LocalPose> sourcePose(m_boneCount);
+	std::vector<LocalPose> decodedPose(m_boneCount);
+	std::vector<Matrix4F> sourceWorld(m_boneCount);
+	std::vector<Matrix4F> decodedWorld(m_boneCount);
+
+	for (size_t frame = 0; frame < m_keyCount; ++frame)
+	{
+		for (size_t bone = 0; bone < m_boneCount; ++bone)
+		{
+			const std::pair<Vector3F, QuaternionF> sourceKey = p_source.LocalAnimFrame(bone, frame);
+			sourcePose[bone].position = sourceKey.first;
+			sourcePose[bone].rotation = sourceKey.second;
+			decodedPose[bone] = DecodeKey(bone, frame);
+
+			const Vector3F translationError = decodedPose[bone].position - sourcePose[bone].position;
+			report.maxLocalTranslationError = std::max(report.maxLocalTranslationError, translationError.Magnitude());
+			report.maxLocalRotationError = std::max(report.maxLocalRotationError, AngleBetween(sourcePose[bone].rotation, decodedPose[bone].rotation));
+		}
+
+		p_skeleton.ComputeWorldPose(sourcePose.data(), sourceWorld.data());
+		p_skeleton.ComputeWorldPose(decodedPose.data(), decodedWorld.data());
+
+		for (size_t bone = 0; bone < m_boneCount; ++bone)
+		{
+			const float* source = sourceWorld[bone].m_data;
+			const float* decoded = decodedWorld[bone].m_data;
+			const Vector3F positionError{ decoded[3] - source[3], decoded[7] - source[7], decoded[11] - source[11] };
+
+			report.maxWorldPositionError = std::max(report.maxWorldPositionError, positionError.Magnitude());
+		}
+	}
+
+	return report;
+}
+
+size_t CompressedClip::KeyCount() const
+{
+	return m_keyCount;
+}
+
+size_t CompressedClip::BoneCount() const
+{
+	return m_boneCount;
+}
+
+size_t CompressedClip::AnimatedTranslationCount() const
+{
+	return m_translationBones.size();
+}
+
+size_t CompressedClip::AnimatedRotationCount() const
+{
+	return m_rotationBones.size();
+}
+
+size_t CompressedClip::MemorySize() const
+{
+	return m_keys.size() * sizeof(uint16_t)
+		+ (m_translationMinimum.size() + m_translationStep.size()) * sizeof(float)
+		+ (m_translationBones.size() + m_rotationBones.size()) * sizeof(uint32_t)
+		+ m_constantPose.size() * sizeof(LocalPose);
+}
+
+size_t CompressedClip::StreamOffset(const size_t p_frame, const CompressedStream p_stream) const
+{
+	const size_t stream = static_cast<size_t>(p_stream);
+	const size_t frameOffset = p_frame * 3 * (m_translationStride + m_rotationStride);
+
+	// Translation streams hold one value per animated translation track, rotation streams one per animated rotation track
+	if (p_stream < CompressedStream::Rotation0)
+		return frameOffset + stream * m_translationStride;
+
+	return frameOffset + 3 * m_translationStride + (stream - static_cast<size_t>(CompressedStream::Rotation0)) * m_rotationStride;
+}
@@ -0,0 +1,368 @@
+#include <Animation/Crowd.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+	constexpr size_t g_blockSize = 16;
+
+	/**
+	 * @brief Set in the LOD level of an instance that hasn't been evaluated at this level yet.
+	 */
+	constexpr uint8_t g_lodChangedBit = 0x80;
+
+	/**
+	 * @brief What the update did with an instance of the block being updated.
+	 */
+	enum InstanceState : uint8_t
+	{
+		Skipped,
+		Sampled
+	};
+}
+
+Crowd::Crowd(std::shared_ptr<const Skeleton> p_skeleton, const ClipRegistry& p_clips, const SkinningPaletteMode p_paletteMode)
+	: m_skeleton{ std::move(p_skeleton) }, m_clips{ p_clips }, m_paletteMode{ p_paletteMode }
+{
+	if (m_skeleton == nullptr)
+		throw std::invalid_argument("Crowd can't be created without a skeleton");
+
+	m_paletteStride = SkinningPalette::BlockCount(m_paletteMode, m_skeleton->BoneCount()) * g_blockSize;
+	ResizeScratch(1);
+}
+
+CrowdInstanceId Crowd::Spawn(const ClipId p_clipId, const float p_time, const float p_speedFactor)
+{
+	CheckClip(p_clipId);
+
+	const float keyCount = static_cast<float>(m_clips.Clip(p_clipId).KeyCount());
+
+	m_clipIds.push_back(p_clipId);
+	m_times.push_back(std::fmod(std::fmod(p_time, keyCount) + keyCount, keyCount));
+	m_speedFactors.push_back(p_speedFactor);
+	m_lodLevels.push_back(g_lodChangedBit);
+	m_palettes.resize(m_palettes.size() + m_paletteStride, 0.0f);
+	m_ikTargets.resize(m_ikTargets.size() + m_ikChains.size(), Vector3F{ 0.0f, 0.0f, 0.0f });
+	m_ikWeights.resize(m_ikWeights.size() + m_ikChains.size(), 0.0f);
+
+	return static_cast<CrowdInstanceId>(m_clipIds.size() - 1);
+}
+
+void Crowd::Clear()
+{
+	m_clipIds.clear();
+	m_times.clear();
+	m_speedFactors.clear();
+	m_lodLevels.clear();
+	m_palettes.clear();
+	m_ikTargets.clear();
+	m_ikWeights.clear();
+}
+
+size_t Crowd::Count() const
+{
+	return m_clipIds.size();
+}
+
+void Crowd::PlayClip(const CrowdInstanceId p_instance, const ClipId p_clipId)
+{
+	CheckClip(p_clipId);
+
+	m_clipIds[p_instance] = p_clipId;
+	m_times[p_instance] = 0.0f;
+}
+
+void Crowd::SetSpeedFactor(const CrowdInstanceId p_instance, const float p_speedFactor)
+{
+	m_speedFactors[p_instance] = p_speedFactor;
+}
+
+ClipId Crowd::Clip(const CrowdInstanceId p_instance) const
+{
+	return m_clipIds[p_instance];
+}
+
+float Crowd::Time(const CrowdInstanceId p_instance) const
+{
+	return m_times[p_instance];
+}
+
+float Crowd::SpeedFactor(const CrowdInstanceId p_instance) const
+{
+	return m_speedFactors[p_instance];
+}
+
+void Crowd::SetCompressedClips(const std::vector<CompressedClip>* p_compressedClips)
+{
+	m_compressedClips = p_compressedClips;
+}
+
+void Crowd::SetLod(const AnimationLod* p_lod)
+{
+	if (p_lod != nullptr && p_lod->LevelCount() >= g_lodChangedBit)
+		throw std::invalid_argument("Crowd can't use the LOD, it has too many levels");
+
+	m_lod = p_lod;
+	m_lodLevels.assign(Count(), g_lodChangedBit);
+}
+
+void Crowd::AssignLods(const float* p_metrics)
+{
+	for (size_t instance = 0; instance < Count(); ++instance)
+	{
+		const uint8_t level = static_cast<uint8_t>(m_lod != nullptr ? m_lod->SelectLevel(p_metrics[instance]) : 0);
+
+		if ((m_lodLevels[instance] & ~g_lodChangedBit) != level)
+			m_lodLevels[instance] = level | g_lodChangedBit;
+	}
+}
+
+size_t Crowd::Lod(const CrowdInstanceId p_instance) const
+{
+	return m_lodLevels[p_instance] & ~g_lodChangedBit;
+}
+
+IkLimbId Crowd::AddIkLimb(const IkChain& p_chain, const Vector3F& p_poleOffset)
+{
+	const size_t boneCount = m_skeleton->BoneCount();
+	if (p_chain.upper >= boneCount || p_chain.middle >= boneCount || p_chain.end >= boneCount)
+		throw std::out_of_range("Crowd can't add the IK limb, a bone of the chain isn't in the skeleton");
+
+	// The targets of the instances are moved to make room for the new limb
+	const size_t limbCount = m_ikChains.size();
+	std::vector<Vector3F> targets(Count() * (limbCount + 1), Vector3F{ 0.0f, 0.0f, 0.0f });
+	std::vector<float> weights(Count() * (limbCount + 1), 0.0f);
+
+	for (size_t instance = 0; instance < Count(); ++instance)
+	{
+		std::copy_n(m_ikTargets.begin() + instance * limbCount, limbCount, targets.begin() + instance * (limbCount + 1));
+		std::copy_n(m_ikWeights.begin() + instance * limbCount, limbCount, weights.begin() + instance * (limbCount + 1));
+	}
+
+	m_ikChains.push_back(p_chain);
+	m_ikPoleOffsets.push_back(p_poleOffset);
+	m_ikTargets = std::move(targets);
+	m_ikWeights = std::move(weights);
+	ResizeScratch(m_scratch.size());
+
+	return static_cast<IkLimbId>(limbCount);
+}
+
+void Crowd::ClearIkLimbs()
+{
+	m_ikChains.clear();
+	m_ikPoleOffsets.clear();
+	m_ikTargets.clear();
+	m_ikWeights.clear();
+	ResizeScratch(m_scratch.size());
+}
+
+size_t Crowd::IkLimbCount() const
+{
+	return m_ikChains.size();
+}
+
+void Crowd::SetIkTarget(const CrowdInstanceId p_instance, const IkLimbId p_limb, const Vector3F& p_target, const float p_weight)
+{
+	const size_t index = p_instance * m_ikChains.size() + p_limb;
+	m_ikTargets[index] = p_target;
+	m_ikWeights[index] = p_weight;
+}
+
+void Crowd::SetPaletteMode(const SkinningPaletteMode p_mode)
+{
+	m_paletteMode = p_mode;
+	m_paletteStride = SkinningPalette::BlockCount(m_paletteMode, m_skeleton->BoneCount()) * g_blockSize;
+	m_palettes.assign(Count() * m_paletteStride, 0.0f);
+}
+
+SkinningPaletteMode Crowd::GetPaletteMode() const
+{
+	return m_paletteMode;
+}
+
+void Crowd::Update(const float p_deltaTime, const float p_speed)
+{
+	m_deltaTime = p_deltaTime;
+	m_speed = p_speed;
+	++m_frameIndex;
+	UpdateRange(0, Count(), m_scratch[0]);
+}
+
+void Crowd::Update(const float p_deltaTime, const float p_speed, Jobs::JobSystem& p_jobs, Jobs::JobCounter& p_counter)
+{
+	m_deltaTime = p_deltaTime;
+	m_speed = p_speed;
+	++m_frameIndex;
+	ResizeScratch(p_jobs.ThreadCount());
+	p_jobs.DispatchRange(Count(), updateGrainSize, m_updateJob, p_counter);
+}
+
+const float* Crowd::Palette(const CrowdInstanceId p_instance) const
+{
+	return &m_palettes[p_instance * m_paletteStride];
+}
+
+size_t Crowd::PaletteBlockCount() const
+{
+	return m_paletteStride / g_blockSize;
+}
+
+void Crowd::UpdateJob::operator()(const size_t p_begin, const size_t p_end) const
+{
+	crowd->UpdateRange(p_begin, p_end, crowd->m_scratch[Jobs::JobSystem::ThreadIndex()]);
+}
+
+void Crowd::UpdateRange(const size_t p_begin, const size_t p_end, Scratch& p_scratch)
+{
+	const Skeleton& skeleton = *m_skeleton;
+	const size_t boneCount = skeleton.BoneCount();
+	const size_t limbCount = m_ikChains.size();
+	const bool dualQuaternions = m_paletteMode == SkinningPaletteMode::DualQuaternion;
+
+	// Without IK limbs, a block is a single instance and every instance is evaluated in the same scratch pose
+	const size_t blockSize = limbCount > 0 ? updateGrainSize : 1;
+
+	// Every instance only reads shared data and writes its own state and palette, the result doesn't depend on how the range is split
+	for (size_t blockBegin = p_begin; blockBegin < p_end; blockBegin += blockSize)
+	{
+		const size_t blockEnd = std::min(blockBegin + blockSize, p_end);
+		p_scratch.ik.Clear();
+
+		for (size_t instance = blockBegin; instance < blockEnd; ++instance)
+		{
+			const size_t slot = instance - blockBegin;
+			p_scratch.states[slot] = Skipped;
+
+			if (!AdvanceInstance(instance))
+				continue;
+
+			LocalPose* localPose = &p_scratch.localPose[slot * boneCount];
+			Matrix4F* worldPose = &p_scratch.worldPose[slot * boneCount];
+			DualQuaternion* worldDualQuaternions = &p_scratch.worldDualQuaternions[slot * boneCount];
+			SampleInstance(instance, localPose);
+			ComputeWorldPose(localPose, worldPose, worldDualQuaternions);
+			p_scratch.states[slot] = Sampled;
+
+			p_scratch.ik.AddCharacter(skeleton, localPose, worldPose, dualQuaternions ? worldDualQuaternions : nullptr, m_ikChains, [this, instance, limbCount](const size_t p_limb)
+			{
+				const size_t index = instance * limbCount + p_limb;
+				return IkGoal{ m_ikTargets[index], m_ikPoleOffsets[p_limb], m_ikWeights[index] };
+			});
+		}
+
+		p_scratch.ik.SolveCharacters();
+
+		for (size_t instance = blockBegin; instance < blockEnd; ++instance)
+		{
+			const size_t slot = instance - blockBegin;
+			if (p_scratch.states[slot] == Skipped)
+				continue;
+
+			const Matrix4F* worldPose = &p_scratch.worldPose[slot * boneCount];
+			const DualQuaternion* worldDualQuaternions = &p_scratch.worldDualQuaternions[slot * boneCount];
+			float* palette = &m_palettes[instance * m_paletteStride];
+
+			if (dualQuaternions)
+				SkinningPalette::Write(skeleton, worldDualQuaternions, palette);
+			else
+				SkinningPalette::Write(skeleton, worldPose, m_paletteMode, palette);
+		}
+	}
+}
+
+bool Crowd::AdvanceInstance(const size_t p_instance)
+{
+	const float keyCount = static_cast<float>(m_clips.Clip(m_clipIds[p_instance]).KeyCount());
+
+	// Times stay within the clip: a time growing without bound would lose the precision of its decimal part
+	float time = std::fmod(m_times[p_instance] + m_deltaTime * m_speed * m_speedFactors[p_instance], keyCount);
+	if (time < 0.0f)
+		time += keyCount;
+	m_times[p_instance] = time;
+
+	if (m_lod == nullptr)
+		return true;
+
+	// Instances of a level are spread over its interval by their index, so that each frame evaluates the same share of them
+	const uint8_t lodState = m_lodLevels[p_instance];
+	const size_t level = lodState & ~g_lodChangedBit;
+
+	if (level >= m_lod->LevelCount())
+		return false;
+	if ((lodState & g_lodChangedBit) == 0 && (m_frameIndex + p_instance) % m_lod->UpdateInterval(level) != 0)
+		return false;
+
+	m_lodLevels[p_instance] = static_cast<uint8_t>(level);
+	return true;
+}
+
+void Crowd::SampleInstance(const size_t p_instance, LocalPose* p_pose) const
+{
+	const ClipId clipId = m_clipIds[p_instance];
+	const size_t boneCount = m_skeleton->BoneCount();
+
+	if (m_lod != nullptr)
+		SamplePose(static_cast<CrowdInstanceId>(p_instance), m_lodLevels[p_instance], p_pose);
+	else if (m_compressedClips != nullptr && clipId < m_compressedClips->size())
+		(*m_compressedClips)[clipId].SamplePose(m_times[p_instance], p_pose, boneCount);
+	else
+		m_clips.Clip(clipId).SamplePose(m_times[p_instance], p_pose, boneCount);
+}
+
+void Crowd::SamplePose(const CrowdInstanceId p_instance, const size_t p_level, LocalPose* p_pose) const
+{
+	const ClipId clipId = m_clipIds[p_instance];
+	const float time = m_times[p_instance];
+	const size_t boneCount = m_skeleton->BoneCount();
+	const std::vector<CompressedClip>& levelClips = m_lod->Clips(p_level);
+
+	// The compressed clips of the level hold the bones out of it as constant tracks, the keys are only read for the bones of the level
+	if (m_compressedClips != nullptr && clipId < levelClips.size())
+	{
+		levelClips[clipId].SamplePose(time, p_pose, boneCount);
+		return;
+	}
+
+	const BoneMask& bones = m_lod->Bones(p_level);
+	m_clips.Clip(clipId).SamplePose(time, bones, p_pose, boneCount);
+
+	for (size_t begin = bones.FindNext(0, false); begin < boneCount;)
+	{
+		const size_t end = std::min(bones.FindNext(begin, true), boneCount);
+		std::fill(p_pose + begin, p_pose + end, LocalPose{});
+		begin = bones.FindNext(end, false);
+	}
+}
+
+void Crowd::ComputeWorldPose(const LocalPose* p_localPose, Matrix4F* p_worldPose, DualQuaternion* p_worldDualQuaternions) const
+{
+	if (m_paletteMode == SkinningPaletteMode::DualQuaternion)
+		m_skeleton->ComputeWorldPose(p_localPose, p_worldDualQuaternions);
+	else
+		m_skeleton->ComputeWorldPose(p_localPose, p_worldPose);
+}
+
+void Crowd::ResizeScratch(const size_t p_threadCount)
+{
+	const size_t blockSize = m_ikChains.empty() ? 1 : updateGrainSize;
+	const size_t poseSize = blockSize * m_skeleton->BoneCount();
+
+	m_scratch.resize(std::max(m_scratch.size(), p_threadCount));
+
+	for (Scratch& scratch : m_scratch)
+	{
+		scratch.localPose.resize(poseSize);
+		scratch.worldPose.resize(poseSize);
+		scratch.worldDualQuaternions.resize(poseSize);
+		scratch.states.resize(blockSize);
+	}
+}
+
+void Crowd::CheckClip(const ClipId p_clipId) const
+{
+	if (p_clipId >= m_clips.Count() || m_clips.Clip(p_clipId).KeyCount() == 0)
+		throw std::out_of_range("Crowd instance can't play the clip, it isn't registered or has no key");
+}
@@ -0,0 +1,120 @@
+#include <Animation/DualQuaternion.h>
+#include <cmath>
+
+namespace
+{
+	/**
+	 * @brief Hamilton product of two quaternions stored x, y, z, w.
+	 * @param p_left The left quaternion
+	 * @param p_right The right quaternion
+	 * @return The product
+	 */
+	Vector4F MultiplyQuaternion(const Vector4F& p_left, const Vector4F& p_right)
+	{
+		return Vector4F{
+			p_left.w * p_right.x + p_left.x * p_right.w + p_left.y * p_right.z - p_left.z * p_right.y,
+			p_left.w * p_right.y - p_left.x * p_right.z + p_left.y * p_right.w + p_left.z * p_right.x,
+			p_left.w * p_right.z + p_left.x * p_right.y - p_left.y * p_right.x + p_left.z * p_right.w,
+			p_left.w * p_right.w - p_left.x * p_right.x - p_left.y * p_right.y - p_left.z * p_right.z };
+	}
+}
+
+DualQuaternion DualQuaternion::FromRotationTranslation(const QuaternionF& p_rotation, const Vector3F& p_translation)
+{
+	DualQuaternion result;
+	result.real = Vector4F{ p_rotation.axis.x, p_rotation.axis.y, p_rotation.axis.z, p_rotation.w };
+
+	const Vector4F halfTranslation{ p_translation.x * 0.5f, p_translation.y * 0.5f, p_translation.z * 0.5f, 0.0f };
+	result.dual = MultiplyQuaternion(halfTranslation, result.real);
+
+	return result;
+}
+
+DualQuaternion DualQuaternion::Multiply(const DualQuaternion& p_left, const DualQuaternion& p_right)
+{
+	const Vector4F leftRealRightDual = MultiplyQuaternion(p_left.real, p_right.dual);
+	const Vector4F leftDualRightReal = MultiplyQuaternion(p_left.dual, p_right.real);
+
+	DualQuaternion result;
+	result.real = MultiplyQuaternion(p_left.real, p_right.real);
+	result.dual = Vector4F{
+		leftRealRightDual.x + leftDualRightReal.x,
+		leftRealRightDual.y + leftDualRightReal.y,
+		leftRealRightDual.z + leftDualRightReal.z,
+		leftRealRightDual.w + leftDualRightReal.w };
+
+	return result;
+}
+
+DualQuaternion DualQuaternion::InverseRigid(const DualQuaternion& p_dualQuaternion)
+{
+	DualQuaternion result;
+	result.real = Vector4F{ -p_dualQuaternion.real.x, -p_dualQuaternion.real.y, -p_dualQuaternion.real.z, p_dualQuaternion.real.w };
+	result.dual = Vector4F{ -p_dualQuaternion.dual.x, -p_dualQuaternion.dual.y, -p_dualQuaternion.dual.z, p_dualQuaternion.dual.w };
+
+	return result;
+}
+
+Vector3F DualQuaternion::Translation(const DualQuaternion& p_dualQuaternion)
+{
+	// t = 2 * dual * conjugate(real)
+	const Vector4F& r = p_dualQuaternion.real;
+	const Vector4F& d = p_dualQuaternion.dual;
+
+	return Vector3F{
+		2.0f * (r.w * d.x - d.w * r.x + r.y * d.z - r.z * d.y),
+		2.0f * (r.w * d.y - d.w * r.y + r.z * d.x - r.x * d.z),
+		2.0f * (r.w * d.z - d.w * r.z + r.x * d.y - r.y * d.x) };
+}
+
+Vector3F DualQuaternion::TransformPoint(const DualQuaternion& p_dualQuaternion, const Vector3F& p_point)
+{
+	const Vector4F& r = p_dualQuaternion.real;
+
+	// p + 2 * cross(r.xyz, cross(r.xyz, p) + r.w * p)
+	const float crossX = r.y * p_point.z - r.z * p_point.y + r.w * p_point.x;
+	const float crossY = r.z * p_point.x - r.x * p_point.z + r.w * p_point.y;
+	const float crossZ = r.x * p_point.y - r.y * p_point.x + r.w * p_point.z;
+
+	const Vector3F translation = Translation(p_dualQuaternion);
+
+	return Vector3F{
+		p_point.x + 2.0f * (r.y * crossZ - r.z * crossY) + translation.x,
+		p_point.y + 2.0f * (r.z * crossX - r.x * crossZ) + translation.y,
+		p_point.z + 2.0f * (r.x * crossY - r.y * crossX) + translation.z };
+}
+
+Vector3F DualQuaternion::SkinPoint(const DualQuaternion* p_palette,
+	const int p_boneIndices[4],
+	const float p_boneWeights[4],
+	const Vector3F& p_point)
+{
+	const Vector4F& pivot = p_palette[p_boneIndices[0]].real;
+	DualQuaternion blended;
+	blended.real = Vector4F{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+	for (int i = 0; i < 4; ++i)
+	{
+		const DualQuaternion& bone = p_palette[p_boneIndices[i]];
+		const float hemisphere = pivot.x * bone.real.x + pivot.y * bone.real.y + pivot.z * bone.real.z + pivot.w * bone.real.w;
+		const float weight = hemisphere < 0.0f ? -p_boneWeights[i] : p_boneWeights[i];
+
+		blended.real.x += bone.real.x * weight;
+		blended.real.y += bone.real.y * weight;
+		blended.real.z += bone.real.z * weight;
+		blended.real.w += bone.real.w * weight;
+		blended.dual.x += bone.dual.x * weight;
+		blended.dual.y += bone.dual.y * weight;
+		blended.dual.z += bone.dual.z * weight;
+		blended.dual.w += bone.dual.w * weight;
+	}
+
+	const float inverseLength = 1.0f / std::sqrt(
+		blended.real.x * blended.real.x + blended.real.y * blended.real.y +
+		blended.real.z * blended.real.z + blended.real.w * blended.real.w);
+
+	blended.real = Vector4F{ blended.real.x * inverseLength, blended.real.y * inverseLength, blended.real.z * inverseLength, blended.real.w * inverseLength };
+	blended.dual = Vector4F{ blended.dual.x * inverseLength, blended.dual.y * inverseLength, blended.dual.z * inverseLength, blended.dual.w * inverseLength };
+
+	return TransformPoint(blended, p_point);
+}
@@ -0,0 +1,111 @@
+#include <Animation/LayerStack.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+	/**
+	 * @brief Move the bones of a mask towards a sampled pose: lerp of the translations, nlerp of the rotations on the shortest path.
+	 */
+	void BlendMaskedPose(const LocalPose* p_source, const BoneMask& p_mask, const float p_weight, LocalPose* p_pose, const size_t p_boneCount)
+	{
+		p_mask.ForEachRange([&](const size_t p_begin, const size_t p_end)
+		{
+			for (size_t i = p_begin; i < std::min(p_end, p_boneCount); ++i)
+			{
+				const LocalPose& source = p_source[i];
+				LocalPose& pose = p_pose[i];
+
+				pose.position.x += (source.position.x - pose.position.x) * p_weight;
+				pose.position.y += (source.position.y - pose.position.y) * p_weight;
+				pose.position.z += (source.position.z - pose.position.z) * p_weight;
+
+				// Shortest path: the source is taken on the hemisphere of the pose
+				const bool opposite = QuaternionF::DotProduct(pose.rotation, source.rotation) < 0.0f;
+				pose.rotation = QuaternionF::Nlerp(pose.rotation, opposite ? source.rotation * -1.0f : source.rotation, p_weight);
+			}
+		});
+	}
+}
+
+LayerStack::LayerStack(const ClipRegistry& p_clips, const std::vector<std::optional<AdditiveClip>>& p_additiveClips)
+	: m_clips{ p_clips }, m_additiveClips{ p_additiveClips }
+{
+}
+
+LayerId LayerStack::AddLayer(const ClipId p_clipId, const LayerBlendMode p_mode, const BoneMask& p_mask, const float p_weight)
+{
+	if (p_clipId >= m_clips.Count() || m_clips.Clip(p_clipId).KeyCount() == 0)
+		throw std::out_of_range("Layer can't play the clip, it isn't registered or has no key");
+	if (p_mode == LayerBlendMode::Additive && (p_clipId >= m_additiveClips.size() || !m_additiveClips[p_clipId].has_value()))
+		throw std::out_of_range("Layer can't add the clip, it has no additive copy");
+
+	m_layers.push_back({ p_clipId, p_mode, p_mask, p_weight, 0.0f });
+	m_scratch.resize(std::max(m_scratch.size(), p_mask.BoneCount()));
+
+	return static_cast<LayerId>(m_layers.size() - 1);
+}
+
+void LayerStack::Clear()
+{
+	m_layers.clear();
+}
+
+size_t LayerStack::Count() const
+{
+	return m_layers.size();
+}
+
+void LayerStack::SetWeight(const LayerId p_layer, const float p_weight)
+{
+	m_layers[p_layer].weight = p_weight;
+}
+
+float LayerStack::Weight(const LayerId p_layer) const
+{
+	return m_layers[p_layer].weight;
+}
+
+const BoneMask& LayerStack::Mask(const LayerId p_layer) const
+{
+	return m_layers[p_layer].mask;
+}
+
+void LayerStack::Advance(const float p_keyCount)
+{
+	for (Layer& layer : m_layers)
+	{
+		// Times stay within the clip, like the crowd instances
+		const float keyCount = static_cast<float>(m_clips.Clip(layer.clipId).KeyCount());
+		layer.time = std::fmod(layer.time + p_keyCount, keyCount);
+		if (layer.time < 0.0f)
+			layer.time += keyCount;
+	}
+}
+
+void LayerStack::Apply(LocalPose* p_pose, const size_t p_boneCount)
+{
+	const size_t boneCount = std::min(p_boneCount, m_scratch.size());
+
+	for (const Layer& layer : m_layers)
+	{
+		if (layer.weight <= 0.0f)
+			continue;
+
+		if (layer.mode == LayerBlendMode::Additive)
+		{
+			m_additiveClips[layer.clipId]->Apply(layer.time, layer.mask, layer.weight, p_pose, m_scratch.data(), boneCount);
+		}
+		else if (layer.weight >= 1.0f)
+		{
+			// A full override only replaces the bones of the mask
+			m_clips.Clip(layer.clipId).SamplePose(layer.time, layer.mask, p_pose, boneCount);
+		}
+		else
+		{
+			m_clips.Clip(layer.clipId).SamplePose(layer.time, layer.mask, m_scratch.data(), boneCount);
+			BlendMaskedPose(m_scratch.data(), layer.mask, layer.weight, p_pose, boneCount);
+		}
+	}
+}
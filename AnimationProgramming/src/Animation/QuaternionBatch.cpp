@@ -0,0 +1,295 @@
+#include <Animation/QuaternionBatch.h>
+#include <cmath>
+
+namespace
+{
+	/**
+	 * @brief Correct the interpolation factor of a nlerp so it follows slerp. Polynomial fitted by Arseny Kapoulkine ("Approximating slerp", 2015).
+	 * @param p_alpha The interpolation factor
+	 * @param p_cosine The absolute cosine of the half angle between the two keys
+	 * @return The corrected factor
+	 */
+	float CorrectAlpha(const float p_alpha, const float p_cosine)
+	{
+		const float a = 1.0904f + p_cosine * (-3.2452f + p_cosine * (3.55645f - p_cosine * 1.43519f));
+		const float b = 0.848013f + p_cosine * (-1.06021f + p_cosine * 0.215638f);
+		const float centered = p_alpha - 0.5f;
+		const float k = a * centered * centered + b;
+
+		return p_alpha + p_alpha * centered * (p_alpha - 1.0f) * k;
+	}
+
+	/**
+	 * @brief Lerp one pair of normalized quaternions along the shortest path, components x, y, z, w, without normalizing the result.
+	 * @param p_begin The start quaternion
+	 * @param p_end The end quaternion
+	 * @param p_alpha The interpolation factor
+	 * @param p_mode The interpolation used
+	 * @param p_result The result, it may be p_begin
+	 */
+	void LerpComponents(const float p_begin[4], const float p_end[4], const float p_alpha, const QuaternionInterpolation p_mode, float p_result[4])
+	{
+		float end[4] = { p_end[0], p_end[1], p_end[2], p_end[3] };
+		float cosine = p_begin[0] * end[0] + p_begin[1] * end[1] + p_begin[2] * end[2] + p_begin[3] * end[3];
+
+		// Shortest path
+		if (cosine < 0.0f)
+		{
+			for (float& component : end)
+				component = -component;
+			cosine = -cosine;
+		}
+
+		const float alpha = p_mode == QuaternionInterpolation::ApproximateSlerp && cosine < QuaternionBatch::nlerpFastPathCosine
+			? CorrectAlpha(p_alpha, cosine)
+			: p_alpha;
+
+		for (size_t component = 0; component < 4; ++component)
+			p_result[component] = p_begin[component] + (end[component] - p_begin[component]) * alpha;
+	}
+
+	void NormalizeComponents(float p_components[4])
+	{
+		const float inverseLength = 1.0f / std::sqrt(p_components[0] * p_components[0] + p_components[1] * p_components[1]
+			+ p_components[2] * p_components[2] + p_components[3] * p_components[3]);
+
+		for (size_t component = 0; component < 4; ++component)
+			p_components[component] *= inverseLength;
+	}
+
+	/**
+	 * @brief Read one quaternion of a set of streams.
+	 */
+	void LoadComponents(const QuaternionStreams& p_streams, const size_t p_index, float p_components[4])
+	{
+		p_components[0] = p_streams.x[p_index];
+		p_components[1] = p_streams.y[p_index];
+		p_components[2] = p_streams.z[p_index];
+		p_components[3] = p_streams.w[p_index];
+	}
+
+	/**
+	 * @brief Write a quaternion in the rotation of a pose.
+	 */
+	void StoreComponents(const float p_components[4], LocalPose& p_pose)
+	{
+		p_pose.rotation.axis.x = p_components[0];
+		p_pose.rotation.axis.y = p_components[1];
+		p_pose.rotation.axis.z = p_components[2];
+		p_pose.rotation.w = p_components[3];
+	}
+
+#if defined(GPM_SIMD_SSE)
+	/**
+	 * @brief Components of 4 quaternions, one register per component.
+	 */
+	struct QuaternionLanes final
+	{
+		__m128 x;
+		__m128 y;
+		__m128 z;
+		__m128 w;
+	};
+
+	QuaternionLanes LoadLanes(const QuaternionStreams& p_streams, const size_t p_index)
+	{
+		return { _mm_loadu_ps(p_streams.x + p_index), _mm_loadu_ps(p_streams.y + p_index), _mm_loadu_ps(p_streams.z + p_index), _mm_loadu_ps(p_streams.w + p_index) };
+	}
+
+	void StoreLanes(const QuaternionLanes& p_lanes, LocalPose* p_pose)
+	{
+		alignas(16) float resultX[4];
+		alignas(16) float resultY[4];
+		alignas(16) float resultZ[4];
+		alignas(16) float resultW[4];
+		_mm_store_ps(resultX, p_lanes.x);
+		_mm_store_ps(resultY, p_lanes.y);
+		_mm_store_ps(resultZ, p_lanes.z);
+		_mm_store_ps(resultW, p_lanes.w);
+
+		for (size_t lane = 0; lane < 4; ++lane)
+		{
+			QuaternionF& rotation = p_pose[lane].rotation;
+			rotation.axis.x = resultX[lane];
+			rotation.axis.y = resultY[lane];
+			rotation.axis.z = resultZ[lane];
+			rotation.w = resultW[lane];
+		}
+	}
+
+	/**
+	 * @brief Lerp 4 pairs of normalized quaternions along the shortest path, same result as LerpComponents.
+	 * @param p_begin The start quaternions
+	 * @param p_end The end quaternions
+	 * @param p_alpha The interpolation factor of each pair
+	 * @param p_correct True to follow slerp (ApproximateSlerp), false for Nlerp
+	 * @return The quaternions, not normalized
+	 */
+	QuaternionLanes LerpLanes(const QuaternionLanes& p_begin, QuaternionLanes p_end, const __m128 p_alpha, const bool p_correct)
+	{
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 fastPathCosine = _mm_set1_ps(QuaternionBatch::nlerpFastPathCosine);
+
+		const __m128 dot = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(p_begin.x, p_end.x), _mm_mul_ps(p_begin.y, p_end.y)),
+			_mm_add_ps(_mm_mul_ps(p_begin.z, p_end.z), _mm_mul_ps(p_begin.w, p_end.w)));
+
+		// Shortest path: flip the end quaternion with the sign bit of the dot product
+		const __m128 dotSign = _mm_and_ps(dot, signMask);
+		p_end.x = _mm_xor_ps(p_end.x, dotSign);
+		p_end.y = _mm_xor_ps(p_end.y, dotSign);
+		p_end.z = _mm_xor_ps(p_end.z, dotSign);
+		p_end.w = _mm_xor_ps(p_end.w, dotSign);
+
+		__m128 laneAlpha = p_alpha;
+
+		if (p_correct)
+		{
+			const __m128 cosine = _mm_andnot_ps(signMask, dot);
+
+			// The correction is skipped when every key pair of the group is close enough for nlerp
+			if (_mm_movemask_ps(_mm_cmplt_ps(cosine, fastPathCosine)) != 0)
+			{
+				const __m128 a = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(cosine,
+					_mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(cosine,
+						_mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(cosine, _mm_set1_ps(1.43519f)))))));
+				const __m128 b = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(cosine,
+					_mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(cosine, _mm_set1_ps(0.215638f)))));
+				const __m128 centered = _mm_sub_ps(p_alpha, _mm_set1_ps(0.5f));
+				const __m128 alphaPolynomial = _mm_mul_ps(_mm_mul_ps(p_alpha, centered), _mm_sub_ps(p_alpha, _mm_set1_ps(1.0f)));
+				const __m128 k = _mm_add_ps(_mm_mul_ps(a, _mm_mul_ps(centered, centered)), b);
+				const __m128 corrected = _mm_add_ps(p_alpha, _mm_mul_ps(alphaPolynomial, k));
+
+				laneAlpha = _mm_or_ps(
+					_mm_and_ps(_mm_cmplt_ps(cosine, fastPathCosine), corrected),
+					_mm_andnot_ps(_mm_cmplt_ps(cosine, fastPathCosine), p_alpha));
+			}
+		}
+
+		return {
+			_mm_add_ps(p_begin.x, _mm_mul_ps(_mm_sub_ps(p_end.x, p_begin.x), laneAlpha)),
+			_mm_add_ps(p_begin.y, _mm_mul_ps(_mm_sub_ps(p_end.y, p_begin.y), laneAlpha)),
+			_mm_add_ps(p_begin.z, _mm_mul_ps(_mm_sub_ps(p_end.z, p_begin.z), laneAlpha)),
+			_mm_add_ps(p_begin.w, _mm_mul_ps(_mm_sub_ps(p_end.w, p_begin.w), laneAlpha)) };
+	}
+
+	QuaternionLanes NormalizeLanes(const QuaternionLanes& p_lanes)
+	{
+		const __m128 x = p_lanes.x;
+		const __m128 y = p_lanes.y;
+		const __m128 z = p_lanes.z;
+		const __m128 w = p_lanes.w;
+
+		// Reciprocal square root estimate refined by one Newton-Raphson step
+		const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+		const __m128 estimate = _mm_rsqrt_ps(lengthSquared);
+		const __m128 inverseLength = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), estimate),
+			_mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(lengthSquared, estimate), estimate)));
+
+		return { _mm_mul_ps(x, inverseLength), _mm_mul_ps(y, inverseLength), _mm_mul_ps(z, inverseLength), _mm_mul_ps(w, inverseLength) };
+	}
+#endif
+
+	/**
+	 * @brief Interpolate p_count pairs, with one factor shared by every pair or one factor per pair.
+	 * @param p_alpha The shared interpolation factor, used when p_alphas is null
+	 * @param p_alphas The interpolation factor of each pair, or null
+	 */
+	void InterpolatePairs(const QuaternionStreams& p_begin,
+		const QuaternionStreams& p_end,
+		const float p_alpha,
+		const float* p_alphas,
+		LocalPose* p_pose,
+		const size_t p_count,
+		const QuaternionInterpolation p_mode)
+	{
+		size_t i = 0;
+
+#if defined(GPM_SIMD_SSE)
+		const __m128 sharedAlpha = _mm_set1_ps(p_alpha);
+		const bool correct = p_mode == QuaternionInterpolation::ApproximateSlerp;
+
+		for (; i + 4 <= p_count; i += 4)
+		{
+			const __m128 alpha = p_alphas != nullptr ? _mm_loadu_ps(p_alphas + i) : sharedAlpha;
+			StoreLanes(NormalizeLanes(LerpLanes(LoadLanes(p_begin, i), LoadLanes(p_end, i), alpha, correct)), p_pose + i);
+		}
+#endif
+
+		for (; i < p_count; ++i)
+		{
+			float begin[4];
+			float end[4];
+			LoadComponents(p_begin, i, begin);
+			LoadComponents(p_end, i, end);
+
+			LerpComponents(begin, end, p_alphas != nullptr ? p_alphas[i] : p_alpha, p_mode, begin);
+			NormalizeComponents(begin);
+			StoreComponents(begin, p_pose[i]);
+		}
+	}
+}
+
+void QuaternionBatch::Interpolate(const QuaternionStreams& p_begin,
+	const QuaternionStreams& p_end,
+	const float p_alpha,
+	LocalPose* p_pose,
+	const size_t p_count,
+	const QuaternionInterpolation p_mode)
+{
+	InterpolatePairs(p_begin, p_end, p_alpha, nullptr, p_pose, p_count, p_mode);
+}
+
+void QuaternionBatch::Interpolate(const QuaternionStreams& p_begin,
+	const QuaternionStreams& p_end,
+	const float* p_alphas,
+	LocalPose* p_pose,
+	const size_t p_count,
+	const QuaternionInterpolation p_mode)
+{
+	InterpolatePairs(p_begin, p_end, 0.0f, p_alphas, p_pose, p_count, p_mode);
+}
+
+void QuaternionBatch::InterpolateBlend(const QuaternionSample& p_source,
+	const QuaternionSample& p_target,
+	const float p_weight,
+	LocalPose* p_pose,
+	const size_t p_count,
+	const QuaternionInterpolation p_mode)
+{
+	size_t i = 0;
+
+#if defined(GPM_SIMD_SSE)
+	const __m128 sourceAlpha = _mm_set1_ps(p_source.alpha);
+	const __m128 targetAlpha = _mm_set1_ps(p_target.alpha);
+	const __m128 weight = _mm_set1_ps(p_weight);
+	const bool correct = p_mode == QuaternionInterpolation::ApproximateSlerp;
+
+	// Both clips are sampled and blended while the 4 rotations stay in registers, the blend is a nlerp of the two lerps normalized once
+	for (; i + 4 <= p_count; i += 4)
+	{
+		const QuaternionLanes source = LerpLanes(LoadLanes(p_source.begin, i), LoadLanes(p_source.end, i), sourceAlpha, correct);
+		const QuaternionLanes target = LerpLanes(LoadLanes(p_target.begin, i), LoadLanes(p_target.end, i), targetAlpha, correct);
+		StoreLanes(NormalizeLanes(LerpLanes(source, target, weight, false)), p_pose + i);
+	}
+#endif
+
+	for (; i < p_count; ++i)
+	{
+		float source[4];
+		float target[4];
+		float end[4];
+
+		LoadComponents(p_source.begin, i, source);
+		LoadComponents(p_source.end, i, end);
+		LerpComponents(source, end, p_source.alpha, p_mode, source);
+
+		LoadComponents(p_target.begin, i, target);
+		LoadComponents(p_target.end, i, end);
+		LerpComponents(target, end, p_target.alpha, p_mode, target);
+
+		LerpComponents(source, target, p_weight, QuaternionInterpolation::Nlerp, source);
+		NormalizeComponents(source);
+		StoreComponents(source, p_pose[i]);
+	}
+}
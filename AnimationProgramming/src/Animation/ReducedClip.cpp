@@ -0,0 +1,350 @@
+#include <Animation/ReducedClip.h>
+#include <Resources/Skeleton.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+	/**
+	 * @brief Number of rotation tracks gathered together before being interpolated.
+	 */
+	constexpr size_t g_sampleChunk = 8;
+
+	/**
+	 * @brief Number of points measured per bone: its origin and two virtual vertices.
+	 */
+	constexpr size_t g_verticesPerBone = 3;
+
+	/**
+	 * @brief Interpolate one pair of rotations exactly as the sampler does.
+	 */
+	QuaternionF InterpolateRotation(const QuaternionF& p_begin, const QuaternionF& p_end, const float p_alpha)
+	{
+		LocalPose result;
+
+		QuaternionBatch::Interpolate(
+			QuaternionStreams{ &p_begin.axis.x, &p_begin.axis.y, &p_begin.axis.z, &p_begin.w },
+			QuaternionStreams{ &p_end.axis.x, &p_end.axis.y, &p_end.axis.z, &p_end.w },
+			p_alpha,
+			&result,
+			1);
+
+		return result.rotation;
+	}
+
+	/**
+	 * @brief Write the world position of a bone and of its two virtual vertices, along its local x and y axes.
+	 * @param p_world The world matrix of the bone
+	 * @param p_distance The distance of the virtual vertices
+	 * @param p_vertices The 3 points receiving the positions
+	 */
+	void BoneVertices(const Matrix4F& p_world, const float p_distance, Vector3F* p_vertices)
+	{
+		const float* m = p_world.m_data;
+
+		p_vertices[0] = Vector3F{ m[3], m[7], m[11] };
+		p_vertices[1] = Vector3F{ m[3] + m[0] * p_distance, m[7] + m[4] * p_distance, m[11] + m[8] * p_distance };
+		p_vertices[2] = Vector3F{ m[3] + m[1] * p_distance, m[7] + m[5] * p_distance, m[11] + m[9] * p_distance };
+	}
+
+	/**
+	 * @brief Return the index of the key starting the segment that contains a time, searching forward from the cursor.
+	 * @param p_times The key times of the track, the first one is 0
+	 * @param p_count The key count of the track
+	 * @param p_time The time
+	 * @param p_cursor The key of the previous search, updated
+	 */
+	uint32_t SeekKey(const uint16_t* p_times, const uint32_t p_count, const float p_time, uint32_t& p_cursor)
+	{
+		uint32_t key = p_cursor < p_count && static_cast<float>(p_times[p_cursor]) <= p_time ? p_cursor : 0;
+
+		while (key + 1 < p_count && static_cast<float>(p_times[key + 1]) <= p_time)
+			++key;
+
+		p_cursor = key;
+		return key;
+	}
+}
+
+ReducedClip::ReducedClip(const AnimationInfo& p_source, const Skeleton& p_skeleton, const float p_errorBudget, const float p_virtualVertexDistance)
+	: m_keyCount{ p_source.KeyCount() }, m_boneCount{ p_source.BoneCount() }
+{
+	if (p_skeleton.BoneCount() != m_boneCount)
+		throw std::invalid_argument("Animation can't be reduced, the skeleton doesn't match it");
+	if (m_keyCount > static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1)
+		throw std::invalid_argument("Animation can't be reduced, it has too many keys");
+
+	std::vector<LocalPose> source(m_keyCount * m_boneCount);
+
+	for (size_t frame = 0; frame < m_keyCount; ++frame)
+	{
+		for (size_t bone = 0; bone < m_boneCount; ++bone)
+		{
+			const std::pair<Vector3F, QuaternionF> key = p_source.LocalAnimFrame(bone, frame);
+			source[frame * m_boneCount + bone].position = key.first;
+			source[frame * m_boneCount + bone].rotation = key.second;
+		}
+	}
+
+	std::vector<Matrix4F> world(m_boneCount);
+	std::vector<Vector3F> sourceVertices(m_keyCount * m_boneCount * g_verticesPerBone);
+
+	for (size_t frame = 0; frame < m_keyCount; ++frame)
+	{
+		p_skeleton.ComputeWorldPose(&source[frame * m_boneCount], world.data());
+
+		for (size_t bone = 0; bone < m_boneCount; ++bone)
+			BoneVertices(world[bone], p_virtualVertexDistance, &sourceVertices[(frame * m_boneCount + bone) * g_verticesPerBone]);
+	}
+
+	const auto withinBudget = [&](const size_t p_frame, const LocalPose* p_pose)
+	{
+		Vector3F vertices[g_verticesPerBone];
+		p_skeleton.ComputeWorldPose(p_pose, world.data());
+
+		for (size_t bone = 0; bone < m_boneCount; ++bone)
+		{
+			BoneVertices(world[bone], p_virtualVertexDistance, vertices);
+
+			for (size_t vertex = 0; vertex < g_verticesPerBone; ++vertex)
+			{
+				if ((vertices[vertex] - sourceVertices[(p_frame * m_boneCount + bone) * g_verticesPerBone + vertex]).Magnitude() > p_errorBudget)
+					return false;
+			}
+		}
+
+		return true;
+	};
+
+	// Pose rebuilt from the keys kept so far, every accepted removal keeps each of its frames within the budget
+	std::vector<LocalPose> rebuilt = source;
+	std::vector<LocalPose> candidate(m_boneCount);
+	std::vector<char> keptTranslation(m_boneCount * m_keyCount, 1);
+	std::vector<char> keptRotation(m_boneCount * m_keyCount, 1);
+
+	for (size_t bone = 0; bone < m_boneCount; ++bone)
+	{
+		for (const bool translation : { true, false })
+		{
+			size_t previous = 0;
+
+			for (size_t key = 1; key + 1 < m_keyCount; ++key)
+			{
+				const size_t next = key + 1;
+				const LocalPose& begin = source[previous * m_boneCount + bone];
+				const LocalPose& end = source[next * m_boneCount + bone];
+				bool removable = true;
+
+				for (size_t frame = previous + 1; frame < next && removable; ++frame)
+				{
+					const float alpha = static_cast<float>(frame - previous) / static_cast<float>(next - previous);
+					std::copy_n(&rebuilt[frame * m_boneCount], m_boneCount, candidate.data());
+
+					if (translation)
+						candidate[bone].position = begin.position + (end.position - begin.position) * alpha;
+					else
+						candidate[bone].rotation = InterpolateRotation(begin.rotation, end.rotation, alpha);
+
+					removable = withinBudget(frame, candidate.data());
+				}
+
+				if (!removable)
+				{
+					previous = key;
+					continue;
+				}
+
+				for (size_t frame = previous + 1; frame < next; ++frame)
+				{
+					const float alpha = static_cast<float>(frame - previous) / static_cast<float>(next - previous);
+					LocalPose& pose = rebuilt[frame * m_boneCount + bone];
+
+					if (translation)
+						pose.position = begin.position + (end.position - begin.position) * alpha;
+					else
+						pose.rotation = InterpolateRotation(begin.rotation, end.rotation, alpha);
+				}
+
+				(translation ? keptTranslation : keptRotation)[bone * m_keyCount + key] = 0;
+			}
+		}
+	}
+
+	m_translationOffsets.reserve(m_boneCount + 1);
+	m_rotationOffsets.reserve(m_boneCount + 1);
+
+	for (size_t bone = 0; bone < m_boneCount; ++bone)
+	{
+		m_translationOffsets.push_back(static_cast<uint32_t>(m_translations.size()));
+		m_rotationOffsets.push_back(static_cast<uint32_t>(m_rotations.size()));
+
+		for (size_t frame = 0; frame < m_keyCount; ++frame)
+		{
+			if (keptTranslation[bone * m_keyCount + frame])
+			{
+				m_translationTimes.push_back(static_cast<uint16_t>(frame));
+				m_translations.push_back(source[frame * m_boneCount + bone].position);
+			}
+
+			if (keptRotation[bone * m_keyCount + frame])
+			{
+				m_rotationTimes.push_back(static_cast<uint16_t>(frame));
+				m_rotations.push_back(source[frame * m_boneCount + bone].rotation);
+			}
+		}
+	}
+
+	m_translationOffsets.push_back(static_cast<uint32_t>(m_translations.size()));
+	m_rotationOffsets.push_back(static_cast<uint32_t>(m_rotations.size()));
+}
+
+void ReducedClip::SamplePose(const float p_time, ReducedClipCursor& p_cursor, LocalPose* p_pose, const size_t p_boneCount, const QuaternionInterpolation p_interpolation) const
+{
+	if (m_keyCount == 0)
+		throw std::out_of_range("Reduced pose unattainable, the clip has no key");
+
+	if (p_cursor.translationKeys.size() != m_boneCount || p_cursor.rotationKeys.size() != m_boneCount)
+	{
+		p_cursor.translationKeys.assign(m_boneCount, 0);
+		p_cursor.rotationKeys.assign(m_boneCount, 0);
+	}
+
+	const size_t boneCount = std::min(p_boneCount, m_boneCount);
+	const float time = static_cast<float>(static_cast<size_t>(p_time) % m_keyCount) + Tools::Utils::GetDecimalPart(p_time);
+
+	// The segment after the last key loops back to the first one, at time m_keyCount
+	const auto segmentAlpha = [this, time](const uint16_t* p_times, const uint32_t p_count, const uint32_t p_key)
+	{
+		const float begin = static_cast<float>(p_times[p_key]);
+		const float end = p_key + 1 < p_count ? static_cast<float>(p_times[p_key + 1]) : static_cast<float>(m_keyCount);
+
+		return (time - begin) / (end - begin);
+	};
+
+	for (size_t bone = 0; bone < boneCount; ++bone)
+	{
+		const uint32_t first = m_translationOffsets[bone];
+		const uint32_t count = m_translationOffsets[bone + 1] - first;
+		const uint16_t* times = m_translationTimes.data() + first;
+		const uint32_t key = SeekKey(times, count, time, p_cursor.translationKeys[bone]);
+		const uint32_t next = key + 1 < count ? key + 1 : 0;
+		const float alpha = segmentAlpha(times, count, key);
+
+		const Vector3F& begin = m_translations[first + key];
+		const Vector3F& end = m_translations[first + next];
+		p_pose[bone].position = begin + (end - begin) * alpha;
+	}
+
+	// Rotation keys are gathered into streams so that each chunk is interpolated at once, every track with its own factor
+	alignas(32) float begin[4][g_sampleChunk];
+	alignas(32) float end[4][g_sampleChunk];
+	alignas(32) float alphas[g_sampleChunk];
+
+	for (size_t chunkStart = 0; chunkStart < boneCount; chunkStart += g_sampleChunk)
+	{
+		const size_t chunkSize = std::min(g_sampleChunk, boneCount - chunkStart);
+
+		for (size_t i = 0; i < chunkSize; ++i)
+		{
+			const size_t bone = chunkStart + i;
+			const uint32_t first = m_rotationOffsets[bone];
+			const uint32_t count = m_rotationOffsets[bone + 1] - first;
+			const uint16_t* times = m_rotationTimes.data() + first;
+			const uint32_t key = SeekKey(times, count, time, p_cursor.rotationKeys[bone]);
+			const uint32_t next = key + 1 < count ? key + 1 : 0;
+
+			const QuaternionF& beginRotation = m_rotations[first + key];
+			const QuaternionF& endRotation = m_rotations[first + next];
+			begin[0][i] = beginRotation.axis.x;
+			begin[1][i] = beginRotation.axis.y;
+			begin[2][i] = beginRotation.axis.z;
+			begin[3][i] = beginRotation.w;
+			end[0][i] = endRotation.axis.x;
+			end[1][i] = endRotation.axis.y;
+			end[2][i] = endRotation.axis.z;
+			end[3][i] = endRotation.w;
+			alphas[i] = segmentAlpha(times, count, key);
+		}
+
+		QuaternionBatch::Interpolate(
+			QuaternionStreams{ begin[0], begin[1], begin[2], begin[3] },
+			QuaternionStreams{ end[0], end[1], end[2], end[3] },
+			alphas,
+			p_pose + chunkStart,
+			chunkSize,
+			p_interpolation);
+	}
+}
+
+CompressionReport ReducedClip::MeasureError(const AnimationInfo& p_source, const Skeleton& p_skeleton) const
+{
+	if (p_source.BoneCount() != m_boneCount || p_source.KeyCount() != m_keyCount || p_skeleton.BoneCount() != m_boneCount)
+		throw std::invalid_argument("Reduction error unmeasurable, the source or the skeleton doesn't match the clip");
+
+	CompressionReport report;
+	report.sourceMemorySize = p_source.KeyMemorySize();
+	report.compressedMemorySize = MemorySize();
+
+	ReducedClipCursor cursor;
+	std::vector<LocalPose> sourcePose(m_boneCount);
+	std::vector<LocalPose> reducedPose(m_boneCount);
+	std::vector<Matrix4F> sourceWorld(m_boneCount);
+	std::vector<Matrix4F> reducedWorld(m_boneCount);
+
+	for (size_t frame = 0; frame < m_keyCount; ++frame)
+	{
+		SamplePose(static_cast<float>(frame), cursor, reducedPose.data(), reducedPose.size());
+
+		for (size_t bone = 0; bone < m_boneCount; ++bone)
+		{
+			const std::pair<Vector3F, QuaternionF> sourceKey = p_source.LocalAnimFrame(bone, frame);
+			sourcePose[bone].position = sourceKey.first;
+			sourcePose[bone].rotation = sourceKey.second;
+
+			const QuaternionF relative = QuaternionF::Conjugate(sourceKey.second) * reducedPose[bone].rotation;
+			const float sine = std::sqrt(relative.axis.x * relative.axis.x + relative.axis.y * relative.axis.y + relative.axis.z * relative.axis.z);
+
+			report.maxLocalTranslationError = std::max(report.maxLocalTranslationError, (reducedPose[bone].position - sourceKey.first).Magnitude());
+			report.maxLocalRotationError = std::max(report.maxLocalRotationError, 2.0f * std::atan2(sine, std::abs(relative.w)));
+		}
+
+		p_skeleton.ComputeWorldPose(sourcePose.data(), sourceWorld.data());
+		p_skeleton.ComputeWorldPose(reducedPose.data(), reducedWorld.data());
+
+		for (size_t bone = 0; bone < m_boneCount; ++bone)
+		{
+			const float* source = sourceWorld[bone].m_data;
+			const float* reduced = reducedWorld[bone].m_data;
+			const Vector3F positionError{ reduced[3] - source[3], reduced[7] - source[7], reduced[11] - source[11] };
+
+			report.maxWorldPositionError = std::max(report.maxWorldPositionError, positionError.Magnitude());
+		}
+	}
+
+	return report;
+}
+
+size_t ReducedClip::KeyCount() const
+{
+	return m_keyCount;
+}
+
+size_t ReducedClip::BoneCount() const
+{
+	return m_boneCount;
+}
+
+size_t ReducedClip::StoredKeyCount() const
+{
+	return m_translations.size() + m_rotations.size();
+}
+
+size_t ReducedClip::MemorySize() const
+{
+	return (m_translationOffsets.size() + m_rotationOffsets.size()) * sizeof(uint32_t)
+		+ (m_translationTimes.size() + m_rotationTimes.size()) * sizeof(uint16_t)
+		+ m_translations.size() * sizeof(Vector3F)
+		+ m_rotations.size() * sizeof(QuaternionF);
+}
@@ -0,0 +1,91 @@
+#include <Animation/RootMotion.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+RootMotion::RootMotion(std::vector<Vector3F> p_displacements)
+	: m_displacements{ std::move(p_displacements) }
+{
+	if (m_displacements.size() < 2)
+		throw std::invalid_argument("Root motion can't be created, it needs the displacement of at least one key and of the loop");
+}
+
+RootMotion RootMotion::Extract(AnimationInfo& p_clip, const size_t p_rootBone)
+{
+	if (p_rootBone >= p_clip.BoneCount())
+		throw std::out_of_range("Root motion can't be extracted, the root bone isn't in the clip");
+
+	const size_t keyCount = p_clip.KeyCount();
+	if (keyCount < 2)
+		return {};
+
+	std::vector<Vector3F> positions(keyCount);
+	for (size_t key = 0; key < keyCount; ++key)
+		positions[key] = p_clip.LocalAnimFrame(p_rootBone, key).first;
+
+	std::vector<Vector3F> displacements(keyCount + 1, Vector3F{ 0.0f, 0.0f, 0.0f });
+	for (size_t key = 1; key < keyCount; ++key)
+	{
+		displacements[key] = Vector3F{ displacements[key - 1].x + positions[key].x - positions[key - 1].x,
+			displacements[key - 1].y + positions[key].y - positions[key - 1].y,
+			displacements[key - 1].z + positions[key].z - positions[key - 1].z };
+	}
+
+	// The pose goes back to the first key over the last segment, the root keeps moving as over the segment before
+	const Vector3F& lastSegmentStart = positions[keyCount - 2];
+	const Vector3F& lastKey = positions[keyCount - 1];
+	displacements[keyCount] = Vector3F{ displacements[keyCount - 1].x + lastKey.x - lastSegmentStart.x,
+		displacements[keyCount - 1].y + lastKey.y - lastSegmentStart.y,
+		displacements[keyCount - 1].z + lastKey.z - lastSegmentStart.z };
+
+	for (size_t key = 0; key < keyCount; ++key)
+		p_clip.UpdateAnimFrame(p_rootBone, key, positions[0], p_clip.LocalAnimFrame(p_rootBone, key).second);
+
+	return RootMotion(std::move(displacements));
+}
+
+Vector3F RootMotion::Displacement(const float p_time, const float p_keyCount) const
+{
+	if (m_displacements.empty())
+		return Vector3F{ 0.0f, 0.0f, 0.0f };
+
+	const float keyCount = static_cast<float>(KeyCount());
+	const float endTime = p_time + p_keyCount;
+
+	// Whole loops are counted apart so that the result doesn't depend on how far the times are from 0
+	const float startLoop = std::floor(p_time / keyCount);
+	const float endLoop = std::floor(endTime / keyCount);
+	const float loopCount = endLoop - startLoop;
+
+	const Vector3F start = LoopPosition(p_time - startLoop * keyCount);
+	const Vector3F end = LoopPosition(endTime - endLoop * keyCount);
+	const Vector3F& loop = m_displacements.back();
+
+	return Vector3F{ end.x - start.x + loop.x * loopCount, end.y - start.y + loop.y * loopCount, end.z - start.z + loop.z * loopCount };
+}
+
+Vector3F RootMotion::LoopDisplacement() const
+{
+	return m_displacements.empty() ? Vector3F{ 0.0f, 0.0f, 0.0f } : m_displacements.back();
+}
+
+size_t RootMotion::KeyCount() const
+{
+	return m_displacements.empty() ? 0 : m_displacements.size() - 1;
+}
+
+const std::vector<Vector3F>& RootMotion::Displacements() const
+{
+	return m_displacements;
+}
+
+Vector3F RootMotion::LoopPosition(const float p_time) const
+{
+	// The rounding of the wrapped time may land on the key count
+	const size_t key = std::min(static_cast<size_t>(std::max(p_time, 0.0f)), KeyCount() - 1);
+	const float alpha = p_time - static_cast<float>(key);
+	const Vector3F& from = m_displacements[key];
+	const Vector3F& to = m_displacements[key + 1];
+
+	return Vector3F{ from.x + (to.x - from.x) * alpha, from.y + (to.y - from.y) * alpha, from.z + (to.z - from.z) * alpha };
+}
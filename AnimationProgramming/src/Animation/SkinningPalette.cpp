@@ -0,0 +1,91 @@
+#include <Animation/SkinningPalette.h>
+
+namespace
+{
+	constexpr size_t g_blockSize = 16;
+
+	/**
+	 * @brief Write the 3 first rows of the product of two affine matrices, the last row of both being 0, 0, 0, 1.
+	 * @param p_left The left matrix
+	 * @param p_right The right matrix
+	 * @param p_rows The 12 floats receiving the rows
+	 */
+	void MultiplyAffine3x4(const Matrix4F& p_left, const Matrix4F& p_right, float* p_rows)
+	{
+		const float* a = p_left.m_data;
+		const float* b = p_right.m_data;
+
+		for (int row = 0; row < 3; ++row)
+		{
+			const float* aRow = a + row * 4;
+
+			p_rows[row * 4 + 0] = aRow[0] * b[0] + aRow[1] * b[4] + aRow[2] * b[8];
+			p_rows[row * 4 + 1] = aRow[0] * b[1] + aRow[1] * b[5] + aRow[2] * b[9];
+			p_rows[row * 4 + 2] = aRow[0] * b[2] + aRow[1] * b[6] + aRow[2] * b[10];
+			p_rows[row * 4 + 3] = aRow[0] * b[3] + aRow[1] * b[7] + aRow[2] * b[11] + aRow[3];
+		}
+	}
+}
+
+size_t SkinningPalette::FloatsPerBone(const SkinningPaletteMode p_mode)
+{
+	switch (p_mode)
+	{
+	case SkinningPaletteMode::Affine3x4:
+		return 12;
+	case SkinningPaletteMode::DualQuaternion:
+		return 8;
+	default:
+		return 16;
+	}
+}
+
+size_t SkinningPalette::BlockCount(const SkinningPaletteMode p_mode, const size_t p_boneCount)
+{
+	return (p_boneCount * FloatsPerBone(p_mode) + g_blockSize - 1) / g_blockSize;
+}
+
+void SkinningPalette::Write(const Skeleton& p_skeleton, const Matrix4F* p_worldPose, const SkinningPaletteMode p_mode, float* p_palette)
+{
+	const size_t boneCount = p_skeleton.BoneCount();
+
+	if (p_mode == SkinningPaletteMode::Affine3x4)
+	{
+		for (size_t i = 0; i < boneCount; i++)
+		{
+			MultiplyAffine3x4(p_worldPose[i], p_skeleton.InverseBindMatrix(i), &p_palette[i * 12]);
+		}
+
+		return;
+	}
+
+	for (size_t i = 0; i < boneCount; i++)
+	{
+		const Matrix4F animatedMatrix = p_worldPose[i] * p_skeleton.InverseBindMatrix(i);
+
+		for (int j = 0; j < 16; j++)
+		{
+			p_palette[i * 16 + j] = animatedMatrix.m_data[j];
+		}
+	}
+}
+
+void SkinningPalette::Write(const Skeleton& p_skeleton, const DualQuaternion* p_worldPose, float* p_palette)
+{
+	const size_t boneCount = p_skeleton.BoneCount();
+
+	for (size_t i = 0; i < boneCount; i++)
+	{
+		const DualQuaternion skinning = DualQuaternion::Multiply(p_worldPose[i], p_skeleton.InverseBindDualQuaternion(i));
+		float* palette = &p_palette[i * 8];
+
+		palette[0] = skinning.real.x;
+		palette[1] = skinning.real.y;
+		palette[2] = skinning.real.z;
+		palette[3] = skinning.real.w;
+		palette[4] = skinning.dual.x;
+		palette[5] = skinning.dual.y;
+		palette[6] = skinning.dual.z;
+		palette[7] = skinning.dual.w;
+	}
+}
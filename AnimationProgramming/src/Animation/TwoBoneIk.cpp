@@ -0,0 +1,506 @@
+#include <Animation/TwoBoneIk.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+	/**
+	 * @brief The float streams stored for every limb. The world rotations are the 3 rows of their matrix.
+	 */
+	enum IkStream : size_t
+	{
+		UpperPosition = 0,
+		MiddlePosition = 3,
+		EndPosition = 6,
+		UpperRotation = 9,
+		MiddleRotation = 18,
+		EndRotation = 27,
+		UpperLocalRotation = 36,
+		MiddleLocalRotation = 40,
+		EndLocalRotation = 44,
+		Target = 48,
+		PoleOffset = 51,
+		Weight = 54,
+		StreamCount = 55
+	};
+
+	constexpr size_t g_laneCount = 4;
+
+	/**
+	 * @brief Floats (one cache line) added after each stream, so that the streams of a limb don't all fall on the same cache set when the capacity is a power of 2.
+	 */
+	constexpr size_t g_streamPadding = 16;
+
+	/**
+	 * @brief Shortest distance, relative to the length of the limb, kept between the upper and the end bone so that the middle bone never fully straightens nor folds.
+	 */
+	constexpr float g_reachMargin = 1e-4f;
+
+	/**
+	 * @brief Squared length below which a vector has no direction.
+	 */
+	constexpr float g_degenerateLengthSquared = 1e-12f;
+
+	template<typename Lane>
+	Lane LoadLane(const float* p_source);
+
+	template<typename Lane>
+	Lane Broadcast(const float p_value);
+
+#if defined(GPM_SIMD_SSE)
+	/**
+	 * @brief The same component of 4 limbs.
+	 */
+	struct SseLane final
+	{
+		__m128 value;
+	};
+
+	SseLane operator+(const SseLane p_left, const SseLane p_right) { return { _mm_add_ps(p_left.value, p_right.value) }; }
+	SseLane operator-(const SseLane p_left, const SseLane p_right) { return { _mm_sub_ps(p_left.value, p_right.value) }; }
+	SseLane operator*(const SseLane p_left, const SseLane p_right) { return { _mm_mul_ps(p_left.value, p_right.value) }; }
+	SseLane operator/(const SseLane p_left, const SseLane p_right) { return { _mm_div_ps(p_left.value, p_right.value) }; }
+	SseLane Sqrt(const SseLane p_value) { return { _mm_sqrt_ps(p_value.value) }; }
+	SseLane Min(const SseLane p_left, const SseLane p_right) { return { _mm_min_ps(p_left.value, p_right.value) }; }
+	SseLane Max(const SseLane p_left, const SseLane p_right) { return { _mm_max_ps(p_left.value, p_right.value) }; }
+
+	/**
+	 * @brief Return p_left in the lanes where p_value is greater than p_threshold, p_right in the others.
+	 */
+	SseLane SelectGreater(const SseLane p_value, const SseLane p_threshold, const SseLane p_left, const SseLane p_right)
+	{
+		const __m128 mask = _mm_cmpgt_ps(p_value.value, p_threshold.value);
+		return { _mm_or_ps(_mm_and_ps(mask, p_left.value), _mm_andnot_ps(mask, p_right.value)) };
+	}
+
+	template<>
+	SseLane LoadLane<SseLane>(const float* p_source)
+	{
+		return { _mm_load_ps(p_source) };
+	}
+
+	void StoreLane(float* p_destination, const SseLane p_value)
+	{
+		_mm_store_ps(p_destination, p_value.value);
+	}
+
+	template<>
+	SseLane Broadcast<SseLane>(const float p_value)
+	{
+		return { _mm_set1_ps(p_value) };
+	}
+#else
+	float Sqrt(const float p_value)
+	{
+		return std::sqrt(p_value);
+	}
+
+	float Min(const float p_left, const float p_right)
+	{
+		return std::min(p_left, p_right);
+	}
+
+	float Max(const float p_left, const float p_right)
+	{
+		return std::max(p_left, p_right);
+	}
+
+	float SelectGreater(const float p_value, const float p_threshold, const float p_left, const float p_right)
+	{
+		return p_value > p_threshold ? p_left : p_right;
+	}
+
+	template<>
+	float LoadLane<float>(const float* p_source)
+	{
+		return *p_source;
+	}
+
+	void StoreLane(float* p_destination, const float p_value)
+	{
+		*p_destination = p_value;
+	}
+
+	template<>
+	float Broadcast<float>(const float p_value)
+	{
+		return p_value;
+	}
+#endif
+
+	template<typename Lane>
+	struct Vector3Lanes final
+	{
+		Lane x;
+		Lane y;
+		Lane z;
+	};
+
+	template<typename Lane>
+	struct QuaternionLanes final
+	{
+		Lane x;
+		Lane y;
+		Lane z;
+		Lane w;
+	};
+
+	template<typename Lane>
+	Vector3Lanes<Lane> Subtract(const Vector3Lanes<Lane>& p_left, const Vector3Lanes<Lane>& p_right)
+	{
+		return { p_left.x - p_right.x, p_left.y - p_right.y, p_left.z - p_right.z };
+	}
+
+	template<typename Lane>
+	Vector3Lanes<Lane> Scale(const Vector3Lanes<Lane>& p_vector, const Lane p_scale)
+	{
+		return { p_vector.x * p_scale, p_vector.y * p_scale, p_vector.z * p_scale };
+	}
+
+	template<typename Lane>
+	Vector3Lanes<Lane> MultiplyAdd(const Vector3Lanes<Lane>& p_base, const Vector3Lanes<Lane>& p_vector, const Lane p_scale)
+	{
+		return { p_base.x + p_vector.x * p_scale, p_base.y + p_vector.y * p_scale, p_base.z + p_vector.z * p_scale };
+	}
+
+	template<typename Lane>
+	Lane Dot(const Vector3Lanes<Lane>& p_left, const Vector3Lanes<Lane>& p_right)
+	{
+		return p_left.x * p_right.x + p_left.y * p_right.y + p_left.z * p_right.z;
+	}
+
+	template<typename Lane>
+	Vector3Lanes<Lane> Cross(const Vector3Lanes<Lane>& p_left, const Vector3Lanes<Lane>& p_right)
+	{
+		return { p_left.y * p_right.z - p_left.z * p_right.y, p_left.z * p_right.x - p_left.x * p_right.z, p_left.x * p_right.y - p_left.y * p_right.x };
+	}
+
+	/**
+	 * @brief Shortest rotation turning the direction of p_from into the direction of p_to, built from their cross and dot products without any trigonometry.
+	 */
+	template<typename Lane>
+	QuaternionLanes<Lane> RotationBetween(const Vector3Lanes<Lane>& p_from, const Vector3Lanes<Lane>& p_to)
+	{
+		const Vector3Lanes<Lane> axis = Cross(p_from, p_to);
+		const Lane w = Sqrt(Dot(p_from, p_from) * Dot(p_to, p_to)) + Dot(p_from, p_to);
+		const Lane inverseLength = Broadcast<Lane>(1.0f) / Sqrt(Max(Dot(axis, axis) + w * w, Broadcast<Lane>(g_degenerateLengthSquared)));
+
+		return { axis.x * inverseLength, axis.y * inverseLength, axis.z * inverseLength, w * inverseLength };
+	}
+
+	/**
+	 * @brief Rotate a vector by a unit quaternion: v + 2w (q x v) + 2 q x (q x v).
+	 */
+	template<typename Lane>
+	Vector3Lanes<Lane> Rotate(const QuaternionLanes<Lane>& p_rotation, const Vector3Lanes<Lane>& p_vector)
+	{
+		const Vector3Lanes<Lane> axis{ p_rotation.x, p_rotation.y, p_rotation.z };
+		const Vector3Lanes<Lane> first = Cross(axis, p_vector);
+		const Vector3Lanes<Lane> second = Cross(axis, first);
+		const Lane two = Broadcast<Lane>(2.0f);
+
+		return { p_vector.x + (first.x * p_rotation.w + second.x) * two,
+			p_vector.y + (first.y * p_rotation.w + second.y) * two,
+			p_vector.z + (first.z * p_rotation.w + second.z) * two };
+	}
+
+	template<typename Lane>
+	QuaternionLanes<Lane> Multiply(const QuaternionLanes<Lane>& p_left, const QuaternionLanes<Lane>& p_right)
+	{
+		return { p_left.w * p_right.x + p_left.x * p_right.w + p_left.y * p_right.z - p_left.z * p_right.y,
+			p_left.w * p_right.y - p_left.x * p_right.z + p_left.y * p_right.w + p_left.z * p_right.x,
+			p_left.w * p_right.z + p_left.x * p_right.y - p_left.y * p_right.x + p_left.z * p_right.w,
+			p_left.w * p_right.w - p_left.x * p_right.x - p_left.y * p_right.y - p_left.z * p_right.z };
+	}
+
+	/**
+	 * @brief Read the streams of a group of limbs, one lane per limb.
+	 */
+	template<typename Lane>
+	class LimbStreams final
+	{
+	public:
+		LimbStreams(float* p_streams, const size_t p_streamStride, const size_t p_limb)
+			: m_streams{ p_streams }, m_streamStride{ p_streamStride }, m_limb{ p_limb }
+		{
+		}
+
+		Lane Load(const size_t p_stream) const
+		{
+			return LoadLane<Lane>(m_streams + p_stream * m_streamStride + m_limb);
+		}
+
+		Vector3Lanes<Lane> LoadVector(const size_t p_stream) const
+		{
+			return { Load(p_stream), Load(p_stream + 1), Load(p_stream + 2) };
+		}
+
+		QuaternionLanes<Lane> LoadQuaternion(const size_t p_stream) const
+		{
+			return { Load(p_stream), Load(p_stream + 1), Load(p_stream + 2), Load(p_stream + 3) };
+		}
+
+		/**
+		 * @brief Express a world rotation in the frame of a bone: its vector part is multiplied by the transposed world rotation of the bone.
+		 */
+		QuaternionLanes<Lane> ToBoneFrame(const size_t p_rotationStream, const QuaternionLanes<Lane>& p_rotation) const
+		{
+			const Vector3Lanes<Lane> rows[3]{ LoadVector(p_rotationStream), LoadVector(p_rotationStream + 3), LoadVector(p_rotationStream + 6) };
+
+			return { rows[0].x * p_rotation.x + rows[1].x * p_rotation.y + rows[2].x * p_rotation.z,
+				rows[0].y * p_rotation.x + rows[1].y * p_rotation.y + rows[2].y * p_rotation.z,
+				rows[0].z * p_rotation.x + rows[1].z * p_rotation.y + rows[2].z * p_rotation.z,
+				p_rotation.w };
+		}
+
+		void StoreQuaternion(const size_t p_stream, const QuaternionLanes<Lane>& p_quaternion) const
+		{
+			StoreLane(m_streams + p_stream * m_streamStride + m_limb, p_quaternion.x);
+			StoreLane(m_streams + (p_stream + 1) * m_streamStride + m_limb, p_quaternion.y);
+			StoreLane(m_streams + (p_stream + 2) * m_streamStride + m_limb, p_quaternion.z);
+			StoreLane(m_streams + (p_stream + 3) * m_streamStride + m_limb, p_quaternion.w);
+		}
+
+	private:
+		float* m_streams;
+		size_t m_streamStride;
+		size_t m_limb;
+	};
+
+	/**
+	 * @brief Solve a group of limbs, one per lane, and replace their local rotations in the streams.
+	 */
+	template<typename Lane>
+	void SolveLanes(float* p_streams, const size_t p_streamStride, const size_t p_limb)
+	{
+		const LimbStreams<Lane> limbs(p_streams, p_streamStride, p_limb);
+
+		const Vector3Lanes<Lane> upper = limbs.LoadVector(UpperPosition);
+		const Vector3Lanes<Lane> middle = limbs.LoadVector(MiddlePosition);
+		const Vector3Lanes<Lane> end = limbs.LoadVector(EndPosition);
+		const Vector3Lanes<Lane> target = MultiplyAdd(end, Subtract(limbs.LoadVector(Target), end), limbs.Load(Weight));
+		const Vector3Lanes<Lane> poleOffset = limbs.LoadVector(PoleOffset);
+
+		const Vector3Lanes<Lane> upperToMiddle = Subtract(middle, upper);
+		const Vector3Lanes<Lane> middleToEnd = Subtract(end, middle);
+		const Lane upperLengthSquared = Dot(upperToMiddle, upperToMiddle);
+		const Lane upperLength = Sqrt(upperLengthSquared);
+		const Lane lowerLength = Sqrt(Dot(middleToEnd, middleToEnd));
+
+		// Distance to the target, clamped to what the limb can reach
+		const Vector3Lanes<Lane> toTarget = Subtract(target, upper);
+		const Lane targetDistance = Sqrt(Dot(toTarget, toTarget));
+		const Vector3Lanes<Lane> direction = Scale(toTarget, Broadcast<Lane>(1.0f) / Max(targetDistance, Broadcast<Lane>(g_degenerateLengthSquared)));
+		const Lane limbLength = upperLength + lowerLength;
+		const Lane reach = Min(Max(targetDistance, Max(upperLength - lowerLength, lowerLength - upperLength) + limbLength * Broadcast<Lane>(g_reachMargin)),
+			limbLength * Broadcast<Lane>(1.0f - g_reachMargin));
+
+		// Bending direction: the pole, or the current middle bone if the pole is on the line to the target
+		const Vector3Lanes<Lane> toPole{ upperToMiddle.x + poleOffset.x, upperToMiddle.y + poleOffset.y, upperToMiddle.z + poleOffset.z };
+		const Vector3Lanes<Lane> poleBend = MultiplyAdd(toPole, direction, Broadcast<Lane>(0.0f) - Dot(toPole, direction));
+		const Vector3Lanes<Lane> middleBend = MultiplyAdd(upperToMiddle, direction, Broadcast<Lane>(0.0f) - Dot(upperToMiddle, direction));
+		const Lane poleBendLengthSquared = Dot(poleBend, poleBend);
+		const Lane middleBendLengthSquared = Dot(middleBend, middleBend);
+		const Lane threshold = Broadcast<Lane>(g_degenerateLengthSquared) * upperLengthSquared;
+		const Lane bendLengthSquared = SelectGreater(poleBendLengthSquared, threshold, poleBendLengthSquared, middleBendLengthSquared);
+		const Lane inverseBendLength = Broadcast<Lane>(1.0f) / Sqrt(Max(bendLengthSquared, Broadcast<Lane>(g_degenerateLengthSquared)));
+		const Vector3Lanes<Lane> bend{ SelectGreater(poleBendLengthSquared, threshold, poleBend.x, middleBend.x) * inverseBendLength,
+			SelectGreater(poleBendLengthSquared, threshold, poleBend.y, middleBend.y) * inverseBendLength,
+			SelectGreater(poleBendLengthSquared, threshold, poleBend.z, middleBend.z) * inverseBendLength };
+
+		// Law of cosines: the middle bone is along the target by alongTarget and away from it by height
+		const Lane alongTarget = (upperLengthSquared - lowerLength * lowerLength + reach * reach) / (reach + reach);
+		const Lane height = Sqrt(Max(upperLengthSquared - alongTarget * alongTarget, Broadcast<Lane>(0.0f)));
+		const Vector3Lanes<Lane> solvedMiddle = MultiplyAdd(MultiplyAdd(upper, direction, alongTarget), bend, height);
+		const Vector3Lanes<Lane> solvedEnd = MultiplyAdd(upper, direction, reach);
+
+		const QuaternionLanes<Lane> upperRotation = RotationBetween(upperToMiddle, Subtract(solvedMiddle, upper));
+		const QuaternionLanes<Lane> middleRotation = RotationBetween(Rotate(upperRotation, middleToEnd), Subtract(solvedEnd, solvedMiddle));
+		const QuaternionLanes<Lane> upperConjugate{ Broadcast<Lane>(0.0f) - upperRotation.x, Broadcast<Lane>(0.0f) - upperRotation.y, Broadcast<Lane>(0.0f) - upperRotation.z, upperRotation.w };
+		const Vector3Lanes<Lane> middleAxis = Rotate(upperConjugate, Vector3Lanes<Lane>{ middleRotation.x, middleRotation.y, middleRotation.z });
+		const QuaternionLanes<Lane> limbRotation = Multiply(middleRotation, upperRotation);
+
+		// A world rotation R applied to a bone is, in its local pose, the rotation W^-1 R W after its own rotation, W being its world rotation
+		const QuaternionLanes<Lane> upperDelta = limbs.ToBoneFrame(UpperRotation, upperRotation);
+		const QuaternionLanes<Lane> middleDelta = limbs.ToBoneFrame(MiddleRotation, QuaternionLanes<Lane>{ middleAxis.x, middleAxis.y, middleAxis.z, middleRotation.w });
+
+		// The end bone turns back by the rotation of the limb to keep its world rotation
+		const QuaternionLanes<Lane> endDelta = limbs.ToBoneFrame(EndRotation,
+			QuaternionLanes<Lane>{ Broadcast<Lane>(0.0f) - limbRotation.x, Broadcast<Lane>(0.0f) - limbRotation.y, Broadcast<Lane>(0.0f) - limbRotation.z, limbRotation.w });
+
+		limbs.StoreQuaternion(UpperLocalRotation, Multiply(limbs.LoadQuaternion(UpperLocalRotation), upperDelta));
+		limbs.StoreQuaternion(MiddleLocalRotation, Multiply(limbs.LoadQuaternion(MiddleLocalRotation), middleDelta));
+		limbs.StoreQuaternion(EndLocalRotation, Multiply(limbs.LoadQuaternion(EndLocalRotation), endDelta));
+	}
+}
+
+IkChain TwoBoneIk::FindChain(const Skeleton& p_skeleton, const size_t p_endBone)
+{
+	if (p_endBone >= p_skeleton.BoneCount())
+		throw std::invalid_argument("IK chain can't be found, the end bone isn't in the skeleton");
+
+	const int middle = p_skeleton.ParentIndex(p_endBone);
+	const int upper = middle == -1 ? -1 : p_skeleton.ParentIndex(static_cast<size_t>(middle));
+	if (upper == -1)
+		throw std::invalid_argument("IK chain can't be found, " + p_skeleton.BoneName(p_endBone) + " has no grandparent");
+
+	return IkChain{ static_cast<size_t>(upper), static_cast<size_t>(middle), p_endBone };
+}
+
+void TwoBoneIk::Clear()
+{
+	m_limbs.clear();
+	m_characters.clear();
+}
+
+void TwoBoneIk::Add(LocalPose* p_localPose, const Matrix4F* p_worldPose, const IkChain& p_chain, const Vector3F& p_target, const Vector3F& p_poleOffset, const float p_weight)
+{
+	if (m_limbs.size() == m_capacity)
+		Reserve(std::max(m_capacity * 2, g_laneCount * 4));
+
+	const size_t bones[3]{ p_chain.upper, p_chain.middle, p_chain.end };
+	for (size_t bone = 0; bone < 3; ++bone)
+	{
+		const float* matrix = p_worldPose[bones[bone]].m_data;
+		WriteStream(UpperPosition + bone * 3, matrix[3]);
+		WriteStream(UpperPosition + bone * 3 + 1, matrix[7]);
+		WriteStream(UpperPosition + bone * 3 + 2, matrix[11]);
+		WriteRotation(UpperRotation + bone * 9, matrix);
+	}
+
+	AddLimb(p_localPose, p_chain, p_target, p_poleOffset, p_weight);
+}
+
+void TwoBoneIk::Add(LocalPose* p_localPose, const DualQuaternion* p_worldPose, const IkChain& p_chain, const Vector3F& p_target, const Vector3F& p_poleOffset, const float p_weight)
+{
+	if (m_limbs.size() == m_capacity)
+		Reserve(std::max(m_capacity * 2, g_laneCount * 4));
+
+	const size_t bones[3]{ p_chain.upper, p_chain.middle, p_chain.end };
+	for (size_t bone = 0; bone < 3; ++bone)
+	{
+		const DualQuaternion& world = p_worldPose[bones[bone]];
+		const Vector3F position = DualQuaternion::Translation(world);
+		WriteStream(UpperPosition + bone * 3, position.x);
+		WriteStream(UpperPosition + bone * 3 + 1, position.y);
+		WriteStream(UpperPosition + bone * 3 + 2, position.z);
+
+		// Rows of the rotation matrix of the real part, laid out like the rows of a Matrix4F
+		const float x = world.real.x;
+		const float y = world.real.y;
+		const float z = world.real.z;
+		const float w = world.real.w;
+		const float rows[12]{
+			1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y), 0.0f,
+			2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x), 0.0f,
+			2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y), 0.0f };
+		WriteRotation(UpperRotation + bone * 9, rows);
+	}
+
+	AddLimb(p_localPose, p_chain, p_target, p_poleOffset, p_weight);
+}
+
+size_t TwoBoneIk::Count() const
+{
+	return m_limbs.size();
+}
+
+void TwoBoneIk::Solve()
+{
+	const size_t limbCount = m_limbs.size();
+	if (limbCount == 0)
+		return;
+
+	float* streams = m_streams.data();
+
+#if defined(GPM_SIMD_SSE)
+	// The last group is filled with copies of the last limb, so that every limb goes through the same instructions
+	const size_t groupEnd = (limbCount + g_laneCount - 1) / g_laneCount * g_laneCount;
+	for (size_t stream = 0; stream < StreamCount; ++stream)
+		std::fill(streams + stream * m_streamStride + limbCount, streams + stream * m_streamStride + groupEnd, streams[stream * m_streamStride + limbCount - 1]);
+
+	for (size_t limb = 0; limb < groupEnd; limb += g_laneCount)
+		SolveLanes<SseLane>(streams, m_streamStride, limb);
+#else
+	for (size_t limb = 0; limb < limbCount; ++limb)
+		SolveLanes<float>(streams, m_streamStride, limb);
+#endif
+
+	const IkStream localRotations[3]{ UpperLocalRotation, MiddleLocalRotation, EndLocalRotation };
+	for (size_t limb = 0; limb < limbCount; ++limb)
+	{
+		const size_t bones[3]{ m_limbs[limb].chain.upper, m_limbs[limb].chain.middle, m_limbs[limb].chain.end };
+		for (size_t bone = 0; bone < 3; ++bone)
+		{
+			QuaternionF& rotation = m_limbs[limb].localPose[bones[bone]].rotation;
+			rotation.axis.x = streams[localRotations[bone] * m_streamStride + limb];
+			rotation.axis.y = streams[(localRotations[bone] + 1) * m_streamStride + limb];
+			rotation.axis.z = streams[(localRotations[bone] + 2) * m_streamStride + limb];
+			rotation.w = streams[(localRotations[bone] + 3) * m_streamStride + limb];
+		}
+	}
+}
+
+void TwoBoneIk::SolveCharacters()
+{
+	Solve();
+
+	for (const Character& character : m_characters)
+	{
+		if (character.worldDualQuaternions != nullptr)
+			character.skeleton->ComputeWorldPose(character.localPose, character.worldDualQuaternions, character.firstBone);
+		else
+			character.skeleton->ComputeWorldPose(character.localPose, character.worldPose, character.firstBone);
+	}
+}
+
+void TwoBoneIk::WriteStream(const size_t p_stream, const float p_value)
+{
+	m_streams[p_stream * m_streamStride + m_limbs.size()] = p_value;
+}
+
+void TwoBoneIk::WriteRotation(const size_t p_firstStream, const float* p_rows)
+{
+	for (size_t row = 0; row < 3; ++row)
+		for (size_t column = 0; column < 3; ++column)
+			WriteStream(p_firstStream + row * 3 + column, p_rows[row * 4 + column]);
+}
+
+void TwoBoneIk::AddLimb(LocalPose* p_localPose, const IkChain& p_chain, const Vector3F& p_target, const Vector3F& p_poleOffset, const float p_weight)
+{
+	const size_t bones[3]{ p_chain.upper, p_chain.middle, p_chain.end };
+	const IkStream localRotations[3]{ UpperLocalRotation, MiddleLocalRotation, EndLocalRotation };
+
+	for (size_t bone = 0; bone < 3; ++bone)
+	{
+		const QuaternionF& rotation = p_localPose[bones[bone]].rotation;
+		WriteStream(localRotations[bone], rotation.axis.x);
+		WriteStream(localRotations[bone] + 1, rotation.axis.y);
+		WriteStream(localRotations[bone] + 2, rotation.axis.z);
+		WriteStream(localRotations[bone] + 3, rotation.w);
+	}
+
+	WriteStream(Target, p_target.x);
+	WriteStream(Target + 1, p_target.y);
+	WriteStream(Target + 2, p_target.z);
+	WriteStream(PoleOffset, p_poleOffset.x);
+	WriteStream(PoleOffset + 1, p_poleOffset.y);
+	WriteStream(PoleOffset + 2, p_poleOffset.z);
+	WriteStream(Weight, p_weight);
+
+	m_limbs.push_back({ p_localPose, p_chain });
+}
+
+void TwoBoneIk::Reserve(const size_t p_capacity)
+{
+	const size_t streamStride = p_capacity + g_streamPadding;
+	std::vector<float, Memory::AlignedAllocator<float>> streams(StreamCount * streamStride, 0.0f);
+
+	for (size_t stream = 0; stream < StreamCount; ++stream)
+		std::copy(m_streams.begin() + stream * m_streamStride, m_streams.begin() + stream * m_streamStride + m_limbs.size(), streams.begin() + stream * streamStride);
+
+	m_streams = std::move(streams);
+	m_capacity = p_capacity;
+	m_streamStride = streamStride;
+}
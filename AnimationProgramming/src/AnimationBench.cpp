@@ -0,0 +1,662 @@
+#include <GPM/GPM.h>
+#include <Animation/QuaternionBatch.h>
+#include <Animation/AnimationInfo.h>
+#include <Animation/DualQuaternion.h>
+#include <Animation/SkinningPalette.h>
+#include <Resources/ResourceLoader.h>
+#include <Jobs/JobSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Number of times each case is run, the fastest run is kept to leave out the noise of the machine.
+	 */
+	constexpr size_t g_runCount = 15;
+
+	constexpr size_t g_matrixCount = 1024;
+	constexpr size_t g_matrixRepeatCount = 200;
+
+	constexpr size_t g_quaternionCount = 4096;
+	constexpr size_t g_quaternionRepeatCount = 20;
+
+	/**
+	 * @brief Number of interpolation factors, evenly spaced from 0 to 1, the errors are measured at.
+	 */
+	constexpr size_t g_alphaCount = 21;
+
+	/**
+	 * @brief Number of copies of the clip sampled one after the other, enough to leave the caches (about 100 KB of keys per copy).
+	 */
+	constexpr size_t g_clipCopyCount = 256;
+	constexpr size_t g_poseCount = 4096;
+	constexpr size_t g_jobCount = 4096;
+
+	/**
+	 * @brief Largest distance, in units of the skeleton, allowed between a vertex skinned with the dual quaternion palette and with the 4x4 palette.
+	 * Each vertex follows a single bone, so both palettes must give the same position up to the float rounding of the world pose (about 3e-4 on the walk).
+	 */
+	constexpr float g_skinningMaxError = 1e-3f;
+
+	/**
+	 * @brief Offset of the vertices placed around the bind position of each bone, in units of the skeleton.
+	 */
+	constexpr float g_skinningVertexOffset = 5.0f;
+
+	/**
+	 * @brief Receives a value computed by each case, so that the compiler can't remove the work.
+	 */
+	volatile float g_sink = 0.0f;
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: AnimationBench [--data <directory>] [cases]\n"
+			<< "Time the kernels of the animation core, every case by default. GPM picks its instruction set at compile time:\n"
+			<< "AnimationBenchScalar and AnimationBenchAvx are the same cases built without SIMD and with AVX, `cmake --build <dir> --target bench` runs them all.\n"
+			<< "  matrix                 Matrix4F operator*, transform of a Vector4F and transpose\n"
+			<< "  quaternion             QuaternionBatch::Interpolate against QuaternionF::SlerpShortestPath, and its error against a double slerp\n"
+			<< "  jobs                   Dispatch and run of empty jobs by Jobs::JobSystem with 1, 2 and 4 threads\n"
+			<< "  sample                 AnimationInfo::SamplePose of the walk against the per-bone map storage it replaced, read from <directory>/Resources (Data by default)\n"
+			<< "  skinning               DualQuaternion::SkinPoint against the 4x4 palette on the rest pose vertices of the walk, read from <directory>/Resources\n";
+	}
+
+	const char* InstructionSet()
+	{
+#if defined(GPM_SIMD_AVX)
+		return "AVX";
+#elif defined(GPM_SIMD_SSE)
+		return "SSE";
+#else
+		return "scalar";
+#endif
+	}
+
+	/**
+	 * @brief Run a case g_runCount times and return the cost of one operation in its fastest run.
+	 * @param p_operationCount The number of operations done by one run
+	 * @param p_function The case
+	 * @return The cost in nanoseconds per operation
+	 */
+	template <typename Function>
+	double BestTime(const size_t p_operationCount, Function&& p_function)
+	{
+		double best = std::numeric_limits<double>::max();
+
+		for (size_t run = 0; run < g_runCount; ++run)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			p_function();
+			const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+			best = std::min(best, duration.count());
+		}
+
+		return best / static_cast<double>(p_operationCount);
+	}
+
+	void BenchMatrix()
+	{
+		std::mt19937 generator(3);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+		std::vector<Matrix4F> matrices(g_matrixCount);
+		for (Matrix4F& matrix : matrices)
+			for (float& value : matrix.m_data)
+				value = distribution(generator);
+
+		std::vector<Vector4F> vectors(g_matrixCount);
+		for (Vector4F& vector : vectors)
+			vector = Vector4F{ distribution(generator), distribution(generator), distribution(generator), distribution(generator) };
+
+		const size_t operationCount = (g_matrixCount - 1) * g_matrixRepeatCount;
+
+		// Each product reads two matrices of the array like the hierarchy reads a parent and a local matrix
+		const double multiply = BestTime(operationCount, [&]()
+		{
+			float sum = 0.0f;
+			for (size_t repeat = 0; repeat < g_matrixRepeatCount; ++repeat)
+			{
+				for (size_t i = 0; i < g_matrixCount - 1; ++i)
+				{
+					const Matrix4F product = matrices[i] * matrices[i + 1];
+					sum += product.m_data[repeat & 15];
+				}
+			}
+			g_sink = sum;
+		});
+
+		const double transform = BestTime(operationCount, [&]()
+		{
+			float sum = 0.0f;
+			for (size_t repeat = 0; repeat < g_matrixRepeatCount; ++repeat)
+			{
+				for (size_t i = 0; i < g_matrixCount - 1; ++i)
+				{
+					const Vector4F transformed = matrices[i].Multiply(vectors[i + 1]);
+					sum += transformed.x + transformed.w;
+				}
+			}
+			g_sink = sum;
+		});
+
+		const double transpose = BestTime(operationCount, [&]()
+		{
+			float sum = 0.0f;
+			for (size_t repeat = 0; repeat < g_matrixRepeatCount; ++repeat)
+			{
+				for (size_t i = 0; i < g_matrixCount - 1; ++i)
+				{
+					const Matrix4F transposed = Matrix4F::Transpose(matrices[i]);
+					sum += transposed.m_data[repeat & 15];
+				}
+			}
+			g_sink = sum;
+		});
+
+		// The same product in every build, to check that the instruction sets agree
+		const Matrix4F check = matrices[1] * matrices[2];
+
+		std::cout << "Matrix4F (ns per operation): operator* " << multiply << ", transform " << transform << ", transpose " << transpose
+			<< ", check " << check.m_data[5] << ' ' << check.m_data[14] << '\n';
+	}
+
+	/**
+	 * @brief Quaternion pairs stored as the float streams read by QuaternionBatch.
+	 */
+	struct QuaternionPairs final
+	{
+		std::vector<float> begin[4];
+		std::vector<float> end[4];
+
+		QuaternionStreams Begin() const
+		{
+			return QuaternionStreams{ begin[0].data(), begin[1].data(), begin[2].data(), begin[3].data() };
+		}
+
+		QuaternionStreams End() const
+		{
+			return QuaternionStreams{ end[0].data(), end[1].data(), end[2].data(), end[3].data() };
+		}
+
+		QuaternionD Begin(const size_t p_index) const
+		{
+			return QuaternionD(begin[0][p_index], begin[1][p_index], begin[2][p_index], begin[3][p_index]);
+		}
+
+		QuaternionD End(const size_t p_index) const
+		{
+			return QuaternionD(end[0][p_index], end[1][p_index], end[2][p_index], end[3][p_index]);
+		}
+	};
+
+	QuaternionD RandomQuaternion(std::mt19937& p_generator)
+	{
+		std::normal_distribution<double> distribution;
+		const QuaternionD quaternion(distribution(p_generator), distribution(p_generator), distribution(p_generator), distribution(p_generator));
+		return QuaternionD::Normalize(quaternion);
+	}
+
+	/**
+	 * @brief Create random quaternion pairs.
+	 * @param p_generator The random generator
+	 * @param p_maxAngle The largest angle between the two rotations of a pair in radians, empty for pairs of independent rotations
+	 * @return The pairs
+	 */
+	QuaternionPairs CreatePairs(std::mt19937& p_generator, const std::optional<double> p_maxAngle = {})
+	{
+		std::uniform_real_distribution<double> angleDistribution(0.0, p_maxAngle.value_or(0.0));
+		QuaternionPairs pairs;
+
+		for (size_t component = 0; component < 4; ++component)
+		{
+			pairs.begin[component].resize(g_quaternionCount);
+			pairs.end[component].resize(g_quaternionCount);
+		}
+
+		for (size_t i = 0; i < g_quaternionCount; ++i)
+		{
+			const QuaternionD begin = RandomQuaternion(p_generator);
+			QuaternionD end = RandomQuaternion(p_generator);
+
+			if (p_maxAngle.has_value())
+			{
+				// The start rotated around the axis of a random quaternion, every other end on the opposite side of the hypersphere to take the shortest path
+				const double halfAngle = angleDistribution(p_generator) / 2.0;
+				const double sign = i % 2 == 0 ? 1.0 : -1.0;
+				const Vector3<double> axis = end.axis.Normalized();
+				const double scale = std::sin(halfAngle) * sign;
+
+				end = begin * QuaternionD(axis.x * scale, axis.y * scale, axis.z * scale, std::cos(halfAngle) * sign);
+			}
+
+			const double beginValues[4]{ begin.axis.x, begin.axis.y, begin.axis.z, begin.w };
+			const double endValues[4]{ end.axis.x, end.axis.y, end.axis.z, end.w };
+			for (size_t component = 0; component < 4; ++component)
+			{
+				pairs.begin[component][i] = static_cast<float>(beginValues[component]);
+				pairs.end[component][i] = static_cast<float>(endValues[component]);
+			}
+		}
+
+		return pairs;
+	}
+
+	/**
+	 * @brief Return the angle between two rotations.
+	 * @param p_first The first rotation, it doesn't need to be normalized
+	 * @param p_second The second rotation, it doesn't need to be normalized
+	 * @return The angle in radians
+	 */
+	double RotationAngle(const QuaternionD& p_first, const QuaternionD& p_second)
+	{
+		const QuaternionD first = QuaternionD::Normalize(p_first);
+		QuaternionD second = QuaternionD::Normalize(p_second);
+		if (QuaternionD::DotProduct(first, second) < 0.0)
+			second = second * -1.0;
+
+		// acos of the dot product would turn the rounding of a float quaternion into an error of 1e-3 radian, the half chord isn't sensitive to it
+		const QuaternionD difference = first - second;
+		const QuaternionD sum = first + second;
+		return 4.0 * std::atan2(std::sqrt(QuaternionD::DotProduct(difference, difference)), std::sqrt(QuaternionD::DotProduct(sum, sum)));
+	}
+
+	/**
+	 * @brief Return the largest angle between the rotations of QuaternionBatch::Interpolate and a double precision slerp, over every pair and g_alphaCount factors.
+	 * @param p_pairs The pairs
+	 * @param p_mode The interpolation
+	 * @return The angle in radians
+	 */
+	double MaxInterpolationError(const QuaternionPairs& p_pairs, const QuaternionInterpolation p_mode)
+	{
+		std::vector<LocalPose> poses(g_quaternionCount);
+		double maxError = 0.0;
+
+		for (size_t step = 0; step < g_alphaCount; ++step)
+		{
+			const double alpha = static_cast<double>(step) / static_cast<double>(g_alphaCount - 1);
+			QuaternionBatch::Interpolate(p_pairs.Begin(), p_pairs.End(), static_cast<float>(alpha), poses.data(), g_quaternionCount, p_mode);
+
+			for (size_t i = 0; i < g_quaternionCount; ++i)
+			{
+				const QuaternionD exact = QuaternionD::SlerpShortestPath(p_pairs.Begin(i), p_pairs.End(i), alpha);
+				const QuaternionF& rotation = poses[i].rotation;
+				maxError = std::max(maxError, RotationAngle(exact, QuaternionD(rotation.axis.x, rotation.axis.y, rotation.axis.z, rotation.w)));
+			}
+		}
+
+		return maxError;
+	}
+
+	/**
+	 * @brief Time QuaternionBatch::Interpolate and GPM slerp, then measure the error of QuaternionBatch against the bounds it documents.
+	 * @return False if an error is above its bound
+	 */
+	bool BenchQuaternion()
+	{
+		std::mt19937 generator(7);
+		const QuaternionPairs anyPairs = CreatePairs(generator);
+
+		// Keys closer than the fast path of ApproximateSlerp, 11.5 degrees
+		const QuaternionPairs closePairs = CreatePairs(generator, 2.0 * std::acos(static_cast<double>(QuaternionBatch::nlerpFastPathCosine)));
+
+		std::vector<LocalPose> poses(g_quaternionCount);
+		const size_t operationCount = g_quaternionCount * g_quaternionRepeatCount;
+
+		const auto batchTime = [&](const QuaternionInterpolation p_mode)
+		{
+			return BestTime(operationCount, [&]()
+			{
+				for (size_t repeat = 0; repeat < g_quaternionRepeatCount; ++repeat)
+				{
+					const float alpha = static_cast<float>(repeat) / static_cast<float>(g_quaternionRepeatCount);
+					QuaternionBatch::Interpolate(anyPairs.Begin(), anyPairs.End(), alpha, poses.data(), g_quaternionCount, p_mode);
+				}
+				g_sink = poses[3].rotation.w;
+			});
+		};
+
+		const auto slerpTime = [&](auto p_scalar)
+		{
+			using Scalar = decltype(p_scalar);
+
+			return BestTime(operationCount, [&]()
+			{
+				Scalar sum = 0;
+				for (size_t repeat = 0; repeat < g_quaternionRepeatCount; ++repeat)
+				{
+					const Scalar alpha = static_cast<Scalar>(repeat) / static_cast<Scalar>(g_quaternionRepeatCount);
+					for (size_t i = 0; i < g_quaternionCount; ++i)
+					{
+						const Quaternion<Scalar> begin(anyPairs.begin[0][i], anyPairs.begin[1][i], anyPairs.begin[2][i], anyPairs.begin[3][i]);
+						const Quaternion<Scalar> end(anyPairs.end[0][i], anyPairs.end[1][i], anyPairs.end[2][i], anyPairs.end[3][i]);
+						sum += Quaternion<Scalar>::SlerpShortestPath(begin, end, alpha).w;
+					}
+				}
+				g_sink = static_cast<float>(sum);
+			});
+		};
+
+		// Millions of quaternions per second from the cost of one in nanoseconds
+		const auto rate = [](const double p_nanoseconds) { return 1000.0 / p_nanoseconds; };
+
+		std::cout << "Quaternion interpolation (M quaternions/s): QuaternionBatch ApproximateSlerp " << rate(batchTime(QuaternionInterpolation::ApproximateSlerp))
+			<< ", Nlerp " << rate(batchTime(QuaternionInterpolation::Nlerp))
+			<< ", QuaternionF::SlerpShortestPath " << rate(slerpTime(0.0f))
+			<< ", QuaternionD::SlerpShortestPath " << rate(slerpTime(0.0)) << '\n';
+
+		const double approximateSlerpError = MaxInterpolationError(anyPairs, QuaternionInterpolation::ApproximateSlerp);
+		const double nlerpError = MaxInterpolationError(closePairs, QuaternionInterpolation::Nlerp);
+		const bool withinBounds = approximateSlerpError <= QuaternionBatch::approximateSlerpMaxError && nlerpError <= QuaternionBatch::nlerpFastPathMaxError;
+
+		std::cout << "Quaternion interpolation error (rad): ApproximateSlerp " << approximateSlerpError << " (bound " << QuaternionBatch::approximateSlerpMaxError
+			<< "), Nlerp on close keys " << nlerpError << " (bound " << QuaternionBatch::nlerpFastPathMaxError << ")"
+			<< (withinBounds ? "" : ", above the bounds of QuaternionBatch.h") << '\n';
+
+		return withinBounds;
+	}
+
+	/**
+	 * @brief The storage of the keys before AnimationInfo held them in streams: a vector of keys per bone in a hash map, rotations in double precision.
+	 */
+	using MapClip = std::unordered_map<size_t, std::vector<std::pair<Vector3F, QuaternionD>>>;
+
+	MapClip CreateMapClip(const AnimationInfo& p_clip)
+	{
+		MapClip clip;
+
+		for (size_t bone = 0; bone < p_clip.BoneCount(); ++bone)
+		{
+			for (size_t key = 0; key < p_clip.KeyCount(); ++key)
+			{
+				const std::pair<Vector3F, QuaternionF> frame = p_clip.LocalAnimFrame(bone, key);
+				clip[bone].emplace_back(frame.first, QuaternionD(frame.second.axis.x, frame.second.axis.y, frame.second.axis.z, frame.second.w));
+			}
+		}
+
+		return clip;
+	}
+
+	/**
+	 * @brief The lookup of the former AnimationInfo::LocalAnimFrame.
+	 */
+	const std::pair<Vector3F, QuaternionD>& MapClipFrame(const MapClip& p_clip, const size_t p_bone, const size_t p_key)
+	{
+		if (p_clip.count(p_bone) > 0)
+		{
+			if (p_key < p_clip.at(p_bone).size())
+				return p_clip.at(p_bone)[p_key];
+
+			throw std::out_of_range("Animation Matrix unattainable, p_frame is out of range");
+		}
+
+		throw std::out_of_range("Animation Matrix unattainable, p_boneIndex is out of range");
+	}
+
+	/**
+	 * @brief Sample a pose the way it was done before the streams: two lookups and a slerp per bone.
+	 * The lookup of the clip by its name, done per bone as well, isn't counted.
+	 */
+	void SampleMapClip(const MapClip& p_clip, const size_t p_keyCount, const float p_time, LocalPose* p_pose, const size_t p_boneCount)
+	{
+		const size_t beginKey = static_cast<size_t>(p_time) % p_keyCount;
+		const size_t endKey = static_cast<size_t>(p_time + 1.0f) % p_keyCount;
+		const float alpha = p_time - std::floor(p_time);
+
+		for (size_t bone = 0; bone < p_boneCount; ++bone)
+		{
+			// Copies, as the baseline took its keys by value
+			std::pair<Vector3F, QuaternionD> begin = MapClipFrame(p_clip, bone, beginKey);
+			std::pair<Vector3F, QuaternionD> end = MapClipFrame(p_clip, bone, endKey);
+			const QuaternionD rotation = QuaternionD::SlerpShortestPath(begin.second, end.second, alpha);
+
+			p_pose[bone].position = Vector3F::Lerp(begin.first, end.first, alpha);
+			p_pose[bone].rotation = QuaternionF(static_cast<float>(rotation.axis.x), static_cast<float>(rotation.axis.y), static_cast<float>(rotation.axis.z), static_cast<float>(rotation.w));
+		}
+	}
+
+	void BenchSample(const std::string& p_dataDirectory)
+	{
+		const std::string resources = p_dataDirectory + "/Resources/";
+		std::vector<int> fileBoneIndices;
+		const Skeleton skeleton = ResourceLoader::LoadSkeleton(resources + "ThirdPersonWalk.skel", fileBoneIndices);
+
+		AnimationInfo clip;
+		clip.SetKeyCount(ResourceLoader::ReadAnimationKeyCount(resources + "ThirdPersonWalk.anim"));
+		clip.SetBoneCount(skeleton.BoneCount());
+		ResourceLoader::LoadAnimation(resources + "ThirdPersonWalk.anim", fileBoneIndices, clip);
+
+		const size_t boneCount = clip.BoneCount();
+		const float keyCount = static_cast<float>(clip.KeyCount());
+		std::vector<LocalPose> pose(boneCount);
+
+		// The copies are sampled in turn so that every pose reads keys that aren't in the caches anymore
+		const std::vector<AnimationInfo> clips(g_clipCopyCount, clip);
+		std::vector<MapClip> mapClips;
+		for (size_t copy = 0; copy < g_clipCopyCount; ++copy)
+			mapClips.push_back(CreateMapClip(clip));
+
+		const auto time = [keyCount](const size_t p_pose) { return std::fmod(static_cast<float>(p_pose) * 0.37f, keyCount); };
+
+		const auto streamTime = [&](const size_t p_copyCount)
+		{
+			return BestTime(g_poseCount, [&]()
+			{
+				for (size_t i = 0; i < g_poseCount; ++i)
+					clips[i % p_copyCount].SamplePose(time(i), pose.data(), boneCount);
+				g_sink = pose[3].rotation.w;
+			});
+		};
+
+		const auto mapTime = [&](const size_t p_copyCount)
+		{
+			return BestTime(g_poseCount, [&]()
+			{
+				for (size_t i = 0; i < g_poseCount; ++i)
+					SampleMapClip(mapClips[i % p_copyCount], clip.KeyCount(), time(i), pose.data(), boneCount);
+				g_sink = pose[3].rotation.w;
+			});
+		};
+
+		std::cout << "SamplePose of the walk, " << boneCount << " bones (ns per pose): streams " << streamTime(1) << ", map " << mapTime(1)
+			<< ", out of the caches (" << g_clipCopyCount << " copies): streams " << streamTime(g_clipCopyCount) << ", map " << mapTime(g_clipCopyCount) << '\n';
+	}
+
+	/**
+	 * @brief Skin a vertex with a 4x4 palette the way skinning.vs does: the sum of the palette matrices of its bones, weighted, applied to the point.
+	 * @param p_palette The palette written by SkinningPalette::Write in SkinningPaletteMode::Matrix4x4
+	 * @param p_boneIndices The 4 bone indices of the vertex
+	 * @param p_boneWeights The 4 bone weights of the vertex
+	 * @param p_point The bind pose position of the vertex
+	 * @return The skinned position
+	 */
+	Vector3F SkinPointMatrix(const float* p_palette, const int p_boneIndices[4], const float p_boneWeights[4], const Vector3F& p_point)
+	{
+		float skinned[3]{ 0.0f, 0.0f, 0.0f };
+
+		for (int i = 0; i < 4; ++i)
+		{
+			const float* matrix = &p_palette[p_boneIndices[i] * 16];
+
+			for (int row = 0; row < 3; ++row)
+			{
+				const float* rowData = matrix + row * 4;
+				skinned[row] += p_boneWeights[i] * (rowData[0] * p_point.x + rowData[1] * p_point.y + rowData[2] * p_point.z + rowData[3]);
+			}
+		}
+
+		return Vector3F{ skinned[0], skinned[1], skinned[2] };
+	}
+
+	/**
+	 * @brief Skin vertices placed around the bind position of every bone with the dual quaternion palette and with the 4x4 palette, on a pose per half key of the walk.
+	 * Each vertex is weighted on its bone alone, its parent taking the 3 other influences with a weight of 0, so that the two blends must agree.
+	 * @param p_dataDirectory The directory holding Resources
+	 * @return False if a distance is above g_skinningMaxError
+	 */
+	bool BenchSkinning(const std::string& p_dataDirectory)
+	{
+		const std::string resources = p_dataDirectory + "/Resources/";
+		std::vector<int> fileBoneIndices;
+		const Skeleton skeleton = ResourceLoader::LoadSkeleton(resources + "ThirdPersonWalk.skel", fileBoneIndices);
+
+		AnimationInfo clip;
+		clip.SetKeyCount(ResourceLoader::ReadAnimationKeyCount(resources + "ThirdPersonWalk.anim"));
+		clip.SetBoneCount(skeleton.BoneCount());
+		ResourceLoader::LoadAnimation(resources + "ThirdPersonWalk.anim", fileBoneIndices, clip);
+
+		const size_t boneCount = skeleton.BoneCount();
+
+		// The bind position of each bone, and a vertex on both sides of it along every axis
+		std::vector<Vector3F> vertices;
+		std::vector<int> vertexBones;
+		for (size_t bone = 0; bone < boneCount; ++bone)
+		{
+			const Vector3F position = DualQuaternion::Translation(DualQuaternion::InverseRigid(skeleton.InverseBindDualQuaternion(bone)));
+			const Vector3F offsets[7]{
+				Vector3F{ 0.0f, 0.0f, 0.0f },
+				Vector3F{ g_skinningVertexOffset, 0.0f, 0.0f }, Vector3F{ -g_skinningVertexOffset, 0.0f, 0.0f },
+				Vector3F{ 0.0f, g_skinningVertexOffset, 0.0f }, Vector3F{ 0.0f, -g_skinningVertexOffset, 0.0f },
+				Vector3F{ 0.0f, 0.0f, g_skinningVertexOffset }, Vector3F{ 0.0f, 0.0f, -g_skinningVertexOffset } };
+
+			for (const Vector3F& offset : offsets)
+			{
+				vertices.push_back(Vector3F{ position.x + offset.x, position.y + offset.y, position.z + offset.z });
+				vertexBones.push_back(static_cast<int>(bone));
+			}
+		}
+
+		std::vector<LocalPose> pose(boneCount);
+		std::vector<Matrix4F> worldMatrices(boneCount);
+		std::vector<DualQuaternion> worldDualQuaternions(boneCount);
+		std::vector<float> matrixPalette(boneCount * SkinningPalette::FloatsPerBone(SkinningPaletteMode::Matrix4x4));
+		std::vector<float> dualQuaternionPalette(boneCount * SkinningPalette::FloatsPerBone(SkinningPaletteMode::DualQuaternion));
+		std::vector<DualQuaternion> dualQuaternions(boneCount);
+
+		const size_t poseCount = clip.KeyCount() * 2;
+		const float boneWeights[4]{ 1.0f, 0.0f, 0.0f, 0.0f };
+		float maxError = 0.0f;
+
+		for (size_t poseIndex = 0; poseIndex < poseCount; ++poseIndex)
+		{
+			clip.SamplePose(static_cast<float>(poseIndex) * 0.5f, pose.data(), boneCount);
+			skeleton.ComputeWorldPose(pose.data(), worldMatrices.data());
+			skeleton.ComputeWorldPose(pose.data(), worldDualQuaternions.data());
+			SkinningPalette::Write(skeleton, worldMatrices.data(), SkinningPaletteMode::Matrix4x4, matrixPalette.data());
+			SkinningPalette::Write(skeleton, worldDualQuaternions.data(), dualQuaternionPalette.data());
+
+			// Read back the palette as sent to skinning_dq.vs
+			for (size_t bone = 0; bone < boneCount; ++bone)
+			{
+				const float* entry = &dualQuaternionPalette[bone * 8];
+				dualQuaternions[bone].real = Vector4F{ entry[0], entry[1], entry[2], entry[3] };
+				dualQuaternions[bone].dual = Vector4F{ entry[4], entry[5], entry[6], entry[7] };
+			}
+
+			for (size_t vertex = 0; vertex < vertices.size(); ++vertex)
+			{
+				const int bone = vertexBones[vertex];
+				const int parent = std::max(skeleton.ParentIndex(static_cast<size_t>(bone)), 0);
+				const int boneIndices[4]{ bone, parent, parent, parent };
+
+				const Vector3F dualQuaternion = DualQuaternion::SkinPoint(dualQuaternions.data(), boneIndices, boneWeights, vertices[vertex]);
+				const Vector3F matrix = SkinPointMatrix(matrixPalette.data(), boneIndices, boneWeights, vertices[vertex]);
+				const Vector3F difference{ dualQuaternion.x - matrix.x, dualQuaternion.y - matrix.y, dualQuaternion.z - matrix.z };
+
+				maxError = std::max(maxError, std::sqrt(difference.x * difference.x + difference.y * difference.y + difference.z * difference.z));
+			}
+		}
+
+		const bool withinBound = maxError <= g_skinningMaxError;
+
+		std::cout << "Skinning of " << vertices.size() << " rest pose vertices on " << poseCount << " poses of the walk, DualQuaternion::SkinPoint against the 4x4 palette: distance "
+			<< maxError << " (bound " << g_skinningMaxError << ")" << (withinBound ? "" : ", the palettes disagree") << '\n';
+
+		return withinBound;
+	}
+
+	void BenchJobs()
+	{
+		std::cout << "JobSystem::ParallelFor of " << g_jobCount << " empty jobs (ns per job): ";
+
+		for (const size_t threadCount : { 1, 2, 4 })
+		{
+			Jobs::JobSystem jobs(threadCount);
+			std::vector<size_t> ends(g_jobCount);
+
+			const double time = BestTime(g_jobCount, [&]()
+			{
+				jobs.ParallelFor(g_jobCount, 1, [&ends](const size_t p_begin, const size_t p_end) { ends[p_begin] = p_end; });
+				g_sink = static_cast<float>(ends[g_jobCount / 2]);
+			});
+
+			std::cout << (threadCount == 1 ? "1 thread " : ", ") << (threadCount == 1 ? "" : std::to_string(threadCount) + " threads ") << time;
+		}
+
+		std::cout << " (" << std::thread::hardware_concurrency() << " hardware threads)\n";
+	}
+}
+
+int main(int p_argc, char** p_argv)
+{
+	try
+	{
+		std::vector<std::string> cases;
+		std::string dataDirectory = "Data";
+
+		for (int i = 1; i < p_argc; ++i)
+		{
+			if (std::strcmp(p_argv[i], "--data") == 0 && i + 1 < p_argc)
+			{
+				dataDirectory = p_argv[++i];
+			}
+			else if (std::strcmp(p_argv[i], "matrix") == 0 || std::strcmp(p_argv[i], "quaternion") == 0 || std::strcmp(p_argv[i], "jobs") == 0
+				|| std::strcmp(p_argv[i], "sample") == 0 || std::strcmp(p_argv[i], "skinning") == 0)
+			{
+				cases.emplace_back(p_argv[i]);
+			}
+			else
+			{
+				PrintUsage();
+				return std::strcmp(p_argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+			}
+		}
+
+		const auto selected = [&cases](const char* p_case)
+		{
+			return cases.empty() || std::find(cases.begin(), cases.end(), p_case) != cases.end();
+		};
+
+		std::cout << "Instruction set: " << InstructionSet() << '\n';
+
+		if (selected("matrix"))
+			BenchMatrix();
+		if (selected("quaternion") && !BenchQuaternion())
+			return EXIT_FAILURE;
+		if (selected("jobs"))
+			BenchJobs();
+		if (selected("sample"))
+			BenchSample(dataDirectory);
+		if (selected("skinning") && !BenchSkinning(dataDirectory))
+			return EXIT_FAILURE;
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << p_exception.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+#include <Engine/Engine.h>
+#include <Engine/HeadlessEngine.h>
+#include <Animation/Animation.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cout << "Usage: AnimationHeadless [options]\n"
+			<< "  --data <directory>     Directory holding Resources/, Data by default\n"
+			<< "  --frames <count>       Number of frames to update, 600 by default\n"
+			<< "  --delta <seconds>      Fixed time between 2 frames, 1/60 by default\n"
+			<< "  --deltas <file>        Replay the times between 2 frames listed in a file, in a loop\n"
+			<< "  --clip <name>          Clip played, ThirdPersonWalk.anim by default\n"
+			<< "  --storage <storage>    Copy of the clips sampled: keys (default), compressed or reduced\n"
+			<< "  --locomotion <speed>   Drive the walk and the run by a speed in units per second instead of playing one clip\n"
+			<< "  --layer <mode> <clip> <bone> <weight>\n"
+			<< "                         Add an override or additive layer of a clip on a bone and its descendants\n"
+			<< "  --ik <bone> <x> <y> <z>\n"
+			<< "                         Reach a position with the end bone of a limb (foot_l, hand_r...), on the main character and the crowd\n"
+			<< "  --crowd <count>        Animate a crowd of instances next to the main character\n"
+			<< "  --crowd-lod <spacing>  Use levels of detail in the crowd, instance i being at the distance i * spacing\n"
+			<< "  --threads <count>      Threads running the update, 0 for one per hardware thread, 1 for no job system (default)\n"
+			<< "  --no-debug-draw        Skip the axis and skeleton lines\n";
+	}
+
+	/**
+	 * @brief Read the times between 2 frames from a text file, separated by spaces or new lines.
+	 * @param p_path The path of the file
+	 * @return The times
+	 * @throw std::runtime_error if the file can't be read or is empty
+	 */
+	std::vector<float> ReadDeltaTimes(const std::string& p_path)
+	{
+		std::ifstream file(p_path);
+		if (!file)
+			throw std::runtime_error("Frame times can't be read from " + p_path);
+
+		std::vector<float> deltaTimes;
+		for (float deltaTime; file >> deltaTime;)
+			deltaTimes.push_back(deltaTime);
+
+		if (deltaTimes.empty())
+			throw std::runtime_error("No frame time in " + p_path);
+
+		return deltaTimes;
+	}
+
+	float Percentile(std::vector<float> p_values, const float p_percentile)
+	{
+		const size_t rank = std::min(p_values.size() - 1, static_cast<size_t>(p_percentile * static_cast<float>(p_values.size())));
+		std::nth_element(p_values.begin(), p_values.begin() + rank, p_values.end());
+		return p_values[rank];
+	}
+}
+
+int main(int p_argc, char** p_argv)
+{
+	try
+	{
+		Engine::HeadlessSettings settings;
+		std::string dataDirectory = "Data";
+		std::string clipName = WALK_ANIM;
+		ClipStorage clipStorage = ClipStorage::Keys;
+		std::optional<float> locomotionSpeed;
+		std::vector<std::tuple<LayerBlendMode, std::string, std::string, float>> layers;
+		std::vector<std::pair<std::string, Vector3F>> ikTargets;
+		size_t crowdSize = 0;
+		std::optional<float> crowdLodSpacing;
+		size_t threadCount = 1;
+		bool debugDraw = true;
+
+		for (int i = 1; i < p_argc; ++i)
+		{
+			const auto nextArgument = [&]() -> std::string
+			{
+				if (i + 1 >= p_argc)
+					throw std::invalid_argument(std::string("Missing value after ") + p_argv[i]);
+				return p_argv[++i];
+			};
+
+			if (std::strcmp(p_argv[i], "--data") == 0)
+				dataDirectory = nextArgument();
+			else if (std::strcmp(p_argv[i], "--frames") == 0)
+				settings.frameCount = std::stoul(nextArgument());
+			else if (std::strcmp(p_argv[i], "--delta") == 0)
+				settings.fixedDeltaTime = std::stof(nextArgument());
+			else if (std::strcmp(p_argv[i], "--deltas") == 0)
+				settings.recordedDeltaTimes = ReadDeltaTimes(nextArgument());
+			else if (std::strcmp(p_argv[i], "--clip") == 0)
+				clipName = nextArgument();
+			else if (std::strcmp(p_argv[i], "--storage") == 0)
+			{
+				const std::string storage = nextArgument();
+				if (storage == "keys")
+					clipStorage = ClipStorage::Keys;
+				else if (storage == "compressed")
+					clipStorage = ClipStorage::Compressed;
+				else if (storage == "reduced")
+					clipStorage = ClipStorage::Reduced;
+				else
+					throw std::invalid_argument("Unknown clip storage " + storage + ", expected keys, compressed or reduced");
+			}
+			else if (std::strcmp(p_argv[i], "--locomotion") == 0)
+				locomotionSpeed = std::stof(nextArgument());
+			else if (std::strcmp(p_argv[i], "--layer") == 0)
+			{
+				const std::string mode = nextArgument();
+				if (mode != "override" && mode != "additive")
+					throw std::invalid_argument("Unknown layer mode " + mode + ", expected override or additive");
+
+				std::string layerClip = nextArgument();
+				std::string rootBone = nextArgument();
+				layers.emplace_back(mode == "additive" ? LayerBlendMode::Additive : LayerBlendMode::Override, std::move(layerClip), std::move(rootBone), std::stof(nextArgument()));
+			}
+			else if (std::strcmp(p_argv[i], "--ik") == 0)
+			{
+				std::string endBone = nextArgument();
+				const float x = std::stof(nextArgument());
+				const float y = std::stof(nextArgument());
+				ikTargets.emplace_back(std::move(endBone), Vector3F{ x, y, std::stof(nextArgument()) });
+			}
+			else if (std::strcmp(p_argv[i], "--crowd") == 0)
+				crowdSize = std::stoul(nextArgument());
+			else if (std::strcmp(p_argv[i], "--crowd-lod") == 0)
+				crowdLodSpacing = std::stof(nextArgument());
+			else if (std::strcmp(p_argv[i], "--threads") == 0)
+				threadCount = std::stoul(nextArgument());
+			else if (std::strcmp(p_argv[i], "--no-debug-draw") == 0)
+				debugDraw = false;
+			else
+			{
+				PrintUsage();
+				return std::strcmp(p_argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+			}
+		}
+
+		// The simulation reads its resources relative to the working directory, like under the engine
+		std::filesystem::current_path(dataDirectory);
+		Engine::HeadlessEngine::Configure(settings);
+
+		CSimulation simulation(clipName);
+		simulation.SetDebugDraw(debugDraw);
+		simulation.SetClipStorage(clipStorage);
+		simulation.SetLocomotionSpeed(locomotionSpeed);
+		for (const auto& [mode, layerClip, rootBone, weight] : layers)
+			simulation.AddLayer(layerClip, mode, rootBone, weight);
+		for (const auto& [endBone, target] : ikTargets)
+			simulation.SetIkTarget(simulation.AddIkLimb(endBone), target);
+		if (crowdLodSpacing.has_value())
+		{
+			std::vector<float> metrics(crowdSize);
+			for (size_t i = 0; i < crowdSize; ++i)
+				metrics[i] = static_cast<float>(i) * crowdLodSpacing.value();
+
+			simulation.SetCrowdLod(true);
+			simulation.SetCrowdLodMetrics(std::move(metrics));
+		}
+		simulation.SetCrowdSize(crowdSize);
+		simulation.SetThreadCount(threadCount);
+		Run(&simulation, 1400, 800);
+
+		const Engine::HeadlessReport& report = Engine::HeadlessEngine::Report();
+		const std::vector<float>& frames = report.frameDurations;
+		const size_t frameCount = std::max<size_t>(frames.size(), 1);
+
+		const ClipImportReport& clipImport = simulation.GetClipImportReport();
+		const char* clipSource = clipImport.source == ClipSource::Cache ? "the cache" : clipImport.source == ClipSource::Resources ? "the resources" : "the engine";
+
+		std::cout << "Threads: " << simulation.ThreadCount() << '\n'
+			<< "Init: " << report.initDuration << " ms, clips imported from " << clipSource << " in " << clipImport.duration << " ms\n"
+			<< "Frames: " << frames.size() << '\n';
+
+		if (!frames.empty())
+		{
+			std::cout << "Frame cost (us): mean " << std::accumulate(frames.begin(), frames.end(), 0.0) / static_cast<double>(frames.size())
+				<< ", median " << Percentile(frames, 0.5f)
+				<< ", p99 " << Percentile(frames, 0.99f)
+				<< ", max " << *std::max_element(frames.begin(), frames.end()) << '\n';
+		}
+
+		std::cout << "DrawLine calls: " << report.drawLineCount << " (" << report.drawLineCount / frameCount << " per frame)\n"
+			<< "SetSkinningPose calls: " << report.skinningPoseCount << ", last palette " << report.lastPalette.size() << " floats\n"
+			<< "Palette hash: " << std::hex << report.paletteHash << std::dec << '\n';
+
+		const Vector3F rootPosition = simulation.RootPosition();
+		std::cout << "Root motion: " << rootPosition.x << ' ' << rootPosition.y << ' ' << rootPosition.z << '\n';
+
+		for (const auto& [endBone, target] : ikTargets)
+		{
+			const Vector3F position = simulation.BoneWorldPosition(simulation.GetBoneFromName(endBone).value());
+			const Vector3F error{ position.x - target.x, position.y - target.y, position.z - target.z };
+			std::cout << "IK " << endBone << ": " << position.x << ' ' << position.y << ' ' << position.z
+				<< ", " << std::sqrt(error.x * error.x + error.y * error.y + error.z * error.z) << " from the target\n";
+		}
+
+		if (const Crowd* crowd = simulation.GetCrowd())
+		{
+			// The engine only receives the palette of the main character, the crowd palettes are hashed here
+			uint64_t crowdHash = 14695981039346656037ull;
+			for (CrowdInstanceId instance = 0; instance < crowd->Count(); ++instance)
+			{
+				const unsigned char* bytes = reinterpret_cast<const unsigned char*>(crowd->Palette(instance));
+				for (size_t i = 0; i < crowd->PaletteBlockCount() * 16 * sizeof(float); ++i)
+					crowdHash = (crowdHash ^ bytes[i]) * 1099511628211ull;
+			}
+
+			std::cout << "Crowd: " << crowd->Count() << " instances, " << Crowd::InstanceStateSize() << " bytes of state and "
+				<< crowd->PaletteBlockCount() * 16 * sizeof(float) << " bytes of palette each, last palettes hash " << std::hex << crowdHash << std::dec << '\n';
+		}
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << p_exception.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,190 @@
+#include <Engine/HeadlessEngine.h>
+#include <Engine/Simulation.h>
+#include <Resources/ResourceLoader.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+	constexpr uint64_t g_hashPrime = 1099511628211ull;
+	constexpr size_t g_paletteBlockSize = 16;
+
+	struct HeadlessState final
+	{
+		Engine::HeadlessSettings settings;
+		Engine::HeadlessReport report;
+		std::unique_ptr<Skeleton> skeleton;
+		std::vector<int> fileBoneIndices;
+		std::map<std::string, AnimationInfo, std::less<>> clips;
+	};
+
+	HeadlessState& State()
+	{
+		static HeadlessState state;
+		return state;
+	}
+
+	const Skeleton& LoadedSkeleton()
+	{
+		HeadlessState& state = State();
+
+		if (state.skeleton == nullptr)
+			state.skeleton = std::make_unique<Skeleton>(ResourceLoader::LoadSkeleton(state.settings.resourcesDirectory + state.settings.skeletonName, state.fileBoneIndices));
+
+		return *state.skeleton;
+	}
+
+	const AnimationInfo& LoadedClip(const char* p_animName)
+	{
+		HeadlessState& state = State();
+		const Skeleton& skeleton = LoadedSkeleton();
+
+		const auto clip = state.clips.find(p_animName);
+		if (clip != state.clips.end())
+			return clip->second;
+
+		const std::string path = state.settings.resourcesDirectory + p_animName;
+		AnimationInfo animation;
+		animation.SetKeyCount(ResourceLoader::ReadAnimationKeyCount(path));
+		animation.SetBoneCount(skeleton.BoneCount());
+		ResourceLoader::LoadAnimation(path, state.fileBoneIndices, animation);
+
+		return state.clips.emplace(p_animName, std::move(animation)).first->second;
+	}
+
+	size_t CheckedBoneIndex(const int p_boneIndex)
+	{
+		if (p_boneIndex < 0 || static_cast<size_t>(p_boneIndex) >= LoadedSkeleton().BoneCount())
+			throw std::out_of_range("Headless engine: bone index " + std::to_string(p_boneIndex) + " is out of range");
+
+		return static_cast<size_t>(p_boneIndex);
+	}
+}
+
+ISimulation::~ISimulation()
+{
+}
+
+void Engine::HeadlessEngine::Configure(const HeadlessSettings& p_settings)
+{
+	HeadlessState& state = State();
+
+	state.settings = p_settings;
+	state.skeleton.reset();
+	state.fileBoneIndices.clear();
+	state.clips.clear();
+}
+
+const Engine::HeadlessReport& Engine::HeadlessEngine::Report()
+{
+	return State().report;
+}
+
+void Run(ISimulation* pSimulation, unsigned int, unsigned int)
+{
+	using Clock = std::chrono::steady_clock;
+
+	HeadlessState& state = State();
+	const Engine::HeadlessSettings& settings = state.settings;
+	const std::vector<float>& recordedDeltaTimes = settings.recordedDeltaTimes;
+
+	state.report = {};
+	state.report.frameDurations.reserve(settings.frameCount);
+
+	const Clock::time_point initStart = Clock::now();
+	pSimulation->Init();
+	state.report.initDuration = std::chrono::duration<double, std::milli>(Clock::now() - initStart).count();
+
+	for (size_t frame = 0; frame < settings.frameCount; ++frame)
+	{
+		const float deltaTime = recordedDeltaTimes.empty() ? settings.fixedDeltaTime : recordedDeltaTimes[frame % recordedDeltaTimes.size()];
+
+		const Clock::time_point frameStart = Clock::now();
+		pSimulation->Update(deltaTime);
+		state.report.frameDurations.push_back(std::chrono::duration<float, std::micro>(Clock::now() - frameStart).count());
+	}
+}
+
+void SetSkinningPose(const float* boneMatrices, size_t boneCount)
+{
+	HeadlessState& state = State();
+	Engine::HeadlessReport& report = state.report;
+	const size_t floatCount = boneCount * g_paletteBlockSize;
+
+	report.lastPalette.assign(boneMatrices, boneMatrices + floatCount);
+	if (state.settings.capturePalettes)
+		report.palettes.insert(report.palettes.end(), boneMatrices, boneMatrices + floatCount);
+
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(boneMatrices);
+	for (size_t i = 0; i < floatCount * sizeof(float); ++i)
+	{
+		report.paletteHash ^= bytes[i];
+		report.paletteHash *= g_hashPrime;
+	}
+
+	++report.skinningPoseCount;
+}
+
+size_t GetSkeletonBoneCount()
+{
+	return LoadedSkeleton().BoneCount();
+}
+
+const char* GetSkeletonBoneName(int boneIndex)
+{
+	return LoadedSkeleton().BoneName(CheckedBoneIndex(boneIndex)).c_str();
+}
+
+int GetSkeletonBoneIndex(const char* name)
+{
+	const std::optional<size_t> boneIndex = LoadedSkeleton().BoneIndex(name);
+	return boneIndex.has_value() ? static_cast<int>(boneIndex.value()) : -1;
+}
+
+int GetSkeletonBoneParentIndex(int boneIndex)
+{
+	return LoadedSkeleton().ParentIndex(CheckedBoneIndex(boneIndex));
+}
+
+void GetSkeletonBoneLocalBindTransform(int boneIndex, float& posX, float& posY, float& posZ, float& quatW, float& quatX, float& quatY, float& quatZ)
+{
+	const DualQuaternion& bind = LoadedSkeleton().LocalBindDualQuaternion(CheckedBoneIndex(boneIndex));
+	const Vector3F position = DualQuaternion::Translation(bind);
+
+	posX = position.x;
+	posY = position.y;
+	posZ = position.z;
+	quatW = bind.real.w;
+	quatX = bind.real.x;
+	quatY = bind.real.y;
+	quatZ = bind.real.z;
+}
+
+size_t GetAnimKeyCount(const char* animName)
+{
+	return LoadedClip(animName).KeyCount();
+}
+
+void GetAnimLocalBoneTransform(const char* animName, int boneIndex, int keyFrameIndex, float& posX, float& posY, float& posZ, float& quatW, float& quatX, float& quatY, float& quatZ)
+{
+	const AnimationInfo& animation = LoadedClip(animName);
+	if (keyFrameIndex < 0 || static_cast<size_t>(keyFrameIndex) >= animation.KeyCount())
+		throw std::out_of_range("Headless engine: key " + std::to_string(keyFrameIndex) + " is out of range");
+
+	const auto [position, rotation] = animation.LocalAnimFrame(CheckedBoneIndex(boneIndex), static_cast<size_t>(keyFrameIndex));
+
+	posX = position.x;
+	posY = position.y;
+	posZ = position.z;
+	quatW = rotation.w;
+	quatX = rotation.axis.x;
+	quatY = rotation.axis.y;
+	quatZ = rotation.axis.z;
+}
+
+void DrawLine(float, float, float, float, float, float, float, float, float)
+{
+	++State().report.drawLineCount;
+}
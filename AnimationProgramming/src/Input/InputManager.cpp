@@ -1,4 +1,6 @@
 #include <Input/InputManager.h>
+
+#if defined(_WIN32) && !defined(ENGINE_HEADLESS)
 #include <Windows.h>
 
 bool Input::InputManager::IsKeyPressed(const char p_key)
@@ -10,3 +12,10 @@ bool Input::InputManager::IsKeyPressed(const char p_key)
 
 	return false;
 }
+#else
+bool Input::InputManager::IsKeyPressed(const char)
+{
+	// No keyboard without the engine window
+	return false;
+}
+#endif
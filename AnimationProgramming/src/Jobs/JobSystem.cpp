@@ -0,0 +1,189 @@
+#include <Jobs/JobSystem.h>
+#include <algorithm>
+
+namespace
+{
+	/**
+	 * @brief Index of the calling thread in the job system, 0 for any thread it didn't start.
+	 */
+	thread_local size_t t_threadIndex = 0;
+}
+
+bool Jobs::JobCounter::IsDone() const
+{
+	return m_pending.load(std::memory_order_acquire) == 0;
+}
+
+Jobs::JobSystem::JobSystem(const size_t p_threadCount)
+{
+	const size_t threadCount = p_threadCount != 0 ? p_threadCount : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+	for (size_t i = 0; i < threadCount; ++i)
+		m_queues.push_back(std::make_unique<WorkerQueue>());
+
+	for (size_t i = 1; i < threadCount; ++i)
+		m_threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+Jobs::JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_stopping = true;
+	}
+
+	m_wake.notify_all();
+
+	for (std::thread& thread : m_threads)
+		thread.join();
+}
+
+size_t Jobs::JobSystem::ThreadCount() const
+{
+	return m_queues.size();
+}
+
+size_t Jobs::JobSystem::ThreadIndex()
+{
+	return t_threadIndex;
+}
+
+void Jobs::JobSystem::Dispatch(const Job& p_job, JobCounter& p_counter, JobCounter* p_dependency)
+{
+	p_counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	if (p_dependency != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(p_dependency->m_mutex);
+
+		// Started by the last job of the dependency, see Finish
+		if (p_dependency->m_pending.load(std::memory_order_acquire) != 0)
+		{
+			p_dependency->m_continuations.emplace_back(p_job, &p_counter);
+			return;
+		}
+	}
+
+	Push({ p_job, &p_counter });
+}
+
+void Jobs::JobSystem::Wait(JobCounter& p_counter)
+{
+	while (!p_counter.IsDone())
+	{
+		if (!TryRunJob(ThreadIndex()))
+			std::this_thread::yield();
+	}
+
+	// The last job may still hold the lock of the counter, it is released before the counter can go out of scope
+	std::exception_ptr exception;
+	{
+		std::lock_guard<std::mutex> lock(p_counter.m_mutex);
+		std::swap(exception, p_counter.m_exception);
+	}
+
+	if (exception != nullptr)
+		std::rethrow_exception(exception);
+}
+
+void Jobs::JobSystem::Push(const QueuedJob& p_job)
+{
+	WorkerQueue& queue = *m_queues[ThreadIndex() < m_queues.size() ? ThreadIndex() : 0];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(p_job);
+	}
+
+	// Both sequentially consistent: either this push sees a worker going to sleep, or that worker sees the job in its wait predicate
+	m_queuedJobCount.fetch_add(1, std::memory_order_seq_cst);
+	if (m_sleepingCount.load(std::memory_order_seq_cst) == 0)
+		return;
+
+	// Taking the lock orders the push with a worker checking the count before it sleeps, no wake up is lost
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+	}
+	m_wake.notify_one();
+}
+
+bool Jobs::JobSystem::TryRunJob(const size_t p_threadIndex)
+{
+	const size_t queueCount = m_queues.size();
+	QueuedJob queuedJob{};
+	bool found = false;
+
+	for (size_t i = 0; i < queueCount && !found; ++i)
+	{
+		WorkerQueue& queue = *m_queues[(p_threadIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (queue.jobs.empty())
+			continue;
+
+		// Own queue from the back, the others from the front
+		if (i == 0)
+		{
+			queuedJob = queue.jobs.back();
+			queue.jobs.pop_back();
+		}
+		else
+		{
+			queuedJob = queue.jobs.front();
+			queue.jobs.pop_front();
+		}
+
+		found = true;
+	}
+
+	if (!found)
+		return false;
+
+	m_queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+
+	try
+	{
+		queuedJob.job.function(queuedJob.job.data, queuedJob.job.begin, queuedJob.job.end);
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(queuedJob.counter->m_mutex);
+		if (queuedJob.counter->m_exception == nullptr)
+			queuedJob.counter->m_exception = std::current_exception();
+	}
+
+	Finish(*queuedJob.counter);
+	return true;
+}
+
+void Jobs::JobSystem::Finish(JobCounter& p_counter)
+{
+	std::vector<std::pair<Job, JobCounter*>> continuations;
+	{
+		// Decremented under the lock: a dispatch depending on this counter either sees it pending and is registered as a continuation, or sees it done
+		std::lock_guard<std::mutex> lock(p_counter.m_mutex);
+		if (p_counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			std::swap(continuations, p_counter.m_continuations);
+	}
+
+	for (const auto& [job, counter] : continuations)
+		Push({ job, counter });
+}
+
+void Jobs::JobSystem::WorkerLoop(const size_t p_threadIndex)
+{
+	t_threadIndex = p_threadIndex;
+
+	while (true)
+	{
+		if (TryRunJob(p_threadIndex))
+			continue;
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+		m_wake.wait(lock, [this]() { return m_stopping || m_queuedJobCount.load(std::memory_order_seq_cst) > 0; });
+		m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+
+		if (m_stopping && m_queuedJobCount.load(std::memory_order_acquire) == 0)
+			return;
+	}
+}
@@ -0,0 +1,123 @@
+#include <Memory/MappedFile.h>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Memory::MappedFile::MappedFile(const std::string& p_path)
+{
+#if defined(_WIN32)
+	m_file = CreateFileA(p_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		m_file = nullptr;
+		throw std::runtime_error("File " + p_path + " can't be opened");
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+	{
+		Close();
+		throw std::runtime_error("File " + p_path + " is empty or its size is unreadable");
+	}
+
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	const void* view = m_mapping != nullptr ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (view == nullptr)
+	{
+		Close();
+		throw std::runtime_error("File " + p_path + " can't be mapped");
+	}
+
+	m_data = static_cast<const std::byte*>(view);
+	m_size = static_cast<size_t>(size.QuadPart);
+#else
+	const int file = open(p_path.c_str(), O_RDONLY);
+	if (file == -1)
+		throw std::runtime_error("File " + p_path + " can't be opened");
+
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size == 0)
+	{
+		close(file);
+		throw std::runtime_error("File " + p_path + " is empty or its size is unreadable");
+	}
+
+	// The mapping keeps its own reference to the file, the descriptor isn't needed anymore
+	void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+
+	if (view == MAP_FAILED)
+		throw std::runtime_error("File " + p_path + " can't be mapped");
+
+	m_data = static_cast<const std::byte*>(view);
+	m_size = static_cast<size_t>(status.st_size);
+#endif
+}
+
+Memory::MappedFile::MappedFile(MappedFile&& p_other) noexcept
+{
+	*this = std::move(p_other);
+}
+
+Memory::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+Memory::MappedFile& Memory::MappedFile::operator=(MappedFile&& p_other) noexcept
+{
+	if (this == &p_other)
+		return *this;
+
+	Close();
+
+	m_data = std::exchange(p_other.m_data, nullptr);
+	m_size = std::exchange(p_other.m_size, 0);
+#if defined(_WIN32)
+	m_file = std::exchange(p_other.m_file, nullptr);
+	m_mapping = std::exchange(p_other.m_mapping, nullptr);
+#endif
+
+	return *this;
+}
+
+const std::byte* Memory::MappedFile::Data() const
+{
+	return m_data;
+}
+
+size_t Memory::MappedFile::Size() const
+{
+	return m_size;
+}
+
+void Memory::MappedFile::Close()
+{
+#if defined(_WIN32)
+	if (m_data != nullptr)
+		UnmapViewOfFile(m_data);
+	if (m_mapping != nullptr)
+		CloseHandle(m_mapping);
+	if (m_file != nullptr)
+		CloseHandle(m_file);
+
+	m_file = nullptr;
+	m_mapping = nullptr;
+#else
+	if (m_data != nullptr)
+		munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+}
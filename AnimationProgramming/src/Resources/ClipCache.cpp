@@ -0,0 +1,266 @@
+#include <Resources/ClipCache.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	constexpr char g_magic[8] = { 'A', 'N', 'I', 'M', 'K', 'E', 'Y', 'S' };
+	constexpr size_t g_keyAlignment = 32;
+	constexpr size_t g_rootMotionFloatCount = 3;
+	constexpr uint64_t g_hashOffsetBasis = 14695981039346656037ull;
+	constexpr uint64_t g_hashPrime = 1099511628211ull;
+
+	struct CacheHeader final
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t clipCount;
+		uint64_t sourceHash;
+		uint64_t boneCount;
+	};
+
+	struct CacheEntry final
+	{
+		char name[40];
+		uint64_t keyCount;
+
+		/**
+		 * @brief Position of the first key of the clip from the start of the file, a multiple of g_keyAlignment.
+		 */
+		uint64_t keyOffset;
+
+		/**
+		 * @brief Position of the root motion of the clip, key count + 1 displacements of 3 floats.
+		 */
+		uint64_t rootMotionOffset;
+
+		/**
+		 * @brief Position of the cycle of the clip: its stride length then the time of its markers.
+		 */
+		uint64_t cycleOffset;
+		uint64_t markerCount;
+	};
+
+	static_assert(sizeof(CacheHeader) == 32 && sizeof(CacheEntry) == 80, "The cache layout must not depend on the compiler");
+
+	uint64_t HashBytes(uint64_t p_hash, const char* p_bytes, const size_t p_size)
+	{
+		for (size_t i = 0; i < p_size; ++i)
+		{
+			p_hash ^= static_cast<unsigned char>(p_bytes[i]);
+			p_hash *= g_hashPrime;
+		}
+
+		return p_hash;
+	}
+
+	size_t AlignOffset(const size_t p_offset)
+	{
+		return (p_offset + g_keyAlignment - 1) / g_keyAlignment * g_keyAlignment;
+	}
+
+	size_t RootMotionSize(const size_t p_keyCount)
+	{
+		return (p_keyCount + 1) * g_rootMotionFloatCount * sizeof(float);
+	}
+
+	size_t CycleSize(const size_t p_markerCount)
+	{
+		return (p_markerCount + 1) * sizeof(float);
+	}
+}
+
+std::optional<uint64_t> ClipCache::HashSources(const std::vector<std::string>& p_paths)
+{
+	uint64_t hash = g_hashOffsetBasis;
+	std::vector<char> buffer(1 << 16);
+
+	for (const std::string& path : p_paths)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return {};
+
+		// The path is hashed too so that swapping two files invalidates the cache
+		hash = HashBytes(hash, path.data(), path.size() + 1);
+
+		while (file)
+		{
+			file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			hash = HashBytes(hash, buffer.data(), static_cast<size_t>(file.gcount()));
+		}
+	}
+
+	return hash;
+}
+
+void ClipCache::Save(const std::string& p_path, const uint64_t p_sourceHash, const ClipRegistry& p_clips, const std::vector<RootMotion>& p_rootMotions, const std::vector<ClipCycle>& p_cycles)
+{
+	const size_t clipCount = p_clips.Count();
+	if (p_rootMotions.size() < clipCount)
+		throw std::runtime_error("Clip cache can't be written, a clip has no root motion");
+	if (p_cycles.size() < clipCount)
+		throw std::runtime_error("Clip cache can't be written, a clip has no cycle");
+
+	const size_t boneCount = clipCount > 0 ? p_clips.Clip(0).BoneCount() : 0;
+
+	CacheHeader header{};
+	std::memcpy(header.magic, g_magic, sizeof(g_magic));
+	header.version = version;
+	header.clipCount = static_cast<uint32_t>(clipCount);
+	header.sourceHash = p_sourceHash;
+	header.boneCount = boneCount;
+
+	std::vector<CacheEntry> entries(clipCount);
+	size_t offset = AlignOffset(sizeof(CacheHeader) + clipCount * sizeof(CacheEntry));
+
+	for (ClipId clip = 0; clip < clipCount; ++clip)
+	{
+		const std::string& name = p_clips.Name(clip);
+		if (name.size() >= sizeof(CacheEntry::name))
+			throw std::runtime_error("Clip cache can't be written, the name " + name + " is too long");
+		if (p_clips.Clip(clip).BoneCount() != boneCount)
+			throw std::runtime_error("Clip cache can't be written, the clips don't share the same skeleton");
+
+		std::memcpy(entries[clip].name, name.c_str(), name.size() + 1);
+		entries[clip].keyCount = p_clips.Clip(clip).KeyCount();
+		entries[clip].keyOffset = offset;
+		entries[clip].rootMotionOffset = AlignOffset(offset + p_clips.Clip(clip).KeyMemorySize());
+		entries[clip].cycleOffset = AlignOffset(entries[clip].rootMotionOffset + RootMotionSize(p_clips.Clip(clip).KeyCount()));
+		entries[clip].markerCount = p_cycles[clip].MarkerCount();
+		offset = AlignOffset(entries[clip].cycleOffset + CycleSize(p_cycles[clip].MarkerCount()));
+	}
+
+	const std::string temporaryPath = p_path + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file)
+			throw std::runtime_error("Clip cache can't be written to " + temporaryPath);
+
+		const char padding[g_keyAlignment]{};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(CacheEntry)));
+
+		for (ClipId clip = 0; clip < clipCount; ++clip)
+		{
+			const AnimationInfo& animation = p_clips.Clip(clip);
+			file.write(padding, static_cast<std::streamsize>(entries[clip].keyOffset - static_cast<uint64_t>(file.tellp())));
+
+			if (animation.KeyCount() > 0)
+				file.write(reinterpret_cast<const char*>(animation.FrameStream(0, KeyStream::TranslationX)), static_cast<std::streamsize>(animation.KeyMemorySize()));
+
+			// A clip whose root doesn't move is stored as zero displacements
+			std::vector<float> rootMotion(RootMotionSize(animation.KeyCount()) / sizeof(float), 0.0f);
+			const std::vector<Vector3F>& displacements = p_rootMotions[clip].Displacements();
+			for (size_t i = 0; i < std::min(displacements.size(), animation.KeyCount() + 1); ++i)
+			{
+				rootMotion[i * g_rootMotionFloatCount] = displacements[i].x;
+				rootMotion[i * g_rootMotionFloatCount + 1] = displacements[i].y;
+				rootMotion[i * g_rootMotionFloatCount + 2] = displacements[i].z;
+			}
+
+			file.write(padding, static_cast<std::streamsize>(entries[clip].rootMotionOffset - static_cast<uint64_t>(file.tellp())));
+			file.write(reinterpret_cast<const char*>(rootMotion.data()), static_cast<std::streamsize>(rootMotion.size() * sizeof(float)));
+
+			std::vector<float> cycle{ p_cycles[clip].StrideLength() };
+			for (size_t marker = 0; marker < p_cycles[clip].MarkerCount(); ++marker)
+				cycle.push_back(p_cycles[clip].MarkerTime(marker));
+
+			file.write(padding, static_cast<std::streamsize>(entries[clip].cycleOffset - static_cast<uint64_t>(file.tellp())));
+			file.write(reinterpret_cast<const char*>(cycle.data()), static_cast<std::streamsize>(cycle.size() * sizeof(float)));
+		}
+
+		if (!file)
+			throw std::runtime_error("Clip cache can't be written to " + temporaryPath);
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, p_path, error);
+	if (error)
+		throw std::runtime_error("Clip cache can't be written to " + p_path + ": " + error.message());
+}
+
+bool ClipCache::Load(const std::string& p_path, const uint64_t p_sourceHash, ClipRegistry& p_clips, std::vector<RootMotion>& p_rootMotions, std::vector<ClipCycle>& p_cycles)
+{
+	std::error_code error;
+	if (!std::filesystem::exists(p_path, error))
+		return false;
+
+	Memory::MappedFile file;
+	try
+	{
+		file = Memory::MappedFile(p_path);
+	}
+	catch (const std::runtime_error&)
+	{
+		return false;
+	}
+
+	const std::byte* data = file.Data();
+	const size_t clipCount = p_clips.Count();
+
+	if (file.Size() < sizeof(CacheHeader))
+		return false;
+
+	CacheHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.magic, g_magic, sizeof(g_magic)) != 0 || header.version != version || header.sourceHash != p_sourceHash || header.clipCount != clipCount)
+		return false;
+	if (file.Size() < sizeof(CacheHeader) + clipCount * sizeof(CacheEntry))
+		return false;
+
+	const CacheEntry* entries = reinterpret_cast<const CacheEntry*>(data + sizeof(CacheHeader));
+
+	// Every clip is checked before any of them is mapped
+	for (ClipId clip = 0; clip < clipCount; ++clip)
+	{
+		const AnimationInfo& animation = p_clips.Clip(clip);
+		const CacheEntry& entry = entries[clip];
+
+		if (std::strncmp(entry.name, p_clips.Name(clip).c_str(), sizeof(entry.name)) != 0
+			|| entry.keyCount != animation.KeyCount()
+			|| entry.keyCount == 0
+			|| header.boneCount != animation.BoneCount()
+			|| entry.keyOffset % g_keyAlignment != 0
+			|| entry.keyOffset + animation.KeyMemorySize() > file.Size()
+			|| entry.rootMotionOffset % g_keyAlignment != 0
+			|| entry.rootMotionOffset + RootMotionSize(animation.KeyCount()) > file.Size()
+			|| entry.cycleOffset % g_keyAlignment != 0
+			|| entry.markerCount == 0
+			|| entry.markerCount > file.Size() / sizeof(float)
+			|| entry.cycleOffset + CycleSize(entry.markerCount) > file.Size())
+			return false;
+	}
+
+	std::vector<RootMotion> rootMotions(clipCount);
+	std::vector<ClipCycle> cycles;
+	cycles.reserve(clipCount);
+	for (ClipId clip = 0; clip < clipCount; ++clip)
+	{
+		AnimationInfo& animation = p_clips.Clip(clip);
+		animation.MapKeys(reinterpret_cast<const float*>(data + entries[clip].keyOffset), animation.KeyCount(), animation.BoneCount());
+
+		const float* cycle = reinterpret_cast<const float*>(data + entries[clip].cycleOffset);
+		cycles.emplace_back(animation.KeyCount(), cycle[0], std::vector<float>(cycle + 1, cycle + 1 + entries[clip].markerCount));
+
+		if (animation.KeyCount() < 2)
+			continue;
+
+		const float* rootMotion = reinterpret_cast<const float*>(data + entries[clip].rootMotionOffset);
+		std::vector<Vector3F> displacements(animation.KeyCount() + 1);
+		for (size_t i = 0; i < displacements.size(); ++i)
+			displacements[i] = Vector3F{ rootMotion[i * g_rootMotionFloatCount], rootMotion[i * g_rootMotionFloatCount + 1], rootMotion[i * g_rootMotionFloatCount + 2] };
+
+		rootMotions[clip] = RootMotion(std::move(displacements));
+	}
+
+	p_rootMotions = std::move(rootMotions);
+	p_cycles = std::move(cycles);
+
+	m_file = std::move(file);
+	return true;
+}
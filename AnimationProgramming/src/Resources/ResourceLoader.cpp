@@ -0,0 +1,187 @@
+#include <Resources/ResourceLoader.h>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	/**
+	 * @brief Floats of a bind transform or a key: position, rotation (w, x, y, z), scale.
+	 */
+	constexpr size_t g_transformFloatCount = 10;
+
+	/**
+	 * @brief Sequential reader of a binary resource, every read past the end of the file throws.
+	 */
+	class ResourceStream final
+	{
+	public:
+		explicit ResourceStream(const std::string& p_path)
+			: m_file{ p_path, std::ios::binary }, m_path{ p_path }
+		{
+			if (!m_file)
+				throw std::runtime_error("Resource " + p_path + " can't be opened");
+
+			m_file.seekg(0, std::ios::end);
+			m_size = static_cast<size_t>(m_file.tellg());
+			m_file.seekg(0, std::ios::beg);
+		}
+
+		void Read(void* p_destination, const size_t p_size)
+		{
+			m_file.read(static_cast<char*>(p_destination), static_cast<std::streamsize>(p_size));
+			if (static_cast<size_t>(m_file.gcount()) != p_size)
+				throw std::runtime_error("Resource " + m_path + " is truncated");
+		}
+
+		template <typename T>
+		T Read()
+		{
+			T value;
+			Read(&value, sizeof(T));
+			return value;
+		}
+
+		void Skip(const size_t p_size)
+		{
+			const std::streamoff position = m_file.tellg();
+			if (position < 0 || static_cast<size_t>(position) + p_size > m_size)
+				throw std::runtime_error("Resource " + m_path + " is truncated");
+
+			m_file.seekg(static_cast<std::streamoff>(p_size), std::ios::cur);
+		}
+
+	private:
+		std::ifstream m_file;
+		std::string m_path;
+		size_t m_size{ 0 };
+	};
+
+	/**
+	 * @brief Read the track count of a .anim, after its duration.
+	 * @param p_stream The stream, at the start of the file
+	 * @return The track count
+	 */
+	size_t ReadTrackCount(ResourceStream& p_stream)
+	{
+		p_stream.Read<float>();
+		return p_stream.Read<uint32_t>();
+	}
+}
+
+Skeleton ResourceLoader::LoadSkeleton(const std::string& p_path, std::vector<int>& p_fileBoneIndices)
+{
+	ResourceStream stream(p_path);
+	const size_t fileBoneCount = stream.Read<uint32_t>();
+
+	std::vector<std::string> names(fileBoneCount);
+	std::vector<int> parentIndices(fileBoneCount);
+
+	for (size_t i = 0; i < fileBoneCount; ++i)
+	{
+		names[i].resize(stream.Read<uint32_t>());
+		stream.Read(names[i].data(), names[i].size());
+
+		const int32_t index = stream.Read<int32_t>();
+		parentIndices[i] = stream.Read<int32_t>();
+
+		if (index != static_cast<int32_t>(i) || parentIndices[i] < -1 || parentIndices[i] >= static_cast<int32_t>(fileBoneCount))
+			throw std::runtime_error("Resource " + p_path + " has an invalid index for the bone " + names[i]);
+	}
+
+	std::vector<float> bindTransforms(fileBoneCount * g_transformFloatCount);
+	stream.Read(bindTransforms.data(), bindTransforms.size() * sizeof(float));
+
+	std::vector<int> skeletonBoneIndices(fileBoneCount, -1);
+	Skeleton skeleton;
+	p_fileBoneIndices.clear();
+
+	for (size_t i = 0; i < fileBoneCount; ++i)
+	{
+		if (names[i].find("ik") != std::string::npos)
+			continue;
+
+		const int fileParentIndex = parentIndices[i];
+		const int parentIndex = fileParentIndex == -1 ? -1 : skeletonBoneIndices[fileParentIndex];
+
+		if (fileParentIndex != -1 && parentIndex == -1)
+			throw std::invalid_argument("Bone " + names[i] + " has a parent that is not part of the skeleton");
+
+		const float* bind = &bindTransforms[i * g_transformFloatCount];
+
+		skeletonBoneIndices[i] = static_cast<int>(skeleton.AddBone(
+			names[i],
+			parentIndex,
+			Vector3F{ bind[0], bind[1], bind[2] },
+			QuaternionF{ bind[4], bind[5], bind[6], bind[3] }));
+		p_fileBoneIndices.push_back(static_cast<int>(i));
+	}
+
+	return skeleton;
+}
+
+size_t ResourceLoader::ReadAnimationKeyCount(const std::string& p_path)
+{
+	ResourceStream stream(p_path);
+	const size_t trackCount = ReadTrackCount(stream);
+	size_t keyCount = 0;
+
+	for (size_t track = 0; track < trackCount; ++track)
+	{
+		const size_t trackKeyCount = stream.Read<uint32_t>();
+		if (trackKeyCount == 0)
+			continue;
+
+		keyCount = std::max(keyCount, trackKeyCount);
+		stream.Skip(sizeof(uint32_t) + trackKeyCount * g_transformFloatCount * sizeof(float));
+	}
+
+	return keyCount;
+}
+
+void ResourceLoader::LoadAnimation(const std::string& p_path, const std::vector<int>& p_fileBoneIndices, AnimationInfo& p_animation)
+{
+	ResourceStream stream(p_path);
+	const size_t trackCount = ReadTrackCount(stream);
+	const size_t keyCount = p_animation.KeyCount();
+
+	// Bone of the animation fed by each track, -1 for the bones skipped by the skeleton
+	std::vector<int> trackBones(trackCount, -1);
+	for (size_t bone = 0; bone < p_fileBoneIndices.size() && bone < p_animation.BoneCount(); ++bone)
+	{
+		if (static_cast<size_t>(p_fileBoneIndices[bone]) < trackCount)
+			trackBones[p_fileBoneIndices[bone]] = static_cast<int>(bone);
+	}
+
+	std::vector<float> keys;
+
+	for (size_t track = 0; track < trackCount; ++track)
+	{
+		const size_t trackKeyCount = stream.Read<uint32_t>();
+		if (trackKeyCount == 0)
+			continue;
+		if (trackKeyCount > keyCount)
+			throw std::runtime_error("Resource " + p_path + " has more keys than the animation");
+
+		stream.Read<uint32_t>();
+
+		// Each track is read at once, then scattered to the streams of the animation
+		keys.resize(trackKeyCount * g_transformFloatCount);
+		stream.Read(keys.data(), keys.size() * sizeof(float));
+
+		if (trackBones[track] == -1)
+			continue;
+
+		for (size_t frame = 0; frame < keyCount; ++frame)
+		{
+			const float* key = &keys[std::min(frame, trackKeyCount - 1) * g_transformFloatCount];
+
+			p_animation.UpdateAnimFrame(
+				trackBones[track],
+				frame,
+				Vector3F{ key[0], key[1], key[2] },
+				QuaternionF{ key[4], key[5], key[6], key[3] });
+		}
+	}
+}
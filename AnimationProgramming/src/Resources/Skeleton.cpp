@@ -0,0 +1,131 @@
+#include <Resources/Skeleton.h>
+#include <stdexcept>
+
+namespace
+{
+	/**
+	 * @brief Invert a matrix made of a rotation and a translation only: the rotation is transposed and the translation is rotated back and negated.
+	 * @param p_matrix The rigid matrix
+	 * @return The inverted matrix
+	 */
+	Matrix4F InverseRigid(const Matrix4F& p_matrix)
+	{
+		const float* m = p_matrix.m_data;
+
+		return Matrix4F{
+			m[0], m[4], m[8], -(m[0] * m[3] + m[4] * m[7] + m[8] * m[11]),
+			m[1], m[5], m[9], -(m[1] * m[3] + m[5] * m[7] + m[9] * m[11]),
+			m[2], m[6], m[10], -(m[2] * m[3] + m[6] * m[7] + m[10] * m[11]),
+			0.0f, 0.0f, 0.0f, 1.0f };
+	}
+}
+
+size_t Skeleton::AddBone(const std::string_view& p_name,
+	const int p_parentIndex,
+	const Vector3F& p_bindPosition,
+	const QuaternionF& p_bindRotation)
+{
+	const size_t boneIndex = m_parentIndices.size();
+
+	if (p_parentIndex >= static_cast<int>(boneIndex) || p_parentIndex < -1)
+		throw std::invalid_argument("Bone " + std::string(p_name) + " is added before its parent, skeleton bones must be ordered from parents to children");
+
+	const Matrix4F localBindMatrix = Matrix4F::CreateTransformation(p_bindPosition, p_bindRotation, Vector3F::one);
+	const Matrix4F worldBindMatrix = p_parentIndex == -1
+		? localBindMatrix
+		: m_worldBindMatrices[p_parentIndex] * localBindMatrix;
+
+	m_parentIndices.push_back(p_parentIndex);
+	m_names.emplace_back(p_name);
+	m_localBindMatrices.push_back(localBindMatrix);
+	m_worldBindMatrices.push_back(worldBindMatrix);
+	m_inverseBindMatrices.push_back(InverseRigid(worldBindMatrix));
+
+	const DualQuaternion localBindDualQuaternion = DualQuaternion::FromRotationTranslation(p_bindRotation, p_bindPosition);
+	const DualQuaternion worldBindDualQuaternion = p_parentIndex == -1
+		? localBindDualQuaternion
+		: DualQuaternion::Multiply(m_worldBindDualQuaternions[p_parentIndex], localBindDualQuaternion);
+
+	m_localBindDualQuaternions.push_back(localBindDualQuaternion);
+	m_worldBindDualQuaternions.push_back(worldBindDualQuaternion);
+	m_inverseBindDualQuaternions.push_back(DualQuaternion::InverseRigid(worldBindDualQuaternion));
+
+	return boneIndex;
+}
+
+void Skeleton::ComputeWorldPose(const LocalPose* p_localPose, Matrix4F* p_worldPose, const size_t p_firstBone) const
+{
+	const size_t boneCount = m_parentIndices.size();
+
+	for (size_t i = p_firstBone; i < boneCount; ++i)
+	{
+		const Matrix4F localAnimMatrix = Matrix4F::CreateTransformation(p_localPose[i].position, p_localPose[i].rotation, Vector3F::one);
+		const int parentIndex = m_parentIndices[i];
+
+		p_worldPose[i] = parentIndex == -1
+			? m_localBindMatrices[i] * localAnimMatrix
+			: p_worldPose[parentIndex] * m_localBindMatrices[i] * localAnimMatrix;
+	}
+}
+
+void Skeleton::ComputeWorldPose(const LocalPose* p_localPose, DualQuaternion* p_worldPose, const size_t p_firstBone) const
+{
+	const size_t boneCount = m_parentIndices.size();
+
+	for (size_t i = p_firstBone; i < boneCount; ++i)
+	{
+		const DualQuaternion localAnim = DualQuaternion::FromRotationTranslation(p_localPose[i].rotation, p_localPose[i].position);
+		const DualQuaternion local = DualQuaternion::Multiply(m_localBindDualQuaternions[i], localAnim);
+		const int parentIndex = m_parentIndices[i];
+
+		p_worldPose[i] = parentIndex == -1
+			? local
+			: DualQuaternion::Multiply(p_worldPose[parentIndex], local);
+	}
+}
+
+size_t Skeleton::BoneCount() const
+{
+	return m_parentIndices.size();
+}
+
+int Skeleton::ParentIndex(const size_t p_boneIndex) const
+{
+	return m_parentIndices[p_boneIndex];
+}
+
+const std::string& Skeleton::BoneName(const size_t p_boneIndex) const
+{
+	return m_names[p_boneIndex];
+}
+
+std::optional<size_t> Skeleton::BoneIndex(const std::string_view& p_boneName) const
+{
+	for (size_t i = 0; i < m_names.size(); ++i)
+	{
+		if (m_names[i] == p_boneName)
+			return i;
+	}
+
+	return {};
+}
+
+const Matrix4F& Skeleton::LocalBindMatrix(const size_t p_boneIndex) const
+{
+	return m_localBindMatrices[p_boneIndex];
+}
+
+const Matrix4F& Skeleton::InverseBindMatrix(const size_t p_boneIndex) const
+{
+	return m_inverseBindMatrices[p_boneIndex];
+}
+
+const DualQuaternion& Skeleton::LocalBindDualQuaternion(const size_t p_boneIndex) const
+{
+	return m_localBindDualQuaternions[p_boneIndex];
+}
+
+const DualQuaternion& Skeleton::InverseBindDualQuaternion(const size_t p_boneIndex) const
+{
+	return m_inverseBindDualQuaternions[p_boneIndex];
+}
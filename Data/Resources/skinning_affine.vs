@@ -0,0 +1,53 @@
+
+/////////////////////
+// INPUT VARIABLES //
+/////////////////////
+in lowp vec3 inputPosition;
+in lowp vec3 normal;
+in lowp vec4 boneIndices;
+in lowp vec4 boneWeights;
+
+//////////////////////
+// OUTPUT VARIABLES //
+//////////////////////
+smooth out vec2 texCoord;
+smooth out vec3 outNormal;
+
+uniform SceneMatrices
+{
+	uniform mat4 projectionMatrix;
+} sm;
+
+uniform mat4 modelViewMatrix;
+
+// 3 rows per bone, the last row of every skinning matrix being 0, 0, 0, 1
+uniform SkinningMatrices
+{
+	uniform vec4 rows[256];
+} skin;
+
+vec3 SkinPosition(vec4 position, int bone)
+{
+	int row = bone * 3;
+	return vec3(dot(position, skin.rows[row]), dot(position, skin.rows[row + 1]), dot(position, skin.rows[row + 2]));
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Vertex Shader
+////////////////////////////////////////////////////////////////////////////////
+void main(void)
+{
+	// Calculate the position of the vertex against the world, view, and projection matrices.
+	vec4 position = vec4(inputPosition, 1.0f);
+	vec3 pos = boneWeights[0] * SkinPosition(position, int(boneIndices.x))
+				+ boneWeights[1] * SkinPosition(position, int(boneIndices.y))
+				+ boneWeights[2] * SkinPosition(position, int(boneIndices.z))
+				+ boneWeights[3] * SkinPosition(position, int(boneIndices.w));
+
+	gl_Position = sm.projectionMatrix * (modelViewMatrix * vec4(pos, 1.0f));
+	outNormal = mat3(modelViewMatrix) * normal;
+
+	outNormal = normalize(outNormal);
+}
@@ -0,0 +1,70 @@
+
+/////////////////////
+// INPUT VARIABLES //
+/////////////////////
+in lowp vec3 inputPosition;
+in lowp vec3 normal;
+in lowp vec4 boneIndices;
+in lowp vec4 boneWeights;
+
+//////////////////////
+// OUTPUT VARIABLES //
+//////////////////////
+smooth out vec2 texCoord;
+smooth out vec3 outNormal;
+
+uniform SceneMatrices
+{
+	uniform mat4 projectionMatrix;
+} sm;
+
+uniform mat4 modelViewMatrix;
+
+// 2 vec4 per bone: the rotation then the dual part, both x, y, z, w
+uniform SkinningMatrices
+{
+	uniform vec4 dq[256];
+} skin;
+
+vec3 SkinPosition(vec3 position)
+{
+	int bone0 = int(boneIndices.x) * 2;
+	int bone1 = int(boneIndices.y) * 2;
+	int bone2 = int(boneIndices.z) * 2;
+	int bone3 = int(boneIndices.w) * 2;
+
+	// Keep every rotation on the hemisphere of the first one so the blend takes the shortest path
+	vec4 pivot = skin.dq[bone0];
+	float weight0 = boneWeights[0];
+	float weight1 = dot(pivot, skin.dq[bone1]) < 0.0f ? -boneWeights[1] : boneWeights[1];
+	float weight2 = dot(pivot, skin.dq[bone2]) < 0.0f ? -boneWeights[2] : boneWeights[2];
+	float weight3 = dot(pivot, skin.dq[bone3]) < 0.0f ? -boneWeights[3] : boneWeights[3];
+
+	vec4 real = weight0 * skin.dq[bone0] + weight1 * skin.dq[bone1] + weight2 * skin.dq[bone2] + weight3 * skin.dq[bone3];
+	vec4 dual = weight0 * skin.dq[bone0 + 1] + weight1 * skin.dq[bone1 + 1] + weight2 * skin.dq[bone2 + 1] + weight3 * skin.dq[bone3 + 1];
+
+	float inverseLength = 1.0f / length(real);
+	real *= inverseLength;
+	dual *= inverseLength;
+
+	vec3 rotated = position + 2.0f * cross(real.xyz, cross(real.xyz, position) + real.w * position);
+	vec3 translation = 2.0f * (real.w * dual.xyz - dual.w * real.xyz + cross(real.xyz, dual.xyz));
+
+	return rotated + translation;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Vertex Shader
+////////////////////////////////////////////////////////////////////////////////
+void main(void)
+{
+	// Calculate the position of the vertex against the world, view, and projection matrices.
+	vec3 pos = SkinPosition(inputPosition);
+
+	gl_Position = sm.projectionMatrix * (modelViewMatrix * vec4(pos, 1.0f));
+	outNormal = mat3(modelViewMatrix) * normal;
+
+	outNormal = normalize(outNormal);
+}
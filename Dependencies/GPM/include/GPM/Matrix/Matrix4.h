@@ -5,6 +5,7 @@
 
 namespace GPM
 {
+    template<typename T>
     struct Quaternion;
     /**
      * A standard 4 by 4 Matrix. Default value is an identity matrix
@@ -68,18 +69,20 @@ namespace GPM
         template<typename U>
         constexpr static Matrix4<T> CreateScale(const Vector3<U>& p_scale);
 
-        constexpr Matrix4<T>& Rotate(const Quaternion& p_rotation);
-        constexpr static Matrix4<T> CreateRotation(const Quaternion& p_rotation);
+        template<typename Q>
+        constexpr Matrix4<T>& Rotate(const Quaternion<Q>& p_rotation);
+        template<typename Q>
+        constexpr static Matrix4<T> CreateRotation(const Quaternion<Q>& p_rotation);
         
         template<typename U>
         constexpr Matrix4<T>& Translate(const Vector3<U>& p_translate);
         template<typename U>
         constexpr static Matrix4<T> CreateTranslation(const Vector3<U>& p_translate);
         
-        template<typename U>
-        constexpr Matrix4<T>& Transform(const Vector3<U>& p_translate, const Quaternion& p_rotation, const Vector3<U>& p_scale);
-        template<typename U>
-        constexpr static Matrix4<T> CreateTransformation(const Vector3<U>& p_translate, const Quaternion& p_rotation, const Vector3<U>& p_scale);
+        template<typename U, typename Q>
+        constexpr Matrix4<T>& Transform(const Vector3<U>& p_translate, const Quaternion<Q>& p_rotation, const Vector3<U>& p_scale);
+        template<typename U, typename Q>
+        constexpr static Matrix4<T> CreateTransformation(const Vector3<U>& p_translate, const Quaternion<Q>& p_rotation, const Vector3<U>& p_scale);
 
         constexpr Matrix4<T> Adjugate();
         constexpr static Matrix4<T> CreateAdjugate(const Matrix4<T>& p_matrix);
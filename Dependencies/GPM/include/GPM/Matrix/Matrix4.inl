@@ -1,6 +1,9 @@
 #pragma once
 #include <GPM/Quaternion/Quaternion.h>
+#include <GPM/Matrix/Matrix4SIMD.h>
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
 
 // struct GPM::Quaternion;
 
@@ -93,6 +96,12 @@ constexpr T Matrix4<T>::Determinant(const Matrix4<T>& p_matrix)
 template<typename T>
 constexpr Matrix4<T>& Matrix4<T>::Transpose()
 {
+	if constexpr (std::is_same_v<T, float>)
+	{
+		SIMD::TransposeMatrix4(m_data, m_data);
+		return { *this };
+	}
+
 	Matrix4<T> tmpMat(this->m_data);
 
 	for (int n = 0; n < 16; n++)
@@ -112,6 +121,12 @@ constexpr Matrix4<T> Matrix4<T>::Transpose(const Matrix4<T>& p_matrix)
 {
 	Matrix4<T> tmpMat = identity;
 
+	if constexpr (std::is_same_v<T, float>)
+	{
+		SIMD::TransposeMatrix4(p_matrix.m_data, tmpMat.m_data);
+		return tmpMat;
+	}
+
 	for (int n = 0; n < 16; n++)
 	{
 		int i = n / 4;
@@ -165,7 +180,8 @@ constexpr Matrix4<T> Matrix4<T>::CreateScale(const Vector3<U>& p_scale)
 }
 
 template<typename T>
-constexpr Matrix4<T>& Matrix4<T>::Rotate(const Quaternion& p_rotation)
+template<typename Q>
+constexpr Matrix4<T>& Matrix4<T>::Rotate(const Quaternion<Q>& p_rotation)
 {
 	(*this) *= p_rotation.ToMatrix4();
 
@@ -173,7 +189,8 @@ constexpr Matrix4<T>& Matrix4<T>::Rotate(const Quaternion& p_rotation)
 }
 
 template<typename T>
-constexpr Matrix4<T> Matrix4<T>::CreateRotation(const Quaternion& p_rotation)
+template<typename Q>
+constexpr Matrix4<T> Matrix4<T>::CreateRotation(const Quaternion<Q>& p_rotation)
 {
 	return p_rotation.ToMatrix4();
 }
@@ -201,8 +218,8 @@ constexpr Matrix4<T> Matrix4<T>::CreateTranslation(const Vector3<U>& p_translate
 }
 
 template<typename T>
-template<typename U>
-constexpr Matrix4<T>& Matrix4<T>::Transform(const Vector3<U>& p_translate, const Quaternion& p_rotation, const Vector3<U>& p_scale)
+template<typename U, typename Q>
+constexpr Matrix4<T>& Matrix4<T>::Transform(const Vector3<U>& p_translate, const Quaternion<Q>& p_rotation, const Vector3<U>& p_scale)
 {
 	(*this) *= CreateTransformation(p_translate, p_rotation, p_scale);
 
@@ -210,8 +227,8 @@ constexpr Matrix4<T>& Matrix4<T>::Transform(const Vector3<U>& p_translate, const
 }
 
 template<typename T>
-template<typename U>
-constexpr Matrix4<T> Matrix4<T>::CreateTransformation(const Vector3<U>& p_translate, const Quaternion& p_rotation, const Vector3<U>& p_scale)
+template<typename U, typename Q>
+constexpr Matrix4<T> Matrix4<T>::CreateTransformation(const Vector3<U>& p_translate, const Quaternion<Q>& p_rotation, const Vector3<U>& p_scale)
 {
 	Matrix4<T> tmpTrans = CreateTranslation(p_translate);
 	Matrix4<T> tmpRot = CreateRotation(p_rotation);
@@ -440,6 +457,12 @@ template<typename T>
 template<typename U>
 Matrix4<T>& Matrix4<T>::Multiply(const Matrix4<U>& p_other)
 {
+	if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>)
+	{
+		SIMD::MultiplyMatrix4(m_data, p_other.m_data, m_data);
+		return { *this };
+	}
+
 	Matrix4<T> tmpMat(this->m_data);
 
 	for (int i = 0; i < 16; i += 4)
@@ -469,6 +492,12 @@ Vector4<U> Matrix4<T>::Multiply(const Vector4<U>& p_other)
 {
 	Vector4<T> tmpVec = Vector4F::zero;
 
+	if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>)
+	{
+		SIMD::TransformVector4(m_data, &p_other.x, &tmpVec.x);
+		return tmpVec;
+	}
+
 	tmpVec.x = (m_data[0] * p_other.x)
 		+ (m_data[1] * p_other.y)
 		+ (m_data[2] * p_other.z)
@@ -497,7 +526,17 @@ template<typename T>
 template<typename U>
 constexpr Matrix4<T> Matrix4<T>::operator*(const Matrix4<U>& p_other) const
 {
-	return Matrix4<T>(*this).Multiply(p_other);
+	if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>)
+	{
+		// Written straight into the result, a copy of *this would be reloaded right after being stored
+		Matrix4<T> result;
+		SIMD::MultiplyMatrix4(m_data, p_other.m_data, result.m_data);
+		return result;
+	}
+	else
+	{
+		return Matrix4<T>(*this).Multiply(p_other);
+	}
 }
 
 template<typename T>
@@ -518,6 +557,12 @@ Vector4<T> Matrix4<T>::Multiply(const Matrix4<U>& p_matrix, const Vector4<T>& p_
 {
 	Vector4<T> tmpVec = Vector4F::zero;
 
+	if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>)
+	{
+		SIMD::TransformVector4(p_matrix.m_data, &p_vector.x, &tmpVec.x);
+		return tmpVec;
+	}
+
 	tmpVec.x = (p_matrix[0] * p_vector.x)
 		+ (p_matrix[1] * p_vector.y)
 		+ (p_matrix[2] * p_vector.z)
@@ -0,0 +1,152 @@
+#pragma once
+
+/*
+ * SIMD kernels used by Matrix4<float>. The instruction set is selected at compile time:
+ * AVX when the compiler targets it (/arch:AVX, -mavx), SSE on any x86 target with SSE enabled, scalar code otherwise.
+ * Define GPM_NO_SIMD to force the scalar path.
+ */
+#if !defined(GPM_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define GPM_SIMD_SSE 1
+#include <xmmintrin.h>
+#if defined(__AVX__)
+#define GPM_SIMD_AVX 1
+#include <immintrin.h>
+#endif
+#endif
+
+namespace GPM::SIMD
+{
+	/**
+	 * @brief Multiply two row-major 4x4 float matrices
+	 * @param p_left The left matrix
+	 * @param p_right The right matrix
+	 * @param p_result The 16 floats receiving the product, it may alias p_left or p_right
+	 */
+	inline void MultiplyMatrix4(const float* p_left, const float* p_right, float* p_result)
+	{
+#if defined(GPM_SIMD_AVX)
+		// Two rows of the result per register: each lane broadcasts its own coefficient of the left matrix
+		const __m256 right0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right));
+		const __m256 right1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 4));
+		const __m256 right2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 8));
+		const __m256 right3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 12));
+
+		// Rows are loaded 16 bytes at a time: matrices are usually copied row by row just before, a 32 bytes load would miss store forwarding
+		const __m256 left01 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p_left)), _mm_loadu_ps(p_left + 4), 1);
+		const __m256 left23 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p_left + 8)), _mm_loadu_ps(p_left + 12), 1);
+
+		__m256 result01 = _mm256_mul_ps(_mm256_shuffle_ps(left01, left01, _MM_SHUFFLE(0, 0, 0, 0)), right0);
+		result01 = _mm256_add_ps(result01, _mm256_mul_ps(_mm256_shuffle_ps(left01, left01, _MM_SHUFFLE(1, 1, 1, 1)), right1));
+		result01 = _mm256_add_ps(result01, _mm256_mul_ps(_mm256_shuffle_ps(left01, left01, _MM_SHUFFLE(2, 2, 2, 2)), right2));
+		result01 = _mm256_add_ps(result01, _mm256_mul_ps(_mm256_shuffle_ps(left01, left01, _MM_SHUFFLE(3, 3, 3, 3)), right3));
+
+		__m256 result23 = _mm256_mul_ps(_mm256_shuffle_ps(left23, left23, _MM_SHUFFLE(0, 0, 0, 0)), right0);
+		result23 = _mm256_add_ps(result23, _mm256_mul_ps(_mm256_shuffle_ps(left23, left23, _MM_SHUFFLE(1, 1, 1, 1)), right1));
+		result23 = _mm256_add_ps(result23, _mm256_mul_ps(_mm256_shuffle_ps(left23, left23, _MM_SHUFFLE(2, 2, 2, 2)), right2));
+		result23 = _mm256_add_ps(result23, _mm256_mul_ps(_mm256_shuffle_ps(left23, left23, _MM_SHUFFLE(3, 3, 3, 3)), right3));
+
+		_mm256_storeu_ps(p_result, result01);
+		_mm256_storeu_ps(p_result + 8, result23);
+#elif defined(GPM_SIMD_SSE)
+		const __m128 right0 = _mm_loadu_ps(p_right);
+		const __m128 right1 = _mm_loadu_ps(p_right + 4);
+		const __m128 right2 = _mm_loadu_ps(p_right + 8);
+		const __m128 right3 = _mm_loadu_ps(p_right + 12);
+
+		const __m128 left0 = _mm_loadu_ps(p_left);
+		const __m128 left1 = _mm_loadu_ps(p_left + 4);
+		const __m128 left2 = _mm_loadu_ps(p_left + 8);
+		const __m128 left3 = _mm_loadu_ps(p_left + 12);
+
+		const auto multiplyRow = [&](const __m128 p_row)
+		{
+			__m128 result = _mm_mul_ps(_mm_shuffle_ps(p_row, p_row, _MM_SHUFFLE(0, 0, 0, 0)), right0);
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(p_row, p_row, _MM_SHUFFLE(1, 1, 1, 1)), right1));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(p_row, p_row, _MM_SHUFFLE(2, 2, 2, 2)), right2));
+			return _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(p_row, p_row, _MM_SHUFFLE(3, 3, 3, 3)), right3));
+		};
+
+		_mm_storeu_ps(p_result, multiplyRow(left0));
+		_mm_storeu_ps(p_result + 4, multiplyRow(left1));
+		_mm_storeu_ps(p_result + 8, multiplyRow(left2));
+		_mm_storeu_ps(p_result + 12, multiplyRow(left3));
+#else
+		float result[16];
+
+		for (int i = 0; i < 16; i += 4)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				result[i + j] = (p_left[i] * p_right[j])
+					+ (p_left[i + 1] * p_right[j + 4])
+					+ (p_left[i + 2] * p_right[j + 8])
+					+ (p_left[i + 3] * p_right[j + 12]);
+			}
+		}
+
+		for (int i = 0; i < 16; ++i)
+			p_result[i] = result[i];
+#endif
+	}
+
+	/**
+	 * @brief Multiply a row-major 4x4 float matrix by a column vector
+	 * @param p_matrix The matrix
+	 * @param p_vector The 4 floats of the vector
+	 * @param p_result The 4 floats receiving the transformed vector
+	 */
+	inline void TransformVector4(const float* p_matrix, const float* p_vector, float* p_result)
+	{
+#if defined(GPM_SIMD_SSE)
+		const __m128 vector = _mm_loadu_ps(p_vector);
+
+		__m128 row0 = _mm_mul_ps(_mm_loadu_ps(p_matrix), vector);
+		__m128 row1 = _mm_mul_ps(_mm_loadu_ps(p_matrix + 4), vector);
+		__m128 row2 = _mm_mul_ps(_mm_loadu_ps(p_matrix + 8), vector);
+		__m128 row3 = _mm_mul_ps(_mm_loadu_ps(p_matrix + 12), vector);
+
+		// Transposing the products turns the 4 horizontal sums into 3 vertical adds
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		_mm_storeu_ps(p_result, _mm_add_ps(_mm_add_ps(row0, row1), _mm_add_ps(row2, row3)));
+#else
+		for (int i = 0; i < 4; ++i)
+		{
+			p_result[i] = p_matrix[i * 4] * p_vector[0]
+				+ p_matrix[i * 4 + 1] * p_vector[1]
+				+ p_matrix[i * 4 + 2] * p_vector[2]
+				+ p_matrix[i * 4 + 3] * p_vector[3];
+		}
+#endif
+	}
+
+	/**
+	 * @brief Transpose a 4x4 float matrix
+	 * @param p_matrix The matrix
+	 * @param p_result The 16 floats receiving the transposed matrix, it may alias p_matrix
+	 */
+	inline void TransposeMatrix4(const float* p_matrix, float* p_result)
+	{
+#if defined(GPM_SIMD_SSE)
+		__m128 row0 = _mm_loadu_ps(p_matrix);
+		__m128 row1 = _mm_loadu_ps(p_matrix + 4);
+		__m128 row2 = _mm_loadu_ps(p_matrix + 8);
+		__m128 row3 = _mm_loadu_ps(p_matrix + 12);
+
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		_mm_storeu_ps(p_result, row0);
+		_mm_storeu_ps(p_result + 4, row1);
+		_mm_storeu_ps(p_result + 8, row2);
+		_mm_storeu_ps(p_result + 12, row3);
+#else
+		float result[16];
+
+		for (int n = 0; n < 16; n++)
+			result[n] = p_matrix[4 * (n % 4) + n / 4];
+
+		for (int n = 0; n < 16; n++)
+			p_result[n] = result[n];
+#endif
+	}
+}
@@ -1,13 +1,20 @@
 #pragma once
 #include <string>
+#include <type_traits>
 
 namespace GPM
 {
+	/**
+	 * @brief Quaternion templated on its scalar type. QuaternionF keeps keys and interpolation in single precision, QuaternionD is the former double precision quaternion.
+	 */
+	template<typename T>
 	struct Quaternion final
 	{
-		Vector3<double> axis;
+		static_assert(std::is_floating_point<T>::value, "Quaternion should only be used with floating point types");
+
+		Vector3<T> axis;
 		//m_w is the real value of quaternion, this will be used to check if the quaternion is pure/identity or not.
-		double w;
+		T w;
 
 		// static const Quaternion identity;
 
@@ -22,14 +29,14 @@ namespace GPM
 		 *
 		 * @note In pure/applied Maths, we write W (or real), (Xi + Yj + Zk) (or Vector)
 		 */
-		inline Quaternion(const double p_x, const double p_y, const double p_z, const double p_w);
+		inline Quaternion(const T p_x, const T p_y, const T p_z, const T p_w);
 
 		/**
 		 * @brief Constructor using a scalar and a vector
 		 * @param p_scalar The scalar
 		 * @param p_vector The vector
 		 */
-		inline Quaternion(const double p_scalar, const Vector3<double>& p_vector);
+		inline Quaternion(const T p_scalar, const Vector3<T>& p_vector);
 
 		/**
 		 * @brief Copy Constructor
@@ -47,20 +54,20 @@ namespace GPM
 		 * @brief Construct from rotation matrix
 		 * @param p_matrix Rotation matrix
 		 */
-		inline Quaternion(const Matrix3<double>& p_matrix);
+		inline Quaternion(const Matrix3<T>& p_matrix);
 
 		/**
 		 * @brief Construct from rotation matrix
 		 * @param p_matrix Rotation matrix
 		 */
-		inline Quaternion(const Matrix4<double>& p_matrix);
+		inline Quaternion(const Matrix4<T>& p_matrix);
 
 		/**
 		 * @brief Constuct a quaternion from axis and angle in radian
 		 * @param p_axis
 		 * @param p_angleInRadians
 		 */
-		inline Quaternion(const Vector3<double>& p_axis, const double p_angleInRadians);
+		inline Quaternion(const Vector3<T>& p_axis, const T p_angleInRadians);
 
 		~Quaternion() = default;
 
@@ -68,7 +75,7 @@ namespace GPM
 		 * @brief Construct from euler angles
 		 * @param p_euler A vector representing the euler angle in degree
 		 */
-		inline void MakeFromEuler(const Vector3<double>& p_euler);
+		inline void MakeFromEuler(const Vector3<T>& p_euler);
 
 		/**
 		 * @brief Construct from euler angles
@@ -76,7 +83,7 @@ namespace GPM
 		 * @param p_y The x-angle in degree
 		 * @param p_z The x-angle in degree
 		 */
-		inline void MakeFromEuler(const double p_x, const double p_y, const double p_z);
+		inline void MakeFromEuler(const T p_x, const T p_y, const T p_z);
 
 		/**
 		 * @brief Copy assignment
@@ -147,7 +154,7 @@ namespace GPM
 		 * @param p_otherQuaternion The other quaternion
 		 * @return The result
 		 */
-		double DotProduct(const Quaternion& p_otherQuaternion) const;
+		T DotProduct(const Quaternion& p_otherQuaternion) const;
 
 		/**
 		 * @brief Return the dot product between the current quaternion and another one
@@ -155,16 +162,16 @@ namespace GPM
 		 * @param p_right The right quaternion
 		 * @return The result
 		 */
-		static double DotProduct(const Quaternion& p_left, const Quaternion& p_right);
+		static T DotProduct(const Quaternion& p_left, const Quaternion& p_right);
 
-		inline Quaternion operator*(const double p_scale) const;
-		inline Quaternion& operator*=(const double p_scale);
+		inline Quaternion operator*(const T p_scale) const;
+		inline Quaternion& operator*=(const T p_scale);
 
 		inline Quaternion operator*(const Quaternion& p_otherQuaternion) const;
 		inline Quaternion& operator*=(const Quaternion& p_otherQuaternion);
 
-		inline Quaternion operator*(const Vector3<double>& p_toMultiply) const;
-		inline Quaternion& operator*=(const Vector3<double>& p_toMultiply);
+		inline Quaternion operator*(const Vector3<T>& p_toMultiply) const;
+		inline Quaternion& operator*=(const Vector3<T>& p_toMultiply);
 
 #pragma endregion
 #pragma endregion
@@ -194,14 +201,14 @@ namespace GPM
 		 * @brief Norm of a quaternion, alias magnitude
 		 * @return The magnitude
 		 */
-		inline double Norm() const;
+		inline T Norm() const;
 
 		/**
 		 * @brief Norm square of a quaternion, alias magnitude square
 		 * @return The magnitude squared
 		 */
-		constexpr inline double NormSquare() const;
-		//double GetAngle() const;
+		constexpr inline T NormSquare() const;
+		//T GetAngle() const;
 
 		/**
 		 * @brief Inverse the current quaternion
@@ -239,58 +246,58 @@ namespace GPM
 		 * @brief Give the axis of the quaternion
 		 * @return An axis
 		 */
-		Vector3<double> GetRotationAxis() const;
+		Vector3<T> GetRotationAxis() const;
 
-		//double AngularDistance(const Quaternion& p_other) const;
+		//T AngularDistance(const Quaternion& p_other) const;
 
 		/**
 		 * @brief Return the x value of the axis
 		 * @return The value
 		 */
-		double GetXAxisValue() const;
+		T GetXAxisValue() const;
 
 		/**
 		 * @brief Return the y value of the axis
 		 * @return The value
 		 */
-		double GetYAxisValue() const;
+		T GetYAxisValue() const;
 
 		/**
 		 * @brief Return the z value of the axis
 		 * @return The value
 		 */
-		double GetZAxisValue() const;
+		T GetZAxisValue() const;
 
 		/**
 		 * @brief Return the w component (real part)
 		 * @return The value
 		 */
-		double GetRealValue() const;
+		T GetRealValue() const;
 
 
 		/**
 		 * @brief Set the x value of the axis
 		 * @param p_xValue New value
 		 */
-		void SetXAxisValue(const double p_xValue);
+		void SetXAxisValue(const T p_xValue);
 
 		/**
 		 * @brief Set the y value of the axis
 		 * @param p_yValue New value
 		 */
-		void SetYAxisValue(const double p_yValue);
+		void SetYAxisValue(const T p_yValue);
 
 		/**
 		 * @brief Set the z value of the axis
 		 * @param p_zValue New value
 		 */
-		void SetZAxisValue(const double p_zValue);
+		void SetZAxisValue(const T p_zValue);
 
 		/**
 		 * @brief Set the w component (real part)
 		 * @param p_realValue New value
 		 */
-		void SetRealValue(const double p_realValue);
+		void SetRealValue(const T p_realValue);
 
 		/**
 		 * @brief Creates a rotation with the specified forward and upwards directions.
@@ -298,7 +305,7 @@ namespace GPM
 		 * @param p_upwards Upwards direction
 		 * @return The quaternion
 		 */
-		Quaternion LookRotation(const Vector3<double>& p_forward, const Vector3<double>& p_upwards = Vector3<double>::up) const;
+		Quaternion LookRotation(const Vector3<T>& p_forward, const Vector3<T>& p_upwards = Vector3<T>::up) const;
 
 		/**
 		 * @brief Create a quaternion out of an axis and angle
@@ -306,7 +313,7 @@ namespace GPM
 		 * @param p_angle The angle
 		 * @return The quaternion
 		 */
-		static Quaternion CreateFromAxisAngle(const Vector3<double>& p_axis, const double p_angle);
+		static Quaternion CreateFromAxisAngle(const Vector3<T>& p_axis, const T p_angle);
 
 		/**
 		 * @brief Interpolation between two quaternions
@@ -315,7 +322,7 @@ namespace GPM
 		 * @param p_alpha Coefficient
 		 * @return The quaternion
 		 */
-		static Quaternion Lerp(const Quaternion& p_start, const Quaternion& p_end, const double p_alpha);
+		static Quaternion Lerp(const Quaternion& p_start, const Quaternion& p_end, const T p_alpha);
 
 		/**
 		 * @brief Smoothly interpolate between two quaternions
@@ -324,7 +331,7 @@ namespace GPM
 		 * @param p_alpha Coefficient
 		 * @return The quaternion
 		 */
-		static Quaternion Slerp(const Quaternion& p_start, const Quaternion& p_end, const double p_alpha);
+		static Quaternion Slerp(const Quaternion& p_start, const Quaternion& p_end, const T p_alpha);
 
         /**
          * @brief Smoothly interpolate between two quaternions and use the shortest path to it. Prevents wrong side rotation.
@@ -333,7 +340,7 @@ namespace GPM
          * @param p_alpha Coefficient
          * @return The quaternion
          */
-	    static Quaternion SlerpShortestPath(const Quaternion& p_start, const Quaternion& p_end, double p_alpha);
+	    static Quaternion SlerpShortestPath(const Quaternion& p_start, const Quaternion& p_end, T p_alpha);
 
         /**
 		 * @brief Normalized interpolate between two quaternions
@@ -342,7 +349,7 @@ namespace GPM
 		 * @param p_alpha Coefficient
 		 * @return The quaternion
 		 */
-		static Quaternion Nlerp(const Quaternion& p_start, const Quaternion& p_end, const double p_alpha);
+		static Quaternion Nlerp(const Quaternion& p_start, const Quaternion& p_end, const T p_alpha);
 
 		/**
 		 * @brief Rotate a point relative to pivot
@@ -350,7 +357,7 @@ namespace GPM
 		 * @param p_pivot
 		 * @warning This method is not implemented yet and will fail at compilation.
 		 */
-		Vector3<double> RotateRelativeToPivot(const Vector3<double>& p_position, const Vector3<double>& p_pivot) const;
+		Vector3<T> RotateRelativeToPivot(const Vector3<T>& p_position, const Vector3<T>& p_pivot) const;
 
 		/**
 		 * @brief Rotate a point relative to pivot using euler angles
@@ -359,8 +366,8 @@ namespace GPM
 		 * @param p_eulerAngles
 		 * @warning This method is not implemented yet and will fail at compilation.
 		 */
-		static Vector3<double> RotateRelativeToPivot(const Vector3<double>& p_position, const Vector3<double>& p_pivot,
-			const Vector3<double>& p_eulerAngles);
+		static Vector3<T> RotateRelativeToPivot(const Vector3<T>& p_position, const Vector3<T>& p_pivot,
+			const Vector3<T>& p_eulerAngles);
 
 		/**
 		 * @brief Rotate a point relative to pivot using a quaternion
@@ -369,7 +376,7 @@ namespace GPM
 		 * @param p_quaternion
 		 * @warning This method is not implemented yet and will fail at compilation.
 		*/
-		static Vector3<double> RotateRelativeToPivot(const Vector3<double>& p_position, const Vector3<double>& p_pivot,
+		static Vector3<T> RotateRelativeToPivot(const Vector3<T>& p_position, const Vector3<T>& p_pivot,
 			Quaternion& p_quaternion);
 
 		/**
@@ -377,7 +384,7 @@ namespace GPM
 		 * @param p_toRotate
 		 * @warning This method is not implemented yet and will fail at compilation.
 		 */
-		Vector3<double> RotateVector(const Vector3<double>& p_toRotate) const;
+		Vector3<T> RotateVector(const Vector3<T>& p_toRotate) const;
 
 		/**
 		 * @brief Rotate the vector of a certain angle around an arbitrary axis
@@ -386,7 +393,7 @@ namespace GPM
 		 * @param p_vectorToRotate Vector to rotate
 		 * @return The vector rotated
 		*/
-		static Vector3<double> RotateVectorAboutAngleAndAxis(const double p_angle, const Vector3<double>& p_axis, const Vector3<double>& p_vectorToRotate);
+		static Vector3<T> RotateVectorAboutAngleAndAxis(const T p_angle, const Vector3<T>& p_axis, const Vector3<T>& p_vectorToRotate);
 
 		/**
 		 * @brief Return the value aliased with index, just like arrays
@@ -394,7 +401,7 @@ namespace GPM
 		 * @return Return the value associated at the indicated index
 		 * @note Quaternion representation is as follow : [w, x, y, z]
 		 */
-		double operator[](const int p_index) const;
+		T operator[](const int p_index) const;
 		
 #pragma endregion
 #pragma region Conversions
@@ -408,14 +415,14 @@ namespace GPM
 		 * @brief Transform the current quaternion to euler angles in degrees
 		 * @return A vector containing each angles
 		 */
-		Vector3<double> ToEuler() const;
+		Vector3<T> ToEuler() const;
 
 		/**
 		 * @brief Create a quaternion from euler in degrees
 		 * @param p_euler The euler angle in degree
 		 * @return The quaternion
 		 */
-		static Quaternion ToQuaternion(const Vector3<double>& p_euler);
+		static Quaternion ToQuaternion(const Vector3<T>& p_euler);
 
 		/**
 		 * @brief Create a quaternion from yaw, pitch and roll angle in degrees
@@ -424,7 +431,7 @@ namespace GPM
 		 * @param p_roll The roll angle
 		 * @return The quaternion
 		 */
-		static Quaternion ToQuaternion(const double p_yaw, const double p_pitch, const double p_roll);
+		static Quaternion ToQuaternion(const T p_yaw, const T p_pitch, const T p_roll);
 
 		/**
 		 * @brief Transform the current quaternion to string
@@ -440,20 +447,46 @@ namespace GPM
 		static std::string ToString(const Quaternion& p_quaternion);
 
 		/**
-		 * @brief Return a Matrix3 of double out of the quaternion
+		 * @brief Return a Matrix3 of T out of the quaternion
 		 * @return The Matrix3<float>
 		 */
 		Matrix3<float> ToMatrix3() const;
 
 		/**
-		 * @brief Return a Matrix4 of double out of the quaternion
+		 * @brief Return a Matrix4 of T out of the quaternion
 		 * @return The Matrix4<float>
 		 */
 		Matrix4<float> ToMatrix4() const;
 #pragma endregion
+
+	private:
+		/**
+		 * @brief Sine in the precision of the quaternion
+		 * @param p_value The angle in radians
+		 * @return The sine
+		 */
+		static T Sin(const T p_value);
+
+		/**
+		 * @brief Cosine in the precision of the quaternion
+		 * @param p_value The angle in radians
+		 * @return The cosine
+		 */
+		static T Cos(const T p_value);
+
+		/**
+		 * @brief Arc cosine in the precision of the quaternion
+		 * @param p_value The cosine, between -1 and 1
+		 * @return The angle in radians
+		 */
+		static T Arccos(const T p_value);
 	};
 
-	std::ostream& operator<<(std::ostream& p_stream, const Quaternion& p_quaternion);
+	template<typename T>
+	std::ostream& operator<<(std::ostream& p_stream, const Quaternion<T>& p_quaternion);
+
+	using QuaternionF = Quaternion<float>;
+	using QuaternionD = Quaternion<double>;
 }
 
 #include <GPM/Quaternion/Quaternion.inl>
\ No newline at end of file
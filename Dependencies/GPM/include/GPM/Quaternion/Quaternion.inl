@@ -1,6 +1,7 @@
 #pragma once
 
 #include <utility>
+#include <type_traits>
 #include <stdexcept>
 #include <GPM/Tools/Utils.h>
 
@@ -10,37 +11,43 @@ namespace GPM
 {
 
 #pragma region Constructors & Assignment
-	inline Quaternion::Quaternion()
-		: axis{ 0.0, 0.0, 0.0 }, w{ 1.0 }
+	template<typename T>
+	inline Quaternion<T>::Quaternion()
+		: axis{ static_cast<T>(0.0), static_cast<T>(0.0), static_cast<T>(0.0) }, w{ static_cast<T>(1.0) }
 	{	}
 
-	inline Quaternion::Quaternion(const double p_x, const double p_y, const double p_z,
-		const double p_w)
+	template<typename T>
+	inline Quaternion<T>::Quaternion(const T p_x, const T p_y, const T p_z,
+		const T p_w)
 		: axis{ p_x, p_y, p_z }, w{ p_w }
 	{	}
 
-	inline Quaternion::Quaternion(const double p_scalar, const Vector3<double>& p_vector)
+	template<typename T>
+	inline Quaternion<T>::Quaternion(const T p_scalar, const Vector3<T>& p_vector)
 		: axis{ p_vector }, w{ p_scalar }
 	{	}
 
-	inline Quaternion::Quaternion(const Quaternion& p_other)
+	template<typename T>
+	inline Quaternion<T>::Quaternion(const Quaternion<T>& p_other)
 		: axis{ p_other.axis.x, p_other.axis.y, p_other.axis.z }, w{ p_other.w }
 	{	}
 
-	inline Quaternion::Quaternion(Quaternion&& p_other) noexcept
+	template<typename T>
+	inline Quaternion<T>::Quaternion(Quaternion<T>&& p_other) noexcept
 		: axis{ std::move(p_other.axis) }, w{ p_other.w }
 	{	}
 
-	inline Quaternion::Quaternion(const Matrix3<double>& p_matrix)
-		: axis{ 0.0, 0.0, 0.0 }, w{ 1.0 }
+	template<typename T>
+	inline Quaternion<T>::Quaternion(const Matrix3<T>& p_matrix)
+		: axis{ static_cast<T>(0.0), static_cast<T>(0.0), static_cast<T>(0.0) }, w{ static_cast<T>(1.0) }
 	{
-		const double trace = p_matrix.m_data[0] + p_matrix.m_data[4] + p_matrix.m_data[8];
+		const T trace = p_matrix.m_data[0] + p_matrix.m_data[4] + p_matrix.m_data[8];
 
 		if (trace > 0.0f)
 		{      //s=4*qw
 
-			w = 0.5 * Tools::Utils::SquareRoot(1.0 + trace);
-			const double S = 0.25 / w;
+			w = static_cast<T>(0.5) * Tools::Utils::SquareRoot(static_cast<T>(1.0) + trace);
+			const T S = static_cast<T>(0.25) / w;
 
 			axis.x = S * (p_matrix.m_data[5] - p_matrix.m_data[7]);
 			axis.y = S * (p_matrix.m_data[6] - p_matrix.m_data[2]);
@@ -50,8 +57,8 @@ namespace GPM
 		else if (p_matrix.m_data[0] > p_matrix.m_data[4] && p_matrix.m_data[0] > p_matrix.m_data[8])
 		{ //s=4*qx
 
-			axis.x = 0.5 * Tools::Utils::SquareRoot(1.0 + p_matrix.m_data[0] - p_matrix.m_data[4] - p_matrix.m_data[8]);
-			const double X = 0.25 / axis.x;
+			axis.x = static_cast<T>(0.5) * Tools::Utils::SquareRoot(static_cast<T>(1.0) + p_matrix.m_data[0] - p_matrix.m_data[4] - p_matrix.m_data[8]);
+			const T X = static_cast<T>(0.25) / axis.x;
 
 			axis.y = X * (p_matrix.m_data[3] + p_matrix.m_data[1]);
 			axis.z = X * (p_matrix.m_data[6] + p_matrix.m_data[2]);
@@ -60,8 +67,8 @@ namespace GPM
 		else if (p_matrix.m_data[4] > p_matrix.m_data[8])
 		{ //s=4*qy
 
-			axis.y = 0.5 * Tools::Utils::SquareRoot(1.0 - p_matrix.m_data[0] + p_matrix.m_data[4] - p_matrix.m_data[8]);
-			const double Y = 0.25 / axis.y;
+			axis.y = static_cast<T>(0.5) * Tools::Utils::SquareRoot(static_cast<T>(1.0) - p_matrix.m_data[0] + p_matrix.m_data[4] - p_matrix.m_data[8]);
+			const T Y = static_cast<T>(0.25) / axis.y;
 			axis.x = Y * (p_matrix.m_data[3] + p_matrix.m_data[1]);
 			axis.z = Y * (p_matrix.m_data[7] + p_matrix.m_data[5]);
 			w = Y * (p_matrix.m_data[6] - p_matrix.m_data[2]);
@@ -70,75 +77,80 @@ namespace GPM
 		else
 		{ //s=4*qz
 
-			axis.z = 0.5 * Tools::Utils::SquareRoot(1.0 - p_matrix.m_data[0] - p_matrix.m_data[4] + p_matrix.m_data[8]);
-			const double Z = 0.25 / axis.z;
+			axis.z = static_cast<T>(0.5) * Tools::Utils::SquareRoot(static_cast<T>(1.0) - p_matrix.m_data[0] - p_matrix.m_data[4] + p_matrix.m_data[8]);
+			const T Z = static_cast<T>(0.25) / axis.z;
 			axis.x = Z * (p_matrix.m_data[6] + p_matrix.m_data[2]);
 			axis.y = Z * (p_matrix.m_data[7] + p_matrix.m_data[5]);
 			w = Z * (p_matrix.m_data[1] - p_matrix.m_data[3]);
 		}
 	}
 
-	inline Quaternion::Quaternion(const Matrix4<double>& p_matrix)
-		: axis{ 0.0, 0.0, 0.0 }, w{ 1.0 }
+	template<typename T>
+	inline Quaternion<T>::Quaternion(const Matrix4<T>& p_matrix)
+		: axis{ static_cast<T>(0.0), static_cast<T>(0.0), static_cast<T>(0.0) }, w{ static_cast<T>(1.0) }
 	{
-		w = Tools::Utils::SquareRoot(std::max(0.0, 1.0 + p_matrix.m_data[0] + p_matrix.m_data[5] + p_matrix.m_data[10])) / 2.0;
-		axis.x = Tools::Utils::SquareRoot(std::max(0.0, 1.0 + p_matrix.m_data[0] - p_matrix.m_data[5] - p_matrix.m_data[10])) / 2.0;
-		axis.y = Tools::Utils::SquareRoot(std::max(0.0, 1.0 - p_matrix.m_data[0] + p_matrix.m_data[5] - p_matrix.m_data[10])) / 2.0;
-		axis.z = Tools::Utils::SquareRoot(std::max(0.0, 1.0 - p_matrix.m_data[0] - p_matrix.m_data[5] + p_matrix.m_data[10])) / 2.0;
+		w = Tools::Utils::SquareRoot(std::max(static_cast<T>(0.0), static_cast<T>(1.0) + p_matrix.m_data[0] + p_matrix.m_data[5] + p_matrix.m_data[10])) / static_cast<T>(2.0);
+		axis.x = Tools::Utils::SquareRoot(std::max(static_cast<T>(0.0), static_cast<T>(1.0) + p_matrix.m_data[0] - p_matrix.m_data[5] - p_matrix.m_data[10])) / static_cast<T>(2.0);
+		axis.y = Tools::Utils::SquareRoot(std::max(static_cast<T>(0.0), static_cast<T>(1.0) - p_matrix.m_data[0] + p_matrix.m_data[5] - p_matrix.m_data[10])) / static_cast<T>(2.0);
+		axis.z = Tools::Utils::SquareRoot(std::max(static_cast<T>(0.0), static_cast<T>(1.0) - p_matrix.m_data[0] - p_matrix.m_data[5] + p_matrix.m_data[10])) / static_cast<T>(2.0);
 
 		axis.x *= Tools::Utils::Sign(axis.x * (p_matrix.m_data[9] - p_matrix.m_data[6]));
 		axis.y *= Tools::Utils::Sign(axis.y * (p_matrix.m_data[2] - p_matrix.m_data[8]));
 		axis.z *= Tools::Utils::Sign(axis.z * (p_matrix.m_data[4] - p_matrix.m_data[1]));
 	}
 
-	inline Quaternion::Quaternion(const Vector3<double>& p_axis,
-		const double p_angleInRadians)
-		: axis{ 0.0, 0.0, 0.0 }, w{ 1.0 }
+	template<typename T>
+	inline Quaternion<T>::Quaternion(const Vector3<T>& p_axis,
+		const T p_angleInRadians)
+		: axis{ static_cast<T>(0.0), static_cast<T>(0.0), static_cast<T>(0.0) }, w{ static_cast<T>(1.0) }
 	{
-		const double angleDivided = p_angleInRadians / 2.0;
+		const T angleDivided = p_angleInRadians / static_cast<T>(2.0);
 
-		w = Tools::Utils::Cos(angleDivided);
+		w = Cos(angleDivided);
 
-		const double sinAngle = Tools::Utils::Sin(angleDivided);
+		const T sinAngle = Sin(angleDivided);
 
 		axis.x = sinAngle * p_axis.x;
 		axis.y = sinAngle * p_axis.y;
 		axis.z = sinAngle * p_axis.z;
 	}
 
-	inline void Quaternion::MakeFromEuler(const Vector3<double>& p_euler)
+	template<typename T>
+	inline void Quaternion<T>::MakeFromEuler(const Vector3<T>& p_euler)
 	{
-		double x = Tools::Utils::ToRadians(p_euler.x);
-		double y = Tools::Utils::ToRadians(p_euler.y);
-		double z = Tools::Utils::ToRadians(p_euler.z);
+		T x = Tools::Utils::ToRadians(p_euler.x);
+		T y = Tools::Utils::ToRadians(p_euler.y);
+		T z = Tools::Utils::ToRadians(p_euler.z);
 
-		x = x / 2.0;
-		y = y / 2.0;
-		z = z / 2.0;
+		x = x / static_cast<T>(2.0);
+		y = y / static_cast<T>(2.0);
+		z = z / static_cast<T>(2.0);
 
-		w = cos(z) * cos(y) * cos(x) + sin(z) * sin(y) * sin(x);
-		axis.x = cos(z) * cos(y) * sin(x) - sin(z) * sin(y) * cos(x);
-		axis.y = cos(z) * sin(y) * cos(x) + sin(z) * cos(y) * sin(x);
-		axis.z = sin(z) * cos(y) * cos(x) - cos(z) * sin(y) * sin(x);
+		w = Cos(z) * Cos(y) * Cos(x) + Sin(z) * Sin(y) * Sin(x);
+		axis.x = Cos(z) * Cos(y) * Sin(x) - Sin(z) * Sin(y) * Cos(x);
+		axis.y = Cos(z) * Sin(y) * Cos(x) + Sin(z) * Cos(y) * Sin(x);
+		axis.z = Sin(z) * Cos(y) * Cos(x) - Cos(z) * Sin(y) * Sin(x);
 	}
 
-	inline void Quaternion::MakeFromEuler(const double p_x, const double p_y, const double p_z)
+	template<typename T>
+	inline void Quaternion<T>::MakeFromEuler(const T p_x, const T p_y, const T p_z)
 	{
-		double x = Tools::Utils::ToRadians(p_x);
-		double y = Tools::Utils::ToRadians(p_y);
-		double z = Tools::Utils::ToRadians(p_z);
+		T x = Tools::Utils::ToRadians(p_x);
+		T y = Tools::Utils::ToRadians(p_y);
+		T z = Tools::Utils::ToRadians(p_z);
 
-		x = x / 2.0;
-		y = y / 2.0;
-		z = z / 2.0;
+		x = x / static_cast<T>(2.0);
+		y = y / static_cast<T>(2.0);
+		z = z / static_cast<T>(2.0);
 
-		w = cos(z) * cos(y) * cos(x) + sin(z) * sin(y) * sin(x);
-		axis.x = cos(z) * cos(y) * sin(x) - sin(z) * sin(y) * cos(x);
-		axis.y = cos(z) * sin(y) * cos(x) + sin(z) * cos(y) * sin(x);
-		axis.z = sin(z) * cos(y) * cos(x) - cos(z) * sin(y) * sin(x);
+		w = Cos(z) * Cos(y) * Cos(x) + Sin(z) * Sin(y) * Sin(x);
+		axis.x = Cos(z) * Cos(y) * Sin(x) - Sin(z) * Sin(y) * Cos(x);
+		axis.y = Cos(z) * Sin(y) * Cos(x) + Sin(z) * Cos(y) * Sin(x);
+		axis.z = Sin(z) * Cos(y) * Cos(x) - Cos(z) * Sin(y) * Sin(x);
 	}
 
-	inline Quaternion& Quaternion::operator=(Quaternion&& p_other) noexcept
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::operator=(Quaternion<T>&& p_other) noexcept
 	{
 		w = p_other.w;
 		axis = p_other.axis;
@@ -146,37 +158,44 @@ namespace GPM
 		return (*this);
 	}
 
-	inline bool Quaternion::IsIdentity() const
+	template<typename T>
+	inline bool Quaternion<T>::IsIdentity() const
 	{
-		return axis.x == 0.0 && axis.y == 0.0 && axis.z == 0.0;
+		return axis.x == static_cast<T>(0.0) && axis.y == static_cast<T>(0.0) && axis.z == static_cast<T>(0.0);
 	}
 
-	inline bool Quaternion::IsPure() const
+	template<typename T>
+	inline bool Quaternion<T>::IsPure() const
 	{
-		return w == 0.0;
+		return w == static_cast<T>(0.0);
 	}
 
-	inline bool Quaternion::IsNormalized() const
+	template<typename T>
+	inline bool Quaternion<T>::IsNormalized() const
 	{
-		return Norm() == 1.0;
+		return Norm() == static_cast<T>(1.0);
 	}
 
-	inline bool Quaternion::operator==(const Quaternion& p_otherQuaternion) const
+	template<typename T>
+	inline bool Quaternion<T>::operator==(const Quaternion<T>& p_otherQuaternion) const
 	{
 		return w == p_otherQuaternion.w && axis == p_otherQuaternion.axis;
 	}
 
-	inline bool Quaternion::operator!=(const Quaternion& p_otherQuaternion) const
+	template<typename T>
+	inline bool Quaternion<T>::operator!=(const Quaternion<T>& p_otherQuaternion) const
 	{
 		return w != p_otherQuaternion.w || axis != p_otherQuaternion.axis;
 	}
 
-	inline Quaternion Quaternion::operator+(const Quaternion& p_otherQuaternion) const
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::operator+(const Quaternion<T>& p_otherQuaternion) const
 	{
-		return  { Quaternion{  w + p_otherQuaternion.w, axis + p_otherQuaternion.axis } };
+		return  { Quaternion<T>{  w + p_otherQuaternion.w, axis + p_otherQuaternion.axis } };
 	}
 
-	inline Quaternion& Quaternion::operator+=(const Quaternion& p_otherQuaternion)
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::operator+=(const Quaternion<T>& p_otherQuaternion)
 	{
 		w += p_otherQuaternion.w;
 		axis += p_otherQuaternion.axis;
@@ -184,12 +203,14 @@ namespace GPM
 		return { *this };
 	}
 
-	inline Quaternion Quaternion::operator-(const Quaternion& p_otherQuaternion) const
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::operator-(const Quaternion<T>& p_otherQuaternion) const
 	{
-		return  { Quaternion{  w - p_otherQuaternion.w, axis - p_otherQuaternion.axis } };
+		return  { Quaternion<T>{  w - p_otherQuaternion.w, axis - p_otherQuaternion.axis } };
 	}
 
-	inline Quaternion& Quaternion::operator-=(const Quaternion& p_otherQuaternion)
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::operator-=(const Quaternion<T>& p_otherQuaternion)
 	{
 		w -= p_otherQuaternion.w;
 		axis -= p_otherQuaternion.axis;
@@ -197,17 +218,20 @@ namespace GPM
 		return { *this };
 	}
 
-	inline double Quaternion::DotProduct(const Quaternion& p_otherQuaternion) const
+	template<typename T>
+	inline T Quaternion<T>::DotProduct(const Quaternion<T>& p_otherQuaternion) const
 	{
 		return w * p_otherQuaternion.w + axis.x * p_otherQuaternion.axis.x + axis.y * p_otherQuaternion.axis.y + axis.z * p_otherQuaternion.axis.z;
 	}
 
-	inline double Quaternion::DotProduct(const Quaternion& p_left, const Quaternion& p_right)
+	template<typename T>
+	inline T Quaternion<T>::DotProduct(const Quaternion<T>& p_left, const Quaternion<T>& p_right)
 	{
 		return p_left.w * p_right.w + p_left.axis.x * p_right.axis.x + p_left.axis.y * p_right.axis.y + p_left.axis.z * p_right.axis.z;
 	}
 
-	inline Quaternion& Quaternion::operator*=(const double p_scale)
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::operator*=(const T p_scale)
 	{
 		w *= p_scale;
 		axis *= p_scale;
@@ -215,49 +239,55 @@ namespace GPM
 		return { *this };
 	}
 
-	inline Quaternion Quaternion::operator*(const double p_scale) const
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::operator*(const T p_scale) const
 	{
-		return { Quaternion{w * p_scale, axis * p_scale} };
+		return { Quaternion<T>{w * p_scale, axis * p_scale} };
 	}
 
-	inline Quaternion Quaternion::operator*(const Quaternion& p_otherQuaternion) const
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::operator*(const Quaternion<T>& p_otherQuaternion) const
 	{
 		return { (*this).Multiply(p_otherQuaternion) };
 	}
 
-	inline Quaternion& Quaternion::operator*=(const Quaternion& p_otherQuaternion)
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::operator*=(const Quaternion<T>& p_otherQuaternion)
 	{
 		(*this) = Multiply(p_otherQuaternion);
 
 		return { (*this) };
 	}
 
-	inline Quaternion Quaternion::operator*(const Vector3<double>& p_toMultiply) const
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::operator*(const Vector3<T>& p_toMultiply) const
 	{
-		const double sPart = -(axis.x * p_toMultiply.x + axis.y * p_toMultiply.y + axis.z * p_toMultiply.z);
-		const double xPart = w * p_toMultiply.x + axis.y * p_toMultiply.z - axis.z * p_toMultiply.y;
-		const double yPart = w * p_toMultiply.y + axis.z * p_toMultiply.x - axis.x * p_toMultiply.z;
-		const double zPart = w * p_toMultiply.z + axis.x * p_toMultiply.y - axis.y * p_toMultiply.x;
+		const T sPart = -(axis.x * p_toMultiply.x + axis.y * p_toMultiply.y + axis.z * p_toMultiply.z);
+		const T xPart = w * p_toMultiply.x + axis.y * p_toMultiply.z - axis.z * p_toMultiply.y;
+		const T yPart = w * p_toMultiply.y + axis.z * p_toMultiply.x - axis.x * p_toMultiply.z;
+		const T zPart = w * p_toMultiply.z + axis.x * p_toMultiply.y - axis.y * p_toMultiply.x;
 
-		return { Quaternion{ sPart, Vector3<double> { xPart, yPart, zPart } } };
+		return { Quaternion<T>{ sPart, Vector3<T> { xPart, yPart, zPart } } };
 	}
 
-	inline Quaternion& Quaternion::operator*=(const Vector3<double>& p_toMultiply)
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::operator*=(const Vector3<T>& p_toMultiply)
 	{
-		const double sPart = -(axis.x * p_toMultiply.x + axis.y * p_toMultiply.y + axis.z * p_toMultiply.z);
-		const double xPart = w * p_toMultiply.x + axis.y * p_toMultiply.z - axis.z * p_toMultiply.y;
-		const double yPart = w * p_toMultiply.y + axis.z * p_toMultiply.x - axis.x * p_toMultiply.z;
-		const double zPart = w * p_toMultiply.z + axis.x * p_toMultiply.y - axis.y * p_toMultiply.x;
+		const T sPart = -(axis.x * p_toMultiply.x + axis.y * p_toMultiply.y + axis.z * p_toMultiply.z);
+		const T xPart = w * p_toMultiply.x + axis.y * p_toMultiply.z - axis.z * p_toMultiply.y;
+		const T yPart = w * p_toMultiply.y + axis.z * p_toMultiply.x - axis.x * p_toMultiply.z;
+		const T zPart = w * p_toMultiply.z + axis.x * p_toMultiply.y - axis.y * p_toMultiply.x;
 
 		w = sPart;
-		axis = Vector3<double>{ xPart, yPart, zPart };
+		axis = Vector3<T>{ xPart, yPart, zPart };
 
 		return { (*this) };
 	}
 
-	inline Quaternion Quaternion::Multiply(const Quaternion& p_quaternion) const
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::Multiply(const Quaternion<T>& p_quaternion) const
 	{
-		Quaternion result;
+		Quaternion<T> result;
 		result.axis.x = axis.x * p_quaternion.w + axis.y * p_quaternion.axis.z - axis.z * p_quaternion.axis.y + w * p_quaternion.axis.x;
 		result.axis.y = -axis.x * p_quaternion.axis.z + axis.y * p_quaternion.w + axis.z * p_quaternion.axis.x + w * p_quaternion.axis.y;
 		result.axis.z = axis.x * p_quaternion.axis.y - axis.y * p_quaternion.axis.x + axis.z * p_quaternion.w + w * p_quaternion.axis.z;
@@ -266,20 +296,22 @@ namespace GPM
 
 	}
 
-	inline double Quaternion::Norm() const
+	template<typename T>
+	inline T Quaternion<T>::Norm() const
 	{
 		return Tools::Utils::SquareRoot(w * w + axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
 	}
 
-	inline Quaternion& Quaternion::Inverse()
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::Inverse()
 	{
-		double absoluteValue = NormSquare();
-		absoluteValue = 1.0 / absoluteValue;
+		T absoluteValue = NormSquare();
+		absoluteValue = static_cast<T>(1.0) / absoluteValue;
 
-		const Quaternion conjugateValue = Conjugate();
+		const Quaternion<T> conjugateValue = Conjugate();
 
-		const double scalar = conjugateValue.w * (absoluteValue);
-		const Vector3<double> imaginary = conjugateValue.axis * (absoluteValue);
+		const T scalar = conjugateValue.w * (absoluteValue);
+		const Vector3<T> imaginary = conjugateValue.axis * (absoluteValue);
 
 		w = scalar;
 		axis = imaginary;
@@ -287,60 +319,66 @@ namespace GPM
 		return { (*this) };
 	}
 
-	inline Quaternion Quaternion::Inverse(const Quaternion& p_quaternion)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::Inverse(const Quaternion<T>& p_quaternion)
 	{
-		double absoluteValue = p_quaternion.NormSquare();
-		absoluteValue = 1.0 / absoluteValue;
+		T absoluteValue = p_quaternion.NormSquare();
+		absoluteValue = static_cast<T>(1.0) / absoluteValue;
 
-		const Quaternion conjugateValue = Conjugate(p_quaternion);
+		const Quaternion<T> conjugateValue = Conjugate(p_quaternion);
 
-		return { Quaternion {conjugateValue.w * absoluteValue, Vector3<double> {conjugateValue.axis* absoluteValue} } };
+		return { Quaternion<T> {conjugateValue.w * absoluteValue, Vector3<T> {conjugateValue.axis* absoluteValue} } };
 	}
 
-	inline Quaternion& Quaternion::Conjugate()
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::Conjugate()
 	{
-		axis *= -1.0;
+		axis *= -static_cast<T>(1.0);
 
 		return { (*this) };
 	}
 
-	inline Quaternion Quaternion::Conjugate(const Quaternion& p_quaternion)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::Conjugate(const Quaternion<T>& p_quaternion)
 	{
-		return { Quaternion { p_quaternion.w, p_quaternion.axis * -1.0 } };
+		return { Quaternion<T> { p_quaternion.w, p_quaternion.axis * -static_cast<T>(1.0) } };
 	}
 
-	inline Quaternion& Quaternion::ConvertToUnitNormQuaternion()
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::ConvertToUnitNormQuaternion()
 	{
-		const double angle = Tools::Utils::ToRadians(w);
+		const T angle = Tools::Utils::ToRadians(w);
 
 		axis.Normalize();
-		w = Tools::Utils::Cos(angle * 0.5);
-		axis = axis * Tools::Utils::Sin(angle * 0.5);
+		w = Cos(angle * static_cast<T>(0.5));
+		axis = axis * Sin(angle * static_cast<T>(0.5));
 
 		return { (*this) };
 	}
 
-	inline Vector3<double> Quaternion::RotateVectorAboutAngleAndAxis(const double p_angle, const Vector3<double>& p_axis, const Vector3<double>& p_vectorToRotate)
+	template<typename T>
+	inline Vector3<T> Quaternion<T>::RotateVectorAboutAngleAndAxis(const T p_angle, const Vector3<T>& p_axis, const Vector3<T>& p_vectorToRotate)
 	{
-		const Quaternion p{ 0, p_vectorToRotate };
+		const Quaternion<T> p{ 0, p_vectorToRotate };
 
 		//normalize the axis
-		const Vector3<double> uAxis = p_axis.Normalized();
+		const Vector3<T> uAxis = p_axis.Normalized();
 
 		//create the real quaternion
-		Quaternion q{ p_angle, uAxis };
+		Quaternion<T> q{ p_angle, uAxis };
 
 		//convert quaternion to unit norm quaternion
 		q.ConvertToUnitNormQuaternion();
 
-		const Quaternion qInverse = Inverse(q);
+		const Quaternion<T> qInverse = Inverse(q);
 
-		const Quaternion rotatedVector = q * p * qInverse;
+		const Quaternion<T> rotatedVector = q * p * qInverse;
 
 		return rotatedVector.axis;
 	}
 
-	inline double Quaternion::operator[](const int p_index) const
+	template<typename T>
+	inline T Quaternion<T>::operator[](const int p_index) const
 	{
 		if (p_index < 0 || p_index > 3)
 			throw std::out_of_range("Out of range access with index:" + std::to_string(p_index) + " in Quaternion");
@@ -351,138 +389,152 @@ namespace GPM
 		case 1: return axis.x;
 		case 2: return axis.y;
 		case 3: return axis.z;
-		default: return 1.0;
+		default: return static_cast<T>(1.0);
 		}
 	}
 
-	inline Vector3<double> Quaternion::GetRotationAxis() const
+	template<typename T>
+	inline Vector3<T> Quaternion<T>::GetRotationAxis() const
 	{
 		return axis;
 	}
 
-	inline double Quaternion::GetXAxisValue() const
+	template<typename T>
+	inline T Quaternion<T>::GetXAxisValue() const
 	{
 		return axis.x;
 	}
 
-	inline double Quaternion::GetYAxisValue() const
+	template<typename T>
+	inline T Quaternion<T>::GetYAxisValue() const
 	{
 		return axis.y;
 	}
 
-	inline double Quaternion::GetZAxisValue() const
+	template<typename T>
+	inline T Quaternion<T>::GetZAxisValue() const
 	{
 		return axis.z;
 	}
 
-	inline double Quaternion::GetRealValue() const
+	template<typename T>
+	inline T Quaternion<T>::GetRealValue() const
 	{
 		return w;
 	}
 
-	inline void Quaternion::SetXAxisValue(const double p_xValue)
+	template<typename T>
+	inline void Quaternion<T>::SetXAxisValue(const T p_xValue)
 	{
 		axis.x = p_xValue;
 	}
 
-	inline void Quaternion::SetYAxisValue(const double p_yValue)
+	template<typename T>
+	inline void Quaternion<T>::SetYAxisValue(const T p_yValue)
 	{
 		axis.y = p_yValue;
 	}
 
-	inline void Quaternion::SetZAxisValue(const double p_zValue)
+	template<typename T>
+	inline void Quaternion<T>::SetZAxisValue(const T p_zValue)
 	{
 		axis.z = p_zValue;
 	}
 
-	inline void Quaternion::SetRealValue(const double p_realValue)
+	template<typename T>
+	inline void Quaternion<T>::SetRealValue(const T p_realValue)
 	{
 		w = p_realValue;
 	}
 
-	inline Quaternion Quaternion::LookRotation(const Vector3<double>& p_forward, const Vector3<double>& p_upwards) const
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::LookRotation(const Vector3<T>& p_forward, const Vector3<T>& p_upwards) const
 	{
-		const Vector3<double> forwardVector = (p_upwards - p_forward).Normalized();
+		const Vector3<T> forwardVector = (p_upwards - p_forward).Normalized();
 
-		const double dot = Vector3<double>::forward.Dot(forwardVector);
+		const T dot = Vector3<T>::forward.Dot(forwardVector);
 
-		if (Tools::Utils::Abs<double>(dot - (-1.0)) < 0.000001)
+		if (Tools::Utils::Abs<T>(dot - (-static_cast<T>(1.0))) < static_cast<T>(0.000001))
 		{
-			return Quaternion(Vector3<double>::up.x, Vector3<double>::up.y, Vector3<double>::up.z, static_cast<double>(Tools::M_PI));
+			return Quaternion<T>(Vector3<T>::up.x, Vector3<T>::up.y, Vector3<T>::up.z, static_cast<T>(Tools::M_PI));
 		}
-		if (Tools::Utils::Abs<double>(dot - (1.0)) < 0.000001)
+		if (Tools::Utils::Abs<T>(dot - (static_cast<T>(1.0))) < static_cast<T>(0.000001))
 		{
-			return Quaternion{ 0.0, 0.0, 0.0, 1.0 };
+			return Quaternion<T>{ static_cast<T>(0.0), static_cast<T>(0.0), static_cast<T>(0.0), static_cast<T>(1.0) };
 		}
 
-		const double rotAngle = Tools::Utils::Arccos(dot);
-		Vector3<double> rotAxis = Vector3<double>::Cross(Vector3<double>::forward, forwardVector);
+		const T rotAngle = Arccos(dot);
+		Vector3<T> rotAxis = Vector3<T>::Cross(Vector3<T>::forward, forwardVector);
 		rotAxis = rotAxis.Normalized();
 		return CreateFromAxisAngle(rotAxis, rotAngle);
 	}
 
-	inline Quaternion Quaternion::CreateFromAxisAngle(const Vector3<double>& p_axis,
-		const double p_angle)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::CreateFromAxisAngle(const Vector3<T>& p_axis,
+		const T p_angle)
 	{
-		const double halfAngle = p_angle * 0.5;
-		const double s = Tools::Utils::Sin(halfAngle);
+		const T halfAngle = p_angle * static_cast<T>(0.5);
+		const T s = Sin(halfAngle);
 
-		Quaternion q;
+		Quaternion<T> q;
 		q.axis.x = p_axis.x * s;
 		q.axis.y = p_axis.y * s;
 		q.axis.z = p_axis.z * s;
-		q.w = Tools::Utils::Cos(halfAngle);
+		q.w = Cos(halfAngle);
 
 		return q;
 	}
 
-	inline Quaternion Quaternion::Lerp(const Quaternion& p_start, const Quaternion& p_end,
-		const double p_alpha)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::Lerp(const Quaternion<T>& p_start, const Quaternion<T>& p_end,
+		const T p_alpha)
 	{
-		const double coefficient = 1.0 - p_alpha;
+		const T coefficient = static_cast<T>(1.0) - p_alpha;
 
-		return  { Quaternion { coefficient * p_start.axis.x + p_alpha * p_end.axis.x,
+		return  { Quaternion<T> { coefficient * p_start.axis.x + p_alpha * p_end.axis.x,
 							coefficient * p_start.axis.y + p_alpha * p_end.axis.y,
 							coefficient * p_start.axis.z + p_alpha * p_end.axis.z,
 							coefficient * p_start.w + p_alpha * p_end.w } // .Normalize(); // Cancel the interpolation ?
 		};
 	}
 
-	inline Quaternion Quaternion::Slerp(const Quaternion& p_start, const Quaternion& p_end,
-		const double p_alpha)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::Slerp(const Quaternion<T>& p_start, const Quaternion<T>& p_end,
+		const T p_alpha)
 	{
-		const Quaternion qStartNormalized = Normalize(p_start);
-		const Quaternion qEndNormalized = Normalize(p_end);
+		const Quaternion<T> qStartNormalized = Normalize(p_start);
+		const Quaternion<T> qEndNormalized = Normalize(p_end);
 
-		double dot = DotProduct(qStartNormalized, qEndNormalized);
+		T dot = DotProduct(qStartNormalized, qEndNormalized);
 
 		//clamp values (just in case) because ArcCos only works from -1 to 1
-		if (dot > 1.0)
+		if (dot > static_cast<T>(1.0))
 		{
-			dot = 1.0;
+			dot = static_cast<T>(1.0);
 		}
-		else if (dot < -1.0)
-			dot = -1.0;
+		else if (dot < -static_cast<T>(1.0))
+			dot = -static_cast<T>(1.0);
 
-		const double theta = Tools::Utils::Arccos(dot) * p_alpha;
-		Quaternion relativeQuaternion = qEndNormalized - qStartNormalized * dot;
+		const T theta = Arccos(dot) * p_alpha;
+		Quaternion<T> relativeQuaternion = qEndNormalized - qStartNormalized * dot;
 		relativeQuaternion.Normalize();
 
-		Quaternion result = qStartNormalized * Tools::Utils::Cos(theta) + relativeQuaternion * Tools::Utils::Sin(theta);
+		Quaternion<T> result = qStartNormalized * Cos(theta) + relativeQuaternion * Sin(theta);
 
 		return result;
 	}
 
-	inline Quaternion Quaternion::SlerpShortestPath(const Quaternion& p_start, const Quaternion& p_end, const double p_alpha)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::SlerpShortestPath(const Quaternion<T>& p_start, const Quaternion<T>& p_end, const T p_alpha)
 	{
-		Quaternion qStartNormalized = Normalize(p_start);
-		const Quaternion qEndNormalized = Normalize(p_end);
+		Quaternion<T> qStartNormalized = Normalize(p_start);
+		const Quaternion<T> qEndNormalized = Normalize(p_end);
 
-		double dot = DotProduct(qStartNormalized, qEndNormalized);
+		T dot = DotProduct(qStartNormalized, qEndNormalized);
 
 		// If the dot product is negative,
 		// Slerp will not look for the closest rotation -> It will spin the other way around.
-		if (dot < 0.0)
+		if (dot < static_cast<T>(0.0))
 		{
 			qStartNormalized.w = -qStartNormalized.w;
 			qStartNormalized.axis.x = -qStartNormalized.axis.x;
@@ -492,37 +544,67 @@ namespace GPM
 		}
 
 		//clamp values (just in case) because ArcCos only works from -1 to 1
-		if (dot > 1.0)
+		if (dot > static_cast<T>(1.0))
 		{
-			dot = 1.0;
+			dot = static_cast<T>(1.0);
 		}
-		else if (dot < -1.0)
-			dot = -1.0;
+		else if (dot < -static_cast<T>(1.0))
+			dot = -static_cast<T>(1.0);
 
-		const double theta = Tools::Utils::Arccos(dot) * p_alpha;
-		Quaternion relativeQuaternion = qEndNormalized - qStartNormalized * dot;
+		const T theta = Arccos(dot) * p_alpha;
+		Quaternion<T> relativeQuaternion = qEndNormalized - qStartNormalized * dot;
 		relativeQuaternion.Normalize();
 
-		Quaternion result = qStartNormalized * Tools::Utils::Cos(theta) + relativeQuaternion * Tools::Utils::Sin(theta);
+		Quaternion<T> result = qStartNormalized * Cos(theta) + relativeQuaternion * Sin(theta);
 
 		return result;
 	}
 
-	inline Quaternion Quaternion::Nlerp(const Quaternion& p_start,
-		const Quaternion& p_end, const double p_alpha)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::Nlerp(const Quaternion<T>& p_start,
+		const Quaternion<T>& p_end, const T p_alpha)
 	{
 		return Lerp(p_start, p_end, p_alpha).Normalize();
 	}
 
-	constexpr double Quaternion::NormSquare() const
+	template<typename T>
+	inline T Quaternion<T>::Sin(const T p_value)
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return Tools::Utils::SinF(p_value);
+		else
+			return static_cast<T>(Tools::Utils::Sin(p_value));
+	}
+
+	template<typename T>
+	inline T Quaternion<T>::Cos(const T p_value)
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return Tools::Utils::CosF(p_value);
+		else
+			return static_cast<T>(Tools::Utils::Cos(p_value));
+	}
+
+	template<typename T>
+	inline T Quaternion<T>::Arccos(const T p_value)
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return Tools::Utils::ArccosF(p_value);
+		else
+			return static_cast<T>(Tools::Utils::Arccos(p_value));
+	}
+
+	template<typename T>
+	constexpr T Quaternion<T>::NormSquare() const
 	{
 		return w * w + axis.x * axis.x + axis.y * axis.y + axis.z * axis.z;
 	}
 
-	inline Quaternion& Quaternion::Normalize()
+	template<typename T>
+	inline Quaternion<T>& Quaternion<T>::Normalize()
 	{
-		if (Norm() > 0.0) {
-			const double normValue = 1.0 / Norm();
+		if (Norm() > static_cast<T>(0.0)) {
+			const T normValue = static_cast<T>(1.0) / Norm();
 
 			w *= normValue;
 			axis *= normValue;
@@ -531,51 +613,54 @@ namespace GPM
 		return { (*this) };
 	}
 
-	inline Quaternion Quaternion::Normalize(const Quaternion& p_quaternion)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::Normalize(const Quaternion<T>& p_quaternion)
 	{
-		double scalar = 0.0;
+		T scalar = static_cast<T>(0.0);
 
-		Vector3<double> vector{};
+		Vector3<T> vector{};
 
-		if (p_quaternion.Norm() != 0.0) {
-			const double normValue = 1.0 / p_quaternion.Norm();
+		if (p_quaternion.Norm() != static_cast<T>(0.0)) {
+			const T normValue = static_cast<T>(1.0) / p_quaternion.Norm();
 
 			scalar = p_quaternion.w * normValue;
 			vector = p_quaternion.axis * normValue;
 		}
 
-		return { Quaternion{ scalar, vector} };
+		return { Quaternion<T>{ scalar, vector} };
 	}
 
-	inline Quaternion Quaternion::ToUnitNormQuaternion()
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::ToUnitNormQuaternion()
 	{
-		const double angle = Tools::Utils::ToRadians(w);
+		const T angle = Tools::Utils::ToRadians(w);
 
 		axis.Normalize();
 
-		return { Quaternion { Tools::Utils::Cos(angle * 0.5), axis * Tools::Utils::Sin(angle * 0.5)} };
+		return { Quaternion<T> { Cos(angle * static_cast<T>(0.5)), axis * Sin(angle * static_cast<T>(0.5))} };
 	}
 
-	inline Vector3<double> Quaternion::ToEuler() const
+	template<typename T>
+	inline Vector3<T> Quaternion<T>::ToEuler() const
 	{
-		Vector3<double> euler{};
+		Vector3<T> euler{};
 
 		// roll (x-axis rotation)
-		const double sinr_cosp = 2.0 * (w * axis.x + axis.y * axis.z);
-		const double cosr_cosp = 1.0 - 2.0 * (axis.x * axis.x + axis.y * axis.y);
-		euler.x = Tools::Utils::Arctan2(sinr_cosp, cosr_cosp);
+		const T sinr_cosp = static_cast<T>(2.0) * (w * axis.x + axis.y * axis.z);
+		const T cosr_cosp = static_cast<T>(1.0) - static_cast<T>(2.0) * (axis.x * axis.x + axis.y * axis.y);
+		euler.x = static_cast<T>(Tools::Utils::Arctan2(sinr_cosp, cosr_cosp));
 
 		// pitch (y-axis rotation)
-		const double sinp = 2.0 * (w * axis.y - axis.z * axis.x);
-		if (Tools::Utils::Abs(sinp) >= 1.0)
-			euler.y = std::copysign(Tools::M_PI / 2.0, sinp); // use 90 degrees if out of range
+		const T sinp = static_cast<T>(2.0) * (w * axis.y - axis.z * axis.x);
+		if (Tools::Utils::Abs(sinp) >= static_cast<T>(1.0))
+			euler.y = static_cast<T>(std::copysign(Tools::M_PI / 2.0, sinp)); // use 90 degrees if out of range
 		else
-			euler.y = Tools::Utils::Arcsin(sinp);
+			euler.y = static_cast<T>(Tools::Utils::Arcsin(sinp));
 
 		// yaw (z-axis rotation)
-		const double siny_cosp = 2.0 * (w * axis.z + axis.x * axis.y);
-		const double cosy_cosp = 1.0 - 2.0 * (axis.y * axis.y + axis.z * axis.z);
-		euler.z = Tools::Utils::Arctan2(siny_cosp, cosy_cosp);
+		const T siny_cosp = static_cast<T>(2.0) * (w * axis.z + axis.x * axis.y);
+		const T cosy_cosp = static_cast<T>(1.0) - static_cast<T>(2.0) * (axis.y * axis.y + axis.z * axis.z);
+		euler.z = static_cast<T>(Tools::Utils::Arctan2(siny_cosp, cosy_cosp));
 
 		euler.x = Tools::Utils::ToDegrees(euler.x);
 		euler.y = Tools::Utils::ToDegrees(euler.y);
@@ -584,21 +669,23 @@ namespace GPM
 		return euler;
 	}
 
-	inline Quaternion Quaternion::ToQuaternion(const Vector3<double>& p_euler)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::ToQuaternion(const Vector3<T>& p_euler)
 	{
 		return { ToQuaternion(p_euler.x, p_euler.y, p_euler.z) };
 	}
 
-	inline Quaternion Quaternion::ToQuaternion(const double p_yaw, const double p_pitch, const double p_roll)
+	template<typename T>
+	inline Quaternion<T> Quaternion<T>::ToQuaternion(const T p_yaw, const T p_pitch, const T p_roll)
 	{
-		Quaternion result;
+		Quaternion<T> result;
 
-		const double cosYaw = Tools::Utils::Cos(p_yaw * 0.5);
-		const double sinYaw = Tools::Utils::Sin(p_yaw * 0.5);
-		const double cosPitch = Tools::Utils::Cos(p_pitch * 0.5);
-		const double sinPitch = Tools::Utils::Sin(p_pitch * 0.5);
-		const double cosRoll = Tools::Utils::Cos(p_roll * 0.5);
-		const double sinRoll = Tools::Utils::Sin(p_roll * 0.5);
+		const T cosYaw = Cos(p_yaw * static_cast<T>(0.5));
+		const T sinYaw = Sin(p_yaw * static_cast<T>(0.5));
+		const T cosPitch = Cos(p_pitch * static_cast<T>(0.5));
+		const T sinPitch = Sin(p_pitch * static_cast<T>(0.5));
+		const T cosRoll = Cos(p_roll * static_cast<T>(0.5));
+		const T sinRoll = Sin(p_roll * static_cast<T>(0.5));
 
 		result.w = cosYaw * cosPitch * cosRoll + sinYaw * sinPitch * sinRoll;
 		result.axis.x = cosYaw * cosPitch * sinRoll - sinYaw * sinPitch * cosRoll;
@@ -608,18 +695,21 @@ namespace GPM
 		return { result };
 	}
 
-	inline std::string Quaternion::ToString() const
+	template<typename T>
+	inline std::string Quaternion<T>::ToString() const
 	{
 		return { std::string("(w: " + std::to_string(w) + "; x: " + std::to_string(axis.x) + ", y: " + std::to_string(axis.y) +
 			", z: " + std::to_string(axis.z)) + ')' };
 	}
 
-	inline std::string Quaternion::ToString(const Quaternion& p_quaternion)
+	template<typename T>
+	inline std::string Quaternion<T>::ToString(const Quaternion<T>& p_quaternion)
 	{
 		return { p_quaternion.ToString() };
 	}
 
-	inline Matrix3<float> Quaternion::ToMatrix3() const
+	template<typename T>
+	inline Matrix3<float> Quaternion<T>::ToMatrix3() const
 	{
 		Matrix3<float> result;
 
@@ -644,7 +734,8 @@ namespace GPM
 		return result;
 	}
 
-	inline Matrix4<float> Quaternion::ToMatrix4() const
+	template<typename T>
+	inline Matrix4<float> Quaternion<T>::ToMatrix4() const
 	{
 		Matrix4<float> result{};
 		const float sqw = static_cast<float>(w * w);
@@ -675,8 +766,9 @@ namespace GPM
 		return { result };
 	}
 
+	template<typename T>
 	inline std::ostream& operator<<(std::ostream& p_stream,
-		const Quaternion& p_quaternion)
+		const Quaternion<T>& p_quaternion)
 	{
 		p_stream << "(w: " << p_quaternion.w << "; x: " << p_quaternion.axis.x << ", y: " << p_quaternion.axis.y <<
 			", z: " << p_quaternion.axis.z << ')';
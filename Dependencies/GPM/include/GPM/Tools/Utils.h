@@ -1,5 +1,12 @@
 #pragma once
 
+#include <cmath>
+
+// The C library may define M_PI as a macro (glibc does), it would replace the constant below
+#ifdef M_PI
+#undef M_PI
+#endif
+
 namespace GPM::Tools
 {
 	/**
@@ -66,7 +66,7 @@ namespace GPM::Tools
 
 	inline float Utils::SinF(const float p_value)
 	{
-		return std::sinf(p_value);
+		return std::sin(p_value);
 	}
 
 	inline double Utils::Cos(const double p_value)
@@ -76,7 +76,7 @@ namespace GPM::Tools
 
 	inline float Utils::CosF(const float p_value)
 	{
-		return std::cosf(p_value);
+		return std::cos(p_value);
 	}
 
 	inline double  Utils::Tan(const double p_value)
@@ -86,7 +86,7 @@ namespace GPM::Tools
 
 	inline float Utils::TanF(const float p_value)
 	{
-		return std::tanf(p_value);
+		return std::tan(p_value);
 	}
 
 	inline double Utils::Arccos(const double p_value)
@@ -96,7 +96,7 @@ namespace GPM::Tools
 
 	inline float Utils::ArccosF(const float p_value)
 	{
-		return std::acosf(p_value);
+		return std::acos(p_value);
 	}
 
 	inline double Utils::Arcsin(const double p_value)
@@ -106,7 +106,7 @@ namespace GPM::Tools
 
 	inline float Utils::ArcsinF(const float p_value)
 	{
-		return std::asinf(p_value);
+		return std::asin(p_value);
 	}
 
 	inline double Utils::Arctan(const double p_value)
@@ -116,7 +116,7 @@ namespace GPM::Tools
 
 	inline float Utils::ArctanF(const float p_value)
 	{
-		return std::atanf(p_value);
+		return std::atan(p_value);
 	}
 
 	inline double Utils::Arctan2(const double p_valueYx, const double p_valueXx)
@@ -126,7 +126,7 @@ namespace GPM::Tools
 
 	inline float Utils::Arctan2F(const float p_valueYx, const float p_valueXx)
 	{
-		return std::atan2f(p_valueYx, p_valueXx);
+		return std::atan2(p_valueYx, p_valueXx);
 	}
 
 	template <typename T>
@@ -161,7 +161,7 @@ namespace GPM::Tools
 	inline T Utils::SquareRootF(const T p_value)
 	{
 		static_assert(std::is_arithmetic<T>::value, "The value to root must be arithmetic");
-		return static_cast<T>(std::sqrtf(p_value));
+		return static_cast<T>(std::sqrt(p_value));
 	}
 
 	template<typename T>